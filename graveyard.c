@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdarg.h>
 #include <string.h>
 #include <stddef.h>
 #include <stdbool.h>
@@ -21,14 +22,31 @@
 
 #ifndef _WIN32
 #include <sys/wait.h>
+#include <sys/resource.h>
 #endif
 
 #ifndef _WIN32
 #include <dirent.h>
 #endif
 
-#define MAX_LEXEME_LEN 65
+#if defined(__x86_64__) && defined(__linux__)
+#define GRAVEYARD_JIT
+#include <sys/mman.h>
+#endif
+
+#if defined(__linux__) && !defined(GRAVEYARD_NO_STACK_SEGMENTS)
+#define GRAVEYARD_STACK_SEGMENTS
+#include <ucontext.h>
+#include <sys/mman.h>
+#endif
+
+#if defined(__GNUC__) && defined(__SSE2__) && !defined(GRAVEYARD_NO_SIMD)
+#define GRAVEYARD_SIMD_LEXER
+#include <immintrin.h>
+#endif
+
 #define MAX_STATE_STACK 16
+#define QUICKEN_THRESHOLD 2
 
 typedef enum {
     SEMICOLON,
@@ -108,19 +126,61 @@ typedef enum {
     UNKNOWN
 } GraveyardTokenType;
 
+typedef struct {
+    uint32_t hash;
+    int length;
+    char chars[];
+} Symbol;
+
+typedef struct {
+    Symbol** entries;
+    int count;
+    int capacity;
+} SymbolTable;
+
 typedef struct {
     GraveyardTokenType type;
-    char lexeme[MAX_LEXEME_LEN];
     int line;
     int column;
+    uint32_t start;
+    uint32_t length;
+    Symbol* symbol;
 } Token;
 
+typedef struct {
+    GraveyardTokenType type;
+    int line;
+    const char* lexeme;
+    Symbol* symbol;
+} AstToken;
+
 typedef enum {
     STATE_DEFAULT,
     STATE_IN_FMT_STRING
 } TokenizerState;
 
 typedef struct AstNode AstNode;
+typedef struct Chunk Chunk;
+typedef struct JitFunction JitFunction;
+typedef struct Shape Shape;
+typedef struct GraveyardString GraveyardString;
+typedef struct GraveyardValue GraveyardValue;
+typedef struct Graveyard Graveyard;
+
+typedef GraveyardValue (*NodeHandler)(Graveyard* gy, AstNode* node);
+
+typedef struct {
+    Symbol** names;
+    int count;
+    int capacity;
+    int* param_slots;
+    int param_count;
+} ScopeLayout;
+
+typedef struct {
+    int depth;
+    int* slots;
+} VariableResolution;
 
 typedef enum {
     AST_UNKNOWN,
@@ -179,19 +239,39 @@ typedef struct {
     size_t capacity;
 } AstNodeProgram;
 
+typedef enum {
+    BINARY_UNSPECIALIZED,
+    BINARY_GENERIC,
+    BINARY_NUMBER_ADD,
+    BINARY_NUMBER_SUBTRACT,
+    BINARY_NUMBER_MULTIPLY,
+    BINARY_NUMBER_DIVIDE,
+    BINARY_NUMBER_MODULO,
+    BINARY_NUMBER_LESS,
+    BINARY_NUMBER_GREATER,
+    BINARY_NUMBER_LESS_EQUAL,
+    BINARY_NUMBER_GREATER_EQUAL,
+    BINARY_NUMBER_EQUAL,
+    BINARY_NUMBER_NOT_EQUAL,
+    BINARY_STRING_CONCAT,
+    BINARY_HASHTABLE_REFERENCE
+} BinarySpecialization;
+
 typedef struct {
-    Token operator;
+    AstToken operator;
     AstNode *left;
     AstNode *right;
+    BinarySpecialization specialization;
+    int executions;
 } AstNodeBinaryOp;
 
 typedef struct {
-    Token operator;
+    AstToken operator;
     AstNode *right;
 } AstNodeUnaryOp;
 
 typedef struct {
-    Token operator;
+    AstToken operator;
     AstNode *left;
     AstNode *right;
 } AstNodeLogicalOp;
@@ -202,11 +282,14 @@ typedef struct {
 } AstNodeAssignment;
 
 typedef struct {
-    Token name;
+    AstToken name;
+    VariableResolution resolution;
 } AstNodeIdentifier;
 
 typedef struct {
-    Token value;
+    AstToken value;
+    double number;
+    GraveyardString* string;
 } AstNodeLiteral;
 
 typedef struct {
@@ -216,7 +299,7 @@ typedef struct {
 } AstNodePrintStmt;
 
 typedef struct {
-    Token variable;
+    AstToken variable;
     AstNode* prompt;
 } AstNodeScanStatement;
 
@@ -228,7 +311,7 @@ typedef enum {
 typedef struct {
     FmtStringPartType type;
     union {
-        Token   literal;
+        AstToken   literal;
         AstNode* expression;
     } as;
 } FmtStringPart;
@@ -262,11 +345,14 @@ typedef struct {
 } AstNodeHashtableLiteral;
 
 typedef struct {
-    Token name;
-    Token* params;
+    AstToken name;
+    AstToken* params;
     size_t param_count;
     size_t param_capacity;
     AstNode* body;
+    bool is_memoized;
+    size_t memo_hits;
+    size_t memo_misses;
 } AstNodeFunctionDeclaration;
 
 typedef struct {
@@ -274,11 +360,12 @@ typedef struct {
     AstNode** arguments;
     size_t arg_count;
     size_t arg_capacity;
-    Token paren;
+    AstToken paren;
+    bool is_tail_call;
 } AstNodeCallExpression;
 
 typedef struct {
-    Token keyword;
+    AstToken keyword;
     AstNode* value;
 } AstNodeReturnStatement;
 
@@ -286,6 +373,10 @@ typedef struct {
     AstNode** statements;
     size_t count;
     size_t capacity;
+    ScopeLayout* layout;
+    Chunk* chunk;
+    JitFunction* jit;
+    int call_count;
 } AstNodeBlock;
 
 typedef struct {
@@ -314,7 +405,7 @@ typedef struct {
 
 typedef struct {
     AstNode* condition;
-    Token keyword;
+    AstToken keyword;
 } AstNodeAssertStatement;
 
 typedef struct {
@@ -323,56 +414,63 @@ typedef struct {
 } AstNodeWhileStatement;
 
 typedef struct {
-    Token keyword;
+    AstToken keyword;
 } AstNodeBreakStatement;
 
 typedef struct {
-    Token keyword;
+    AstToken keyword;
 } AstNodeContinueStatement;
 
 typedef struct {
-    Token iterator;
+    AstToken iterator;
     AstNode** range_expressions;
     size_t range_count;
     AstNode* body;
 } AstNodeForStatement;
 
 typedef struct {
-    Token keyword;
+    AstToken keyword;
     AstNode* error_expr;
 } AstNodeRaiseStatement;
 
 typedef struct {
-    Token keyword;
+    AstToken keyword;
 } AstNodeTimeExpression;
 
 typedef struct {
-    Token name;
+    AstToken name;
     AstNode* body;
 } AstNodeNamespaceDeclaration;
 
 typedef struct {
-    Token namespace_name;
-    Token member_name;
+    AstToken namespace_name;
+    AstToken member_name;
 } AstNodeNamespaceAccess;
 
 typedef struct {
-    Token variable;
+    AstToken variable;
     AstNode* path_expr;
 } AstNodeFilereadStatement;
 
 typedef struct {
-    Token name;
+    AstToken name;
     AstNode* body;
 } AstNodeTypeDeclaration;
 
+typedef struct {
+    Shape* shape;
+    int slot;
+} MemberCache;
+
 typedef struct {
     AstNode* object;
-    Token member;
+    AstToken member;
+    MemberCache cache;
 } AstNodeMemberAccess;
 
 typedef struct {
-    Token keyword;
+    AstToken keyword;
+    VariableResolution resolution;
 } AstNodeThisExpression;
 
 typedef struct {
@@ -380,7 +478,7 @@ typedef struct {
 } AstNodeExecuteExpression;
 
 typedef struct {
-    Token keyword;
+    AstToken keyword;
 } AstNodeCatConstantExpression;
 
 typedef struct {
@@ -388,16 +486,16 @@ typedef struct {
 } AstNodeWaitStatement;
 
 typedef struct {
-    Token keyword;
+    AstToken keyword;
 } AstNodeRandomExpression;
 
 typedef struct {
-    Token member_name;
+    AstToken member_name;
 } AstNodeGlobalAccess;
 
 typedef struct {
-    Token type_name;
-    Token member_name;
+    AstToken type_name;
+    AstToken member_name;
 } AstNodeStaticAccess;
 
 typedef struct {
@@ -412,7 +510,7 @@ typedef struct {
 } AstNodeSliceExpression;
 
 typedef struct {
-    Token keyword;
+    AstToken keyword;
 } AstNodeArgvExpression;
 
 typedef struct {
@@ -428,7 +526,7 @@ typedef struct {
 } AstNodeListdirExpression;
 
 typedef struct {
-    Token error_variable;
+    AstToken error_variable;
     AstNode* body;
 } AstNodeExceptClause;
 
@@ -439,13 +537,17 @@ typedef struct {
 } AstNodeTryExceptStatement;
 
 typedef struct {
-    Token name;
+    AstToken name;
     AstNode* initializer;
+    VariableResolution resolution;
 } AstNodeVarDeclaration;
 
 struct AstNode {
     AstNodeType type;
     int line;
+    bool allocates_scratch;
+    bool releases_scratch;
+    NodeHandler handler;
 
     union {
         AstNodeProgram               program;
@@ -498,11 +600,10 @@ struct AstNode {
     } as;
 };
 
-typedef struct GraveyardString GraveyardString;
-typedef struct GraveyardValue GraveyardValue;
 typedef struct GraveyardArray GraveyardArray;
 typedef struct GraveyardHashtable GraveyardHashtable;
 typedef struct GraveyardFunction GraveyardFunction;
+typedef struct MemoCache MemoCache;
 typedef struct Environment Environment;
 typedef struct GraveyardType GraveyardType;
 typedef struct GraveyardInstance GraveyardInstance;
@@ -519,9 +620,81 @@ typedef enum {
     VAL_ENVIRONMENT,
     VAL_TYPE,
     VAL_INSTANCE,
-    VAL_BOUND_METHOD
+    VAL_BOUND_METHOD,
+    VAL_UNDEFINED
 } ValueType;
 
+#ifdef GRAVEYARD_NAN_BOXING
+
+struct GraveyardValue {
+    uint64_t bits;
+};
+
+#define NAN_BOX_SIGN       ((uint64_t)0x8000000000000000)
+#define NAN_BOX_QNAN       ((uint64_t)0x7ffc000000000000)
+#define NAN_BOX_CANONICAL  ((uint64_t)0x7ff8000000000000)
+#define NAN_BOX_TAG_MASK   ((uint64_t)0x7)
+#define NAN_BOX_NULL       (NAN_BOX_QNAN | 1)
+#define NAN_BOX_FALSE      (NAN_BOX_QNAN | 2)
+#define NAN_BOX_TRUE       (NAN_BOX_QNAN | 3)
+#define NAN_BOX_UNDEFINED  (NAN_BOX_QNAN | 4)
+
+static inline ValueType nan_box_type(GraveyardValue value) {
+    if ((value.bits & NAN_BOX_QNAN) != NAN_BOX_QNAN) return VAL_NUMBER;
+    if (value.bits & NAN_BOX_SIGN) return (ValueType)(VAL_STRING + (value.bits & NAN_BOX_TAG_MASK));
+    switch (value.bits) {
+        case NAN_BOX_FALSE:
+        case NAN_BOX_TRUE:
+            return VAL_BOOL;
+        case NAN_BOX_UNDEFINED:
+            return VAL_UNDEFINED;
+        default:
+            return VAL_NULL;
+    }
+}
+
+static inline double nan_box_as_number(GraveyardValue value) {
+    double number;
+    memcpy(&number, &value.bits, sizeof(number));
+    return number;
+}
+
+static inline void* nan_box_as_object(GraveyardValue value) {
+    return (void*)(uintptr_t)(value.bits & ~(NAN_BOX_SIGN | NAN_BOX_QNAN | NAN_BOX_TAG_MASK));
+}
+
+static inline GraveyardValue nan_box_number(double number) {
+    GraveyardValue value;
+    if (number != number) {
+        value.bits = NAN_BOX_CANONICAL;
+    } else {
+        memcpy(&value.bits, &number, sizeof(number));
+    }
+    return value;
+}
+
+static inline GraveyardValue nan_box_bits(uint64_t bits) {
+    GraveyardValue value;
+    value.bits = bits;
+    return value;
+}
+
+static inline GraveyardValue nan_box_object(ValueType type, void* object) {
+    return nan_box_bits(NAN_BOX_SIGN | NAN_BOX_QNAN | (uint64_t)(uintptr_t)object | (uint64_t)(type - VAL_STRING));
+}
+
+#define VALUE_TYPE(value)         nan_box_type(value)
+#define AS_BOOL(value)            ((value).bits == NAN_BOX_TRUE)
+#define AS_NUMBER(value)          nan_box_as_number(value)
+#define AS_OBJECT(value)          nan_box_as_object(value)
+#define NULL_VALUE                nan_box_bits(NAN_BOX_NULL)
+#define UNDEFINED_VALUE           nan_box_bits(NAN_BOX_UNDEFINED)
+#define BOOL_VALUE(flag)          nan_box_bits((flag) ? NAN_BOX_TRUE : NAN_BOX_FALSE)
+#define NUMBER_VALUE(num)         nan_box_number(num)
+#define OBJECT_VALUE(kind, ptr)   nan_box_object((kind), (ptr))
+
+#else
+
 struct GraveyardValue {
     ValueType type;
     union {
@@ -539,14 +712,52 @@ struct GraveyardValue {
     } as;
 };
 
+#define VALUE_TYPE(value)         ((value).type)
+#define AS_BOOL(value)            ((value).as.boolean)
+#define AS_NUMBER(value)          ((value).as.number)
+#define AS_OBJECT(value)          ((value).as.object)
+#define NULL_VALUE                ((GraveyardValue){ .type = VAL_NULL, .as.number = 0 })
+#define UNDEFINED_VALUE           ((GraveyardValue){ .type = VAL_UNDEFINED, .as.number = 0 })
+#define BOOL_VALUE(flag)          ((GraveyardValue){ .type = VAL_BOOL, .as.boolean = (flag) })
+#define NUMBER_VALUE(num)         ((GraveyardValue){ .type = VAL_NUMBER, .as.number = (num) })
+#define OBJECT_VALUE(kind, ptr)   ((GraveyardValue){ .type = (kind), .as.object = (ptr) })
+
+#endif
+
+#define AS_STRING(value)          ((GraveyardString*)AS_OBJECT(value))
+#define AS_ARRAY(value)           ((GraveyardArray*)AS_OBJECT(value))
+#define AS_HASHTABLE(value)       ((GraveyardHashtable*)AS_OBJECT(value))
+#define AS_FUNCTION(value)        ((GraveyardFunction*)AS_OBJECT(value))
+#define AS_ENVIRONMENT(value)     ((Environment*)AS_OBJECT(value))
+#define AS_TYPE(value)            ((GraveyardType*)AS_OBJECT(value))
+#define AS_INSTANCE(value)        ((GraveyardInstance*)AS_OBJECT(value))
+#define AS_BOUND_METHOD(value)    ((GraveyardBoundMethod*)AS_OBJECT(value))
+
+typedef enum {
+    GC_BLACK,
+    GC_GRAY,
+    GC_WHITE,
+    GC_PURPLE,
+    GC_GREEN,
+    GC_COLLECTING
+} GcColor;
+
+typedef struct {
+    uint8_t color;
+    bool buffered;
+} GcHeader;
+
 struct GraveyardString {
     int ref_count;
+    bool is_scratch;
     char* chars;
     size_t length;
 };
 
 struct GraveyardArray {
     int ref_count;
+    bool is_scratch;
+    GcHeader gc;
     size_t count;
     size_t capacity;
     GraveyardValue* values;
@@ -562,11 +773,13 @@ struct GraveyardHashtable {
     int ref_count;
     int count;
     int capacity;
+    bool is_scratch;
+    GcHeader gc;
     HashtableEntry* entries;
 };
 
 typedef struct {
-    char* key;
+    Symbol* key;
     GraveyardValue value;
 } MonolithEntry;
 
@@ -579,6 +792,8 @@ typedef struct {
 typedef struct Environment {
     struct Environment* enclosing;
     Monolith values;
+    ScopeLayout* layout;
+    GraveyardValue slots[];
 } Environment;
 
 struct GraveyardFunction {
@@ -587,7 +802,21 @@ struct GraveyardFunction {
     Environment* closure;
     GraveyardValue name;
     AstNode* body;
-    Token* params;
+    AstToken* params;
+    MemoCache* memo;
+};
+
+typedef struct {
+    Symbol* name;
+    Shape* shape;
+} ShapeTransition;
+
+struct Shape {
+    Symbol** names;
+    int count;
+    ShapeTransition* transitions;
+    int transition_count;
+    int transition_capacity;
 };
 
 struct GraveyardType {
@@ -595,16 +824,22 @@ struct GraveyardType {
     GraveyardValue name;
     Monolith fields;
     Monolith methods;
+    Shape* instance_shape;
+    int instance_shape_field_count;
 };
 
 struct GraveyardInstance {
     int ref_count;
+    GcHeader gc;
     GraveyardType* type;
-    Monolith fields;
+    Shape* shape;
+    GraveyardValue* fields;
+    int field_capacity;
 };
 
 struct GraveyardBoundMethod {
     int ref_count;
+    GcHeader gc;
     GraveyardValue receiver;
     GraveyardValue function;
 };
@@ -628,29 +863,208 @@ typedef struct {
 } Preprocessor;
 
 typedef struct {
+    GraveyardFunction* function;
+    Environment* environment;
+    GraveyardValue callee;
+    GraveyardValue receiver;
+} PendingCall;
+
+#define CALL_STACK_RESERVE (256 * 1024)
+#define CALL_STACK_DEFAULT_SIZE (8 * 1024 * 1024)
+#define CALL_STACK_LIMIT_FACTOR 16
+#define CALL_STACK_SEGMENT_SIZE (16 * 1024 * 1024)
+#define CALL_STACK_MAX_SEGMENTS 64
+#define CALL_FRAME_STACK_COST 768
+
+typedef struct {
+    void* memory;
+#ifdef GRAVEYARD_STACK_SEGMENTS
+    ucontext_t context;
+    ucontext_t caller;
+#endif
+    Graveyard* gy;
+    PendingCall* call;
+    bool dirty;
+} StackSegment;
+
+#define MEMO_CACHE_CAPACITY 1024
+#define MEMO_MAX_ARITY 8
+
+typedef struct {
+    uint32_t hash;
+    int bucket_next;
+    int lru_prev;
+    int lru_next;
+    GraveyardValue result;
+} MemoEntry;
+
+struct MemoCache {
+    AstNode* declaration;
+    int arity;
+    int count;
+    int lru_head;
+    int lru_tail;
+    GraveyardValue* keys;
+    int buckets[MEMO_CACHE_CAPACITY];
+    MemoEntry entries[MEMO_CACHE_CAPACITY];
+};
+
+#define SCRATCH_CHUNK_SIZE (64 * 1024)
+
+typedef struct ScratchChunk {
+    struct ScratchChunk* next;
+    size_t capacity;
+    size_t used;
+    unsigned char data[];
+} ScratchChunk;
+
+typedef struct {
+    ScratchChunk* head;
+    ScratchChunk* current;
+} ScratchRegion;
+
+typedef struct {
+    ScratchChunk* chunk;
+    size_t used;
+} ScratchMark;
+
+#define AST_ARENA_CHUNK_SIZE (64 * 1024)
+
+typedef struct {
+    ScratchChunk* head;
+    AstNode** owners;
+    size_t owner_count;
+    size_t owner_capacity;
+} AstArena;
+
+#define GC_ALLOCATION_THRESHOLD 10000
+#define GC_ROOT_THRESHOLD 4096
+
+typedef struct {
+    GraveyardValue* values;
+    size_t count;
+    size_t capacity;
+} GcStack;
+
+typedef struct {
+    GcStack roots;
+    size_t allocations;
+    bool pending;
+    int collections;
+    size_t freed_objects;
+    double total_pause;
+    double max_pause;
+} CycleCollector;
+
+#define SLAB_GRANULE 16
+#define SLAB_CLASS_COUNT 32
+#define SLAB_MAX_SIZE (SLAB_GRANULE * SLAB_CLASS_COUNT)
+#define SLAB_CHUNK_SIZE (64 * 1024)
+
+typedef enum {
+    SLAB_STRING,
+    SLAB_ARRAY,
+    SLAB_HASHTABLE,
+    SLAB_INSTANCE,
+    SLAB_BOUND_METHOD,
+    SLAB_ENVIRONMENT,
+    SLAB_KIND_COUNT
+} SlabKind;
+
+typedef struct SlabFreeNode {
+    struct SlabFreeNode* next;
+} SlabFreeNode;
+
+typedef struct SlabChunk {
+    struct SlabChunk* next;
+    unsigned char data[];
+} SlabChunk;
+
+typedef struct SlabLarge {
+    struct SlabLarge* prev;
+    struct SlabLarge* next;
+} SlabLarge;
+
+typedef struct {
+    SlabFreeNode* free_list;
+    unsigned char* cursor;
+    unsigned char* limit;
+} SlabClass;
+
+typedef struct {
+    SlabClass classes[SLAB_CLASS_COUNT];
+    SlabChunk* chunks;
+    SlabLarge* large;
+    size_t reserved_bytes;
+    size_t live_objects[SLAB_KIND_COUNT];
+    size_t live_bytes[SLAB_KIND_COUNT];
+    size_t peak_bytes[SLAB_KIND_COUNT];
+} SlabAllocator;
+
+struct Graveyard {
     const char *mode;
     const char *filename;
     char *source_code;
     Token *tokens;
     size_t token_count;
+    bool had_token_error;
     AstNode *ast_root;
+    AstArena ast_arena;
     Monolith namespaces;
+    SymbolTable symbols;
+    Symbol* this_symbol;
+    Shape* root_shape;
     GraveyardValue arguments;
     Environment* environment;
+    ScratchRegion scratch;
+    SlabAllocator slabs;
+    CycleCollector cycle_collector;
     GraveyardValue last_executed_value;
     bool is_returning;
     GraveyardValue return_value;
+    Environment* call_environment;
+    bool has_tail_call;
+    PendingCall tail_call;
+    uintptr_t stack_base;
+    size_t stack_budget;
+    size_t stack_limit;
+    StackSegment* stack_segments[CALL_STACK_MAX_SEGMENTS];
+    int stack_segment_depth;
+    int stack_segment_limit;
+    size_t vm_frame_limit;
     bool encountered_break;
     bool encountered_continue;
     bool had_runtime_error;
     char error_message[1024];
     int error_line;
-} Graveyard;
+    int optimize_level;
+    int specialized_node_count;
+    int deoptimized_node_count;
+    bool jit_enabled;
+    int jit_compiled_count;
+};
+
+typedef struct {
+    Graveyard* gy;
+    const char* source;
+    const char* source_end;
+    const char* current_ptr;
+    const char* line_start_ptr;
+    size_t line;
+    TokenizerState state_stack[MAX_STATE_STACK];
+    int state_top;
+    int fstring_brace_depth_stack[MAX_STATE_STACK];
+    int fstring_depth_top;
+    bool had_error;
+} Lexer;
+
+#define PARSER_TOKEN_WINDOW 8
 
 typedef struct {
     Graveyard* gy;
-    Token* tokens;
-    size_t     token_count;
+    Lexer      lexer;
+    Token      window[PARSER_TOKEN_WINDOW];
+    size_t     lexed;
     size_t     current;
     bool       had_error;
 } Parser;
@@ -880,6 +1294,101 @@ char* run_preprocessor(const char* initial_source) {
     return pp.output_buffer;
 }
 
+//SYMBOLS-----------------------------------------------------------------------------------
+
+static uint32_t hash_string(const char* key, int length) {
+    uint32_t hash = 5381;
+    for (int i = 0; i < length; i++) {
+        hash = ((hash << 5) + hash) + key[i];
+    }
+    return hash;
+}
+
+void symbol_table_init(SymbolTable* table) {
+    table->count = 0;
+    table->capacity = 0;
+    table->entries = NULL;
+}
+
+void symbol_table_free(SymbolTable* table) {
+    for (int i = 0; i < table->capacity; i++) {
+        free(table->entries[i]);
+    }
+    free(table->entries);
+    table->entries = NULL;
+    table->count = 0;
+    table->capacity = 0;
+}
+
+static void symbol_table_resize(SymbolTable* table, int new_capacity) {
+    Symbol** new_entries = calloc(new_capacity, sizeof(Symbol*));
+    if (!new_entries) {
+        perror("symbol_table_resize: calloc failed");
+        exit(1);
+    }
+
+    for (int i = 0; i < table->capacity; i++) {
+        Symbol* symbol = table->entries[i];
+        if (symbol == NULL) continue;
+
+        uint32_t index = symbol->hash & (new_capacity - 1);
+        while (new_entries[index] != NULL) {
+            index = (index + 1) & (new_capacity - 1);
+        }
+        new_entries[index] = symbol;
+    }
+
+    free(table->entries);
+    table->entries = new_entries;
+    table->capacity = new_capacity;
+}
+
+Symbol* intern_symbol(SymbolTable* table, const char* chars, int length) {
+    if (table->count + 1 > table->capacity * 0.75) {
+        symbol_table_resize(table, table->capacity < 64 ? 64 : table->capacity * 2);
+    }
+
+    uint32_t hash = hash_string(chars, length);
+    uint32_t index = hash & (table->capacity - 1);
+    for (;;) {
+        Symbol* symbol = table->entries[index];
+        if (symbol == NULL) break;
+        if (symbol->hash == hash && symbol->length == length && memcmp(symbol->chars, chars, length) == 0) {
+            return symbol;
+        }
+        index = (index + 1) & (table->capacity - 1);
+    }
+
+    Symbol* symbol = malloc(sizeof(Symbol) + length + 1);
+    if (!symbol) {
+        perror("intern_symbol: malloc failed");
+        exit(1);
+    }
+    symbol->hash = hash;
+    symbol->length = length;
+    memcpy(symbol->chars, chars, length);
+    symbol->chars[length] = '\0';
+
+    table->entries[index] = symbol;
+    table->count++;
+    return symbol;
+}
+
+Symbol* intern_cstring(SymbolTable* table, const char* chars) {
+    return intern_symbol(table, chars, (int)strlen(chars));
+}
+
+Symbol* intern_token_slice(SymbolTable* table, const char* lexeme, size_t len) {
+    if (len >= 2 && lexeme[0] == '<' && lexeme[len - 1] == '>') {
+        return intern_symbol(table, lexeme + 1, (int)len - 2);
+    }
+    return intern_symbol(table, lexeme, (int)len);
+}
+
+Symbol* intern_token_name(SymbolTable* table, const char* lexeme) {
+    return intern_token_slice(table, lexeme, strlen(lexeme));
+}
+
 //TOKENIZE-----------------------------------------------------------------------------------
 
 GraveyardTokenType identify_three_char_token(char c1, char c2, char c3) {
@@ -961,236 +1470,287 @@ GraveyardTokenType identify_single_char_token(char c) {
     }
 }
 
-bool tokenize(Graveyard *gy) {
-    const char* source = gy->source_code;
+#ifdef GRAVEYARD_SIMD_LEXER
+#ifdef __AVX2__
+typedef __m256i LexerVector;
+#define LEXER_VECTOR_SIZE 32
+#define lexer_load(p) _mm256_loadu_si256((const __m256i*)(p))
+#define lexer_splat(c) _mm256_set1_epi8((char)(c))
+#define lexer_eq(a, b) _mm256_cmpeq_epi8(a, b)
+#define lexer_gt(a, b) _mm256_cmpgt_epi8(a, b)
+#define lexer_or(a, b) _mm256_or_si256(a, b)
+#define lexer_and(a, b) _mm256_and_si256(a, b)
+#define lexer_movemask(v) ((uint32_t)_mm256_movemask_epi8(v))
+#else
+typedef __m128i LexerVector;
+#define LEXER_VECTOR_SIZE 16
+#define lexer_load(p) _mm_loadu_si128((const __m128i*)(p))
+#define lexer_splat(c) _mm_set1_epi8((char)(c))
+#define lexer_eq(a, b) _mm_cmpeq_epi8(a, b)
+#define lexer_gt(a, b) _mm_cmpgt_epi8(a, b)
+#define lexer_or(a, b) _mm_or_si128(a, b)
+#define lexer_and(a, b) _mm_and_si128(a, b)
+#define lexer_movemask(v) ((uint32_t)_mm_movemask_epi8(v))
+#endif
+#define LEXER_VECTOR_MASK ((uint32_t)(((uint64_t)1 << LEXER_VECTOR_SIZE) - 1))
 
-    size_t capacity = 16;
-    size_t count = 0;
-    Token *tokens = malloc(capacity * sizeof(Token));
-    if (!tokens) {
-        perror("tokenize: malloc failed");
-        return false;
+static inline LexerVector lexer_in_range(LexerVector v, char low, char high) {
+    return lexer_and(lexer_gt(v, lexer_splat(low - 1)), lexer_gt(lexer_splat(high + 1), v));
+}
+
+static inline uint32_t lexer_ident_mask(LexerVector v) {
+    LexerVector letters = lexer_or(lexer_in_range(v, 'a', 'z'), lexer_in_range(v, 'A', 'Z'));
+    LexerVector rest = lexer_or(lexer_in_range(v, '0', '9'), lexer_eq(v, lexer_splat('_')));
+    return lexer_movemask(lexer_or(letters, rest));
+}
+
+static inline uint32_t lexer_space_mask(LexerVector v) {
+    return lexer_movemask(lexer_or(lexer_eq(v, lexer_splat(' ')), lexer_in_range(v, '\t', '\r')));
+}
+
+static inline uint32_t lexer_any_mask(LexerVector v, char a, char b, char c) {
+    LexerVector hits = lexer_or(lexer_eq(v, lexer_splat(a)), lexer_eq(v, lexer_splat(b)));
+    return lexer_movemask(lexer_or(hits, lexer_eq(v, lexer_splat(c))));
+}
+#endif
+
+static inline const char* lexer_skip_identifier(const char* p, const char* end) {
+#ifdef GRAVEYARD_SIMD_LEXER
+    while (p + LEXER_VECTOR_SIZE <= end) {
+        uint32_t stop = ~lexer_ident_mask(lexer_load(p)) & LEXER_VECTOR_MASK;
+        if (stop) return p + __builtin_ctz(stop);
+        p += LEXER_VECTOR_SIZE;
     }
+#endif
+    while (p < end && (isalnum((unsigned char)*p) || *p == '_')) p++;
+    return p;
+}
 
-    TokenizerState state_stack[MAX_STATE_STACK];
-    int state_top = -1; 
+static inline const char* lexer_skip_digits(const char* p, const char* end) {
+#ifdef GRAVEYARD_SIMD_LEXER
+    while (p + LEXER_VECTOR_SIZE <= end) {
+        uint32_t stop = ~lexer_movemask(lexer_in_range(lexer_load(p), '0', '9')) & LEXER_VECTOR_MASK;
+        if (stop) return p + __builtin_ctz(stop);
+        p += LEXER_VECTOR_SIZE;
+    }
+#endif
+    while (p < end && isdigit((unsigned char)*p)) p++;
+    return p;
+}
 
-    int fstring_brace_depth_stack[MAX_STATE_STACK];
-    int fstring_depth_top = -1;
+static inline const char* lexer_find_any(const char* p, const char* end, char a, char b, char c) {
+#ifdef GRAVEYARD_SIMD_LEXER
+    while (p + LEXER_VECTOR_SIZE <= end) {
+        uint32_t hits = lexer_any_mask(lexer_load(p), a, b, c);
+        if (hits) return p + __builtin_ctz(hits);
+        p += LEXER_VECTOR_SIZE;
+    }
+#endif
+    while (p < end && *p != a && *p != b && *p != c) p++;
+    return p;
+}
 
-    if (state_top + 1 >= MAX_STATE_STACK) {
-        fprintf(stderr, "Tokenizer error: State stack overflow (too much nesting).\n");
-        goto cleanup_failure;
+static inline const char* lexer_skip_whitespace(const char* p, const char* end, size_t* line, const char** line_start) {
+#ifdef GRAVEYARD_SIMD_LEXER
+    while (p + LEXER_VECTOR_SIZE <= end) {
+        LexerVector v = lexer_load(p);
+        uint32_t stop = ~lexer_space_mask(v) & LEXER_VECTOR_MASK;
+        uint32_t newlines = lexer_movemask(lexer_eq(v, lexer_splat('\n')));
+        int span = stop ? __builtin_ctz(stop) : LEXER_VECTOR_SIZE;
+        newlines &= (uint32_t)(((uint64_t)1 << span) - 1);
+        if (newlines) {
+            *line += __builtin_popcount(newlines);
+            *line_start = p + (31 - __builtin_clz(newlines)) + 1;
+        }
+        if (stop) return p + span;
+        p += LEXER_VECTOR_SIZE;
     }
-    state_stack[++state_top] = STATE_DEFAULT;
-    
-    size_t line = 1;
-    const char* line_start_ptr = source;
-    const char* current_ptr = source;
+#endif
+    while (p < end && isspace((unsigned char)*p)) {
+        if (*p == '\n') { (*line)++; *line_start = p + 1; }
+        p++;
+    }
+    return p;
+}
 
-    while (*current_ptr != '\0') {
-        if (count + 1 >= capacity) {
-            size_t new_capacity = capacity * 2;
-            Token *new_tokens = realloc(tokens, new_capacity * sizeof(Token));
-            if (!new_tokens) { perror("tokenize: realloc failed"); goto cleanup_failure; }
-            tokens = new_tokens;
-            capacity = new_capacity;
-        }
+static void lexer_init(Lexer* lexer, Graveyard* gy) {
+    lexer->gy = gy;
+    lexer->source = gy->source_code;
+    lexer->source_end = lexer->source + strlen(lexer->source);
+    lexer->current_ptr = lexer->source;
+    lexer->line_start_ptr = lexer->source;
+    lexer->line = 1;
+    lexer->state_top = 0;
+    lexer->state_stack[0] = STATE_DEFAULT;
+    lexer->fstring_depth_top = -1;
+    lexer->had_error = false;
+}
 
-        TokenizerState current_state = state_stack[state_top];
+static bool lexer_next(Lexer* lexer, Token* token) {
+    const char* source = lexer->source;
+    const char* source_end = lexer->source_end;
+    const char* current_ptr = lexer->current_ptr;
+    const char* line_start_ptr = lexer->line_start_ptr;
+    size_t line = lexer->line;
+
+    if (lexer->had_error) goto fail;
+
+    while (*current_ptr != '\0') {
+        TokenizerState current_state = lexer->state_stack[lexer->state_top];
         int column = (current_ptr - line_start_ptr) + 1;
         char c = *current_ptr;
 
         if (current_state == STATE_IN_FMT_STRING) {
             if (c == '\'') {
-                state_top--;
-                tokens[count].type = FORMATTEDEND;
-                tokens[count].lexeme[0] = '\''; tokens[count].lexeme[1] = '\0';
-                tokens[count].line = line; tokens[count].column = column;
-                count++;
+                lexer->state_top--;
+                token->type = FORMATTEDEND;
+                token->start = current_ptr - source; token->length = 1;
+                token->line = line; token->column = column;
                 current_ptr++;
-                continue;
+                goto emit;
             }
             if (c == '{') {
-                state_stack[++state_top] = STATE_DEFAULT; 
-                fstring_brace_depth_stack[++fstring_depth_top] = 1;
+                lexer->state_stack[++lexer->state_top] = STATE_DEFAULT; 
+                lexer->fstring_brace_depth_stack[++lexer->fstring_depth_top] = 1;
                 
-                tokens[count].type = LEFTBRACE;
-                tokens[count].lexeme[0] = '{'; tokens[count].lexeme[1] = '\0';
-                tokens[count].line = line; tokens[count].column = column;
-                count++;
+                token->type = LEFTBRACE;
+                token->start = current_ptr - source; token->length = 1;
+                token->line = line; token->column = column;
                 current_ptr++;
-                continue;
+                goto emit;
             }
             if (c == '\n' || c == '\0') {
                 fprintf(stderr, "Tokenizer error [line %zu, col %d]: Unterminated formatted string.\n", line, column);
-                goto cleanup_failure;
+                goto fail;
             }
             const char* start = current_ptr;
-            while (*current_ptr != '\0' && *current_ptr != '\'' && *current_ptr != '{' && *current_ptr != '\n') {
-                current_ptr++;
-            }
+            current_ptr = lexer_find_any(current_ptr, source_end, '\'', '{', '\n');
             size_t len = current_ptr - start;
             if (len > 0) {
-                 if (len >= MAX_LEXEME_LEN) {
-                    fprintf(stderr, "Tokenizer error [line %zu, col %d]: Literal part of formatted string is too long.\n", line, column);
-                    goto cleanup_failure;
-                }
-                tokens[count].type = FORMATTEDPART;
-                strncpy(tokens[count].lexeme, start, len);
-                tokens[count].lexeme[len] = '\0';
-                tokens[count].line = line;
-                tokens[count].column = column;
-                count++;
+                token->type = FORMATTEDPART;
+                token->start = start - source; token->length = len;
+                token->line = line;
+                token->column = column;
+                goto emit;
             }
             continue;
         }
 
-        if (strncmp(current_ptr, "//", 2) == 0) {
-            while (*current_ptr != '\0' && *current_ptr != '\n') { current_ptr++; }
+        if (c == '/' && current_ptr[1] == '/') {
+            current_ptr = lexer_find_any(current_ptr, source_end, '\n', '\n', '\n');
             continue;
         }
-        if (strncmp(current_ptr, "/*", 2) == 0) {
+        if (c == '/' && current_ptr[1] == '*') {
             int comment_start_line = line;
             int comment_start_col = column;
             current_ptr += 2;
-            while (*current_ptr != '\0' && strncmp(current_ptr, "*/", 2) != 0) {
-                 if (*current_ptr == '\n') { line++; line_start_ptr = current_ptr + 1; }
-                 current_ptr++;
+            for (;;) {
+                current_ptr = lexer_find_any(current_ptr, source_end, '*', '\n', '\n');
+                if (current_ptr == source_end || (*current_ptr == '*' && current_ptr[1] == '/')) break;
+                if (*current_ptr == '\n') { line++; line_start_ptr = current_ptr + 1; }
+                current_ptr++;
             }
             if (*current_ptr == '\0') {
                 fprintf(stderr, "Tokenizer error [line %d, col %d]: Unterminated block comment.\n", comment_start_line, comment_start_col);
-                goto cleanup_failure;
+                goto fail;
             }
             current_ptr += 2;
             continue;
         }
         if (isspace((unsigned char)c)) {
-            if (c == '\n') { line++; line_start_ptr = current_ptr + 1; }
-            current_ptr++;
+            current_ptr = lexer_skip_whitespace(current_ptr, source_end, &line, &line_start_ptr);
             continue;
         }
 
         if (c == '\'') {
-            if (state_top + 1 >= MAX_STATE_STACK) {
+            if (lexer->state_top + 1 >= MAX_STATE_STACK) {
                 fprintf(stderr, "Tokenizer error [line %zu]: Formatted string nesting level too deep.\n", line);
-                goto cleanup_failure;
+                goto fail;
             }
-            state_stack[++state_top] = STATE_IN_FMT_STRING;
+            lexer->state_stack[++lexer->state_top] = STATE_IN_FMT_STRING;
             
-            tokens[count].type = FORMATTEDSTART;
-            tokens[count].lexeme[0] = '\''; tokens[count].lexeme[1] = '\0';
-            tokens[count].line = line; tokens[count].column = column;
-            count++;
+            token->type = FORMATTEDSTART;
+            token->start = current_ptr - source; token->length = 1;
+            token->line = line; token->column = column;
             current_ptr++;
-            continue;
+            goto emit;
         }
         
-        if (fstring_depth_top > -1) {
+        if (lexer->fstring_depth_top > -1) {
             if (c == '{') {
-                fstring_brace_depth_stack[fstring_depth_top]++;
+                lexer->fstring_brace_depth_stack[lexer->fstring_depth_top]++;
             } else if (c == '}') {
-                fstring_brace_depth_stack[fstring_depth_top]--;
-                if (fstring_brace_depth_stack[fstring_depth_top] == 0) {
-                    fstring_depth_top--;
-                    state_top--;
+                lexer->fstring_brace_depth_stack[lexer->fstring_depth_top]--;
+                if (lexer->fstring_brace_depth_stack[lexer->fstring_depth_top] == 0) {
+                    lexer->fstring_depth_top--;
+                    lexer->state_top--;
                 }
             }
         }
         
         if (isalpha((unsigned char)c) || c == '_') {
             const char* start = current_ptr;
-            while (*current_ptr != '\0' && (isalnum((unsigned char)*current_ptr) || *current_ptr == '_')) { current_ptr++; }
-            size_t len = current_ptr - start;
-            if (len >= MAX_LEXEME_LEN) {
-                fprintf(stderr, "Tokenizer error [line %d, col %d]: Identifier is too long.\n", line, column); goto cleanup_failure;
-            }
-            tokens[count].type = IDENTIFIER;
-            strncpy(tokens[count].lexeme, start, len); tokens[count].lexeme[len] = '\0';
-            tokens[count].line = line; tokens[count].column = column;
-            count++;
+            current_ptr = lexer_skip_identifier(current_ptr, source_end);
+            token->type = IDENTIFIER;
+            token->start = start - source; token->length = current_ptr - start;
+            token->line = line; token->column = column;
+            goto emit;
 
         } else if (isdigit((unsigned char)c) || (c == '.' && *(current_ptr + 1) != '\0' && isdigit((unsigned char)*(current_ptr+1)))) {
             const char* start = current_ptr;
-            while (*current_ptr != '\0' && isdigit((unsigned char)*current_ptr)) { current_ptr++; }
+            current_ptr = lexer_skip_digits(current_ptr, source_end);
             if (*current_ptr == '.' && *(current_ptr + 1) != '\0' && isdigit((unsigned char)*(current_ptr + 1))) {
-                current_ptr++;
-                while (*current_ptr != '\0' && isdigit((unsigned char)*current_ptr)) { current_ptr++; }
+                current_ptr = lexer_skip_digits(current_ptr + 1, source_end);
             }
-            size_t len = current_ptr - start;
-            if (len >= MAX_LEXEME_LEN) {
-                fprintf(stderr, "Tokenizer error [line %d, col %d]: Number literal is too long.\n", line, column); goto cleanup_failure;
-            }
-            tokens[count].type = NUMBER;
-            strncpy(tokens[count].lexeme, start, len); tokens[count].lexeme[len] = '\0';
-            tokens[count].line = line; tokens[count].column = column;
-            count++;
+            token->type = NUMBER;
+            token->start = start - source; token->length = current_ptr - start;
+            token->line = line; token->column = column;
+            goto emit;
 
         } else if (c == '"') {
             int start_line = line;
             int start_col = column;
             current_ptr++;
+            const char* start = current_ptr;
 
-            char lexeme_buffer[MAX_LEXEME_LEN];
-            size_t len = 0;
-
-            while (*current_ptr != '\0' && *current_ptr != '"') {
-                char ch = *current_ptr;
-                if (ch == '\n') {
-                    fprintf(stderr, "Tokenizer error [line %d, col %d]: Unterminated string literal (newline encountered).\n", line, column);
-                    goto cleanup_failure;
+            for (;;) {
+                current_ptr = lexer_find_any(current_ptr, source_end, '"', '\\', '\n');
+                if (current_ptr == source_end || *current_ptr == '"') break;
+                if (*current_ptr == '\n') {
+                    fprintf(stderr, "Tokenizer error [line %zu, col %d]: Unterminated string literal (newline encountered).\n", line, column);
+                    goto fail;
                 }
-                if (len >= MAX_LEXEME_LEN - 1) {
-                    fprintf(stderr, "Tokenizer error [line %d, col %d]: String literal is too long.\n", start_line, start_col);
-                    goto cleanup_failure;
-                }
-                if (ch == '\\' && *(current_ptr + 1) != '\0') {
+                if (*(current_ptr + 1) != '\0') {
                     current_ptr++;
-                    char next_ch = *current_ptr;
-                    switch (next_ch) {
-                        case 'n':  lexeme_buffer[len++] = '\n'; break;
-                        case 't':  lexeme_buffer[len++] = '\t'; break;
-                        case '"':  lexeme_buffer[len++] = '\"'; break;
-                        case '\\': lexeme_buffer[len++] = '\\'; break;
-                        default:   lexeme_buffer[len++] = next_ch; break;
-                    }
-                } else {
-                    lexeme_buffer[len++] = ch;
                 }
                 current_ptr++;
             }
+            size_t len = current_ptr - start;
 
             if (*current_ptr != '"') {
                 fprintf(stderr, "Tokenizer error [line %d, col %d]: Unterminated string literal.\n", start_line, start_col);
-                goto cleanup_failure;
+                goto fail;
             }
             current_ptr++;
 
-            tokens[count].type = STRING;
-            strncpy(tokens[count].lexeme, lexeme_buffer, len);
-            tokens[count].lexeme[len] = '\0';
-            tokens[count].line = start_line;
-            tokens[count].column = start_col;
-            count++;
+            token->type = STRING;
+            token->start = start - source; token->length = len;
+            token->line = start_line;
+            token->column = start_col;
+            goto emit;
 
         } else {
             const char* start = current_ptr;
             if (c == '<') {
                 const char* lookahead_ptr = current_ptr + 1;
                 if (*lookahead_ptr != '\0' && (isalpha((unsigned char)*lookahead_ptr) || *lookahead_ptr == '_')) {
-                    lookahead_ptr++;
-                    while (*lookahead_ptr != '\0' && (isalnum((unsigned char)*lookahead_ptr) || *lookahead_ptr == '_')) { lookahead_ptr++; }
+                    lookahead_ptr = lexer_skip_identifier(lookahead_ptr + 1, source_end);
                     if (*lookahead_ptr != '\0' && *lookahead_ptr == '>') {
-                        size_t len = (lookahead_ptr + 1) - start;
-                        if (len >= MAX_LEXEME_LEN) {
-                            fprintf(stderr, "Tokenizer error [line %d, col %d]: TYPE_IDENTIFIER is too long.\n", line, column); goto cleanup_failure;
-                        }
-                        tokens[count].type = TYPE;
-                        strncpy(tokens[count].lexeme, start, len); tokens[count].lexeme[len] = '\0';
-                        tokens[count].line = line; tokens[count].column = column;
-                        count++;
+                        token->type = TYPE;
+                        token->start = start - source; token->length = (lookahead_ptr + 1) - start;
+                        token->line = line; token->column = column;
                         current_ptr = lookahead_ptr + 1;
-                        continue;
+                        goto emit;
                     }
                 }
             }
@@ -1200,44 +1760,88 @@ bool tokenize(Graveyard *gy) {
             if (*(start + 1) != '\0' && *(start + 2) != '\0') {
                 ttype = identify_three_char_token(start[0], start[1], start[2]);
                 if (ttype != UNKNOWN) {
-                    snprintf(tokens[count].lexeme, 4, "%c%c%c", start[0], start[1], start[2]);
-                    tokens[count].type = ttype; tokens[count].line = line; tokens[count].column = column;
-                    count++; current_ptr += 3; continue;
+                    token->start = start - source; token->length = 3;
+                    token->type = ttype; token->line = line; token->column = column;
+                    current_ptr += 3; goto emit;
                 }
             }
             if (*(start + 1) != '\0') {
                 ttype = identify_two_char_token(start[0], start[1]);
                 if (ttype != UNKNOWN) {
-                    snprintf(tokens[count].lexeme, 3, "%c%c", start[0], start[1]);
-                    tokens[count].type = ttype; tokens[count].line = line; tokens[count].column = column;
-                    count++; current_ptr += 2; continue;
+                    token->start = start - source; token->length = 2;
+                    token->type = ttype; token->line = line; token->column = column;
+                    current_ptr += 2; goto emit;
                 }
             }
 
             ttype = identify_single_char_token(c);
             if (ttype == UNKNOWN) {
-                fprintf(stderr, "Tokenizer error [line %d, col %d]: Unknown character encountered: '%c'\n", line, column, c);
-                goto cleanup_failure;
+                fprintf(stderr, "Tokenizer error [line %zu, col %d]: Unknown character encountered: '%c'\n", line, column, c);
+                goto fail;
             }
-            tokens[count].type = ttype;
-            tokens[count].lexeme[0] = c; tokens[count].lexeme[1] = '\0';
-            tokens[count].line = line; tokens[count].column = column;
-            count++;
+            token->type = ttype;
+            token->start = start - source; token->length = 1;
+            token->line = line; token->column = column;
             current_ptr++;
+            goto emit;
         }
     }
 
-    if (state_top != 0) {
+    if (lexer->state_top != 0) {
         fprintf(stderr, "Tokenizer error [line %zu]: Unterminated formatted string at end of file.\n", line);
-        goto cleanup_failure;
+        goto fail;
+    }
+
+    token->type = TOKENEOF;
+    token->start = current_ptr - source; token->length = 0;
+    token->line = line;
+    token->column = (current_ptr - line_start_ptr) + 1;
+
+emit:
+    if (token->type == IDENTIFIER || token->type == TYPE) {
+        token->symbol = intern_token_slice(&lexer->gy->symbols, source + token->start, token->length);
+    } else {
+        token->symbol = NULL;
+    }
+    lexer->current_ptr = current_ptr;
+    lexer->line_start_ptr = line_start_ptr;
+    lexer->line = line;
+    return true;
+
+fail:
+    lexer->had_error = true;
+    lexer->current_ptr = current_ptr;
+    token->type = TOKENEOF;
+    token->start = current_ptr - source; token->length = 0;
+    token->line = line;
+    token->column = (current_ptr - line_start_ptr) + 1;
+    token->symbol = NULL;
+    return false;
+}
+
+bool tokenize(Graveyard *gy) {
+    size_t capacity = 16;
+    size_t count = 0;
+    Token *tokens = malloc(capacity * sizeof(Token));
+    if (!tokens) {
+        perror("tokenize: malloc failed");
+        return false;
+    }
+
+    Lexer lexer;
+    lexer_init(&lexer, gy);
+    for (;;) {
+        if (count >= capacity) {
+            size_t new_capacity = capacity * 2;
+            Token *new_tokens = realloc(tokens, new_capacity * sizeof(Token));
+            if (!new_tokens) { perror("tokenize: realloc failed"); goto cleanup_failure; }
+            tokens = new_tokens;
+            capacity = new_capacity;
+        }
+        if (!lexer_next(&lexer, &tokens[count])) goto cleanup_failure;
+        if (tokens[count++].type == TOKENEOF) break;
     }
 
-    tokens[count].type = TOKENEOF;
-    tokens[count].lexeme[0] = '\0';
-    tokens[count].line = line;
-    tokens[count].column = (current_ptr - line_start_ptr) + 1;
-    count++;
-    
     Token *shrunk_tokens = realloc(tokens, count * sizeof(Token));
     if (shrunk_tokens) { tokens = shrunk_tokens; }
     
@@ -1254,188 +1858,262 @@ cleanup_failure:
 
 //PARSE---------------------------------------------------------------
 
-void free_ast(AstNode* node) {
-    if (node == NULL) return;
+static void chunk_free(Graveyard* gy, Chunk* chunk);
+static void jit_free(JitFunction* jit);
+static void memo_cache_free(Graveyard* gy, MemoCache* cache);
+static void scope_layout_free(ScopeLayout* layout);
+static void dec_ref(Graveyard* gy, GraveyardValue value);
+static GraveyardValue create_string_value(Graveyard* gy, const char* chars);
+
+static void ast_arena_init(AstArena* arena) {
+    arena->head = NULL;
+    arena->owners = NULL;
+    arena->owner_count = 0;
+    arena->owner_capacity = 0;
+}
 
-    switch (node->type) {
-        case AST_PROGRAM:
-            for (size_t i = 0; i < node->as.program.count; i++) {
-                free_ast(node->as.program.statements[i]);
-            }
-            free(node->as.program.statements);
-            break;
-        case AST_PRINT_STATEMENT:
-            for (size_t i = 0; i < node->as.print_stmt.count; i++) {
-                free_ast(node->as.print_stmt.expressions[i]);
-            }
-            free(node->as.print_stmt.expressions);
-            break;
-        case AST_SCAN_STATEMENT:
-            free_ast(node->as.scan_statement.prompt);
+static void* ast_arena_alloc(AstArena* arena, size_t size) {
+    size = (size + 7) & ~(size_t)7;
+
+    ScratchChunk* chunk = arena->head;
+    if (chunk == NULL || chunk->used + size > chunk->capacity) {
+        size_t capacity = size > AST_ARENA_CHUNK_SIZE ? size : AST_ARENA_CHUNK_SIZE;
+        chunk = malloc(sizeof(ScratchChunk) + capacity);
+        if (!chunk) {
+            perror("ast_arena_alloc: malloc failed");
+            exit(1);
+        }
+        chunk->capacity = capacity;
+        chunk->used = 0;
+        chunk->next = arena->head;
+        arena->head = chunk;
+    }
+
+    void* memory = chunk->data + chunk->used;
+    chunk->used += size;
+    memset(memory, 0, size);
+    return memory;
+}
+
+static void* ast_arena_grow(AstArena* arena, void* memory, size_t old_size, size_t new_size) {
+    old_size = (old_size + 7) & ~(size_t)7;
+    new_size = (new_size + 7) & ~(size_t)7;
+
+    ScratchChunk* chunk = arena->head;
+    if (chunk != NULL && (unsigned char*)memory + old_size == chunk->data + chunk->used &&
+        chunk->used - old_size + new_size <= chunk->capacity) {
+        memset(chunk->data + chunk->used, 0, new_size - old_size);
+        chunk->used += new_size - old_size;
+        return memory;
+    }
+
+    void* grown = ast_arena_alloc(arena, new_size);
+    memcpy(grown, memory, old_size);
+    return grown;
+}
+
+static void ast_arena_own(AstArena* arena, AstNode* node) {
+    if (arena->owner_count >= arena->owner_capacity) {
+        size_t new_capacity = arena->owner_capacity < 64 ? 64 : arena->owner_capacity * 2;
+        AstNode** new_owners = realloc(arena->owners, new_capacity * sizeof(AstNode*));
+        if (!new_owners) {
+            perror("ast_arena_own: realloc failed");
+            exit(1);
+        }
+        arena->owners = new_owners;
+        arena->owner_capacity = new_capacity;
+    }
+    arena->owners[arena->owner_count++] = node;
+}
+
+static void ast_arena_free(Graveyard* gy, AstArena* arena) {
+    for (size_t i = 0; i < arena->owner_count; i++) {
+        AstNode* node = arena->owners[i];
+        if (node->type == AST_BLOCK) {
+            scope_layout_free(node->as.block.layout);
+            chunk_free(gy, node->as.block.chunk);
+            jit_free(node->as.block.jit);
+        } else if (node->type == AST_LITERAL && node->as.literal.string != NULL) {
+            dec_ref(gy, OBJECT_VALUE(VAL_STRING, node->as.literal.string));
+        }
+    }
+    free(arena->owners);
+
+    ScratchChunk* chunk = arena->head;
+    while (chunk != NULL) {
+        ScratchChunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    ast_arena_init(arena);
+}
+
+static void decode_literal(Parser* parser, AstNode* node) {
+    AstToken* token = &node->as.literal.value;
+    if (token->type == NUMBER) {
+        node->as.literal.number = strtod(token->lexeme, NULL);
+    } else if (token->type == STRING) {
+        node->as.literal.string = AS_STRING(create_string_value(parser->gy, token->lexeme));
+        ast_arena_own(&parser->gy->ast_arena, node);
+    }
+}
+
+typedef void (*AstVisitor)(AstNode** slot, void* context);
+
+static void ast_visit_children(AstNode* node, AstVisitor visit, void* context) {
+    if (node == NULL) return;
+
+    switch (node->type) {
+        case AST_PROGRAM:
+            for (size_t i = 0; i < node->as.program.count; i++) visit(&node->as.program.statements[i], context);
+            break;
+        case AST_PRINT_STATEMENT:
+            for (size_t i = 0; i < node->as.print_stmt.count; i++) visit(&node->as.print_stmt.expressions[i], context);
+            break;
+        case AST_SCAN_STATEMENT:
+            visit(&node->as.scan_statement.prompt, context);
             break;
         case AST_LOGICAL_OP:
-            free_ast(node->as.logical_op.left);
-            free_ast(node->as.logical_op.right);
+            visit(&node->as.logical_op.left, context);
+            visit(&node->as.logical_op.right, context);
             break;
         case AST_BINARY_OP:
-            free_ast(node->as.binary_op.left);
-            free_ast(node->as.binary_op.right);
+            visit(&node->as.binary_op.left, context);
+            visit(&node->as.binary_op.right, context);
             break;
         case AST_UNARY_OP:
-            free_ast(node->as.unary_op.right);
+            visit(&node->as.unary_op.right, context);
             break;
         case AST_ASSIGNMENT:
-            free_ast(node->as.assignment.left);
-            free_ast(node->as.assignment.value);
+            visit(&node->as.assignment.left, context);
+            visit(&node->as.assignment.value, context);
             break;
         case AST_FORMATTED_STRING:
             for (size_t i = 0; i < node->as.formatted_string.count; i++) {
-                FmtStringPart part = node->as.formatted_string.parts[i];
-                if (part.type == FMT_PART_EXPRESSION) {
-                    free_ast(part.as.expression);
+                if (node->as.formatted_string.parts[i].type == FMT_PART_EXPRESSION) {
+                    visit(&node->as.formatted_string.parts[i].as.expression, context);
                 }
             }
-            free(node->as.formatted_string.parts);
             break;
         case AST_ARRAY_LITERAL:
-            for (size_t i = 0; i < node->as.array_literal.count; i++) {
-                free_ast(node->as.array_literal.elements[i]);
-            }
-            free(node->as.array_literal.elements);
+            for (size_t i = 0; i < node->as.array_literal.count; i++) visit(&node->as.array_literal.elements[i], context);
             break;
         case AST_SUBSCRIPT:
-            free_ast(node->as.subscript.array);
-            free_ast(node->as.subscript.index);
+            visit(&node->as.subscript.array, context);
+            visit(&node->as.subscript.index, context);
             break;
         case AST_HASHTABLE_LITERAL:
             for (size_t i = 0; i < node->as.hashtable_literal.count; i++) {
-                free_ast(node->as.hashtable_literal.pairs[i].key);
-                free_ast(node->as.hashtable_literal.pairs[i].value);
+                visit(&node->as.hashtable_literal.pairs[i].key, context);
+                visit(&node->as.hashtable_literal.pairs[i].value, context);
             }
-            free(node->as.hashtable_literal.pairs);
             break;
         case AST_FUNCTION_DECLARATION:
-            free(node->as.function_declaration.params);
-            free_ast(node->as.function_declaration.body);
+            visit(&node->as.function_declaration.body, context);
             break;
         case AST_CALL_EXPRESSION:
-            free_ast(node->as.call_expression.callee);
-            for (size_t i = 0; i < node->as.call_expression.arg_count; i++) {
-                free_ast(node->as.call_expression.arguments[i]);
-            }
-            free(node->as.call_expression.arguments);
+            visit(&node->as.call_expression.callee, context);
+            for (size_t i = 0; i < node->as.call_expression.arg_count; i++) visit(&node->as.call_expression.arguments[i], context);
             break;
         case AST_RETURN_STATEMENT:
-            free_ast(node->as.return_statement.value);
+            if (node->as.return_statement.value) visit(&node->as.return_statement.value, context);
             break;
-
         case AST_BLOCK:
-            for (size_t i = 0; i < node->as.block.count; i++) {
-                free_ast(node->as.block.statements[i]);
-            }
-            free(node->as.block.statements);
+            for (size_t i = 0; i < node->as.block.count; i++) visit(&node->as.block.statements[i], context);
             break;
         case AST_EXPRESSION_STATEMENT:
-            free_ast(node->as.expression_statement.expression);
+            visit(&node->as.expression_statement.expression, context);
             break;
         case AST_IF_STATEMENT:
-            free_ast(node->as.if_statement.condition);
-            free_ast(node->as.if_statement.then_branch);
+            visit(&node->as.if_statement.condition, context);
+            visit(&node->as.if_statement.then_branch, context);
             for (size_t i = 0; i < node->as.if_statement.else_if_count; i++) {
-                free_ast(node->as.if_statement.else_if_clauses[i].condition);
-                free_ast(node->as.if_statement.else_if_clauses[i].body);
+                visit(&node->as.if_statement.else_if_clauses[i].condition, context);
+                visit(&node->as.if_statement.else_if_clauses[i].body, context);
             }
-            free(node->as.if_statement.else_if_clauses);
-            free_ast(node->as.if_statement.else_branch);
+            if (node->as.if_statement.else_branch) visit(&node->as.if_statement.else_branch, context);
             break;
         case AST_TERNARY_EXPRESSION:
-            free_ast(node->as.ternary_expression.condition);
-            free_ast(node->as.ternary_expression.then_expr);
-            free_ast(node->as.ternary_expression.else_expr);
+            visit(&node->as.ternary_expression.condition, context);
+            visit(&node->as.ternary_expression.then_expr, context);
+            visit(&node->as.ternary_expression.else_expr, context);
             break;
         case AST_ASSERT_STATEMENT:
-            free_ast(node->as.assert_statement.condition);
+            visit(&node->as.assert_statement.condition, context);
             break;
         case AST_WHILE_STATEMENT:
-            free_ast(node->as.while_statement.condition);
-            free_ast(node->as.while_statement.body);
+            visit(&node->as.while_statement.condition, context);
+            visit(&node->as.while_statement.body, context);
             break;
         case AST_FOR_STATEMENT:
-            for (size_t i = 0; i < node->as.for_statement.range_count; i++) {
-                free_ast(node->as.for_statement.range_expressions[i]);
-            }
-            free(node->as.for_statement.range_expressions);
-            free_ast(node->as.for_statement.body);
+            for (size_t i = 0; i < node->as.for_statement.range_count; i++) visit(&node->as.for_statement.range_expressions[i], context);
+            visit(&node->as.for_statement.body, context);
             break;
         case AST_RAISE_STATEMENT:
-            free_ast(node->as.raise_statement.error_expr);
+            visit(&node->as.raise_statement.error_expr, context);
             break;
         case AST_NAMESPACE_DECLARATION:
-            free_ast(node->as.namespace_declaration.body);
+            visit(&node->as.namespace_declaration.body, context);
             break;
         case AST_FILEREAD_STATEMENT:
-            free_ast(node->as.fileread_statement.path_expr);
+            visit(&node->as.fileread_statement.path_expr, context);
             break;
         case AST_TYPE_DECLARATION:
-            free_ast(node->as.type_declaration.body);
+            visit(&node->as.type_declaration.body, context);
             break;
         case AST_MEMBER_ACCESS:
-            free_ast(node->as.member_access.object);
+            visit(&node->as.member_access.object, context);
             break;
         case AST_EXECUTE_EXPRESSION:
-            free_ast(node->as.execute_expression.command_expr);
+            visit(&node->as.execute_expression.command_expr, context);
             break;
         case AST_WAIT_STATEMENT:
-            free_ast(node->as.wait_statement.duration_expr);
+            visit(&node->as.wait_statement.duration_expr, context);
             break;
         case AST_UID_EXPRESSION:
-            free_ast(node->as.uid_expression.length_expr);
+            visit(&node->as.uid_expression.length_expr, context);
             break;
         case AST_SLICE_EXPRESSION:
-            free_ast(node->as.slice_expression.collection);
-            free_ast(node->as.slice_expression.start_expr);
-            free_ast(node->as.slice_expression.stop_expr);
-            free_ast(node->as.slice_expression.step_expr);
+            visit(&node->as.slice_expression.collection, context);
+            if (node->as.slice_expression.start_expr) visit(&node->as.slice_expression.start_expr, context);
+            if (node->as.slice_expression.stop_expr) visit(&node->as.slice_expression.stop_expr, context);
+            if (node->as.slice_expression.step_expr) visit(&node->as.slice_expression.step_expr, context);
             break;
         case AST_EVAL_EXPRESSION:
-            free_ast(node->as.eval_expression.code_expr);
+            visit(&node->as.eval_expression.code_expr, context);
             break;
         case AST_EXISTS_EXPRESSION:
-            free_ast(node->as.exists_expression.path_expr);
+            visit(&node->as.exists_expression.path_expr, context);
             break;
         case AST_LISTDIR_EXPRESSION:
-            free_ast(node->as.listdir_expression.path_expr);
+            visit(&node->as.listdir_expression.path_expr, context);
             break;
         case AST_TRY_EXCEPT_STATEMENT:
-            free_ast(node->as.try_except_statement.try_block);
-            if (node->as.try_except_statement.except_clause) {
-                free_ast(node->as.try_except_statement.except_clause->body);
-                free(node->as.try_except_statement.except_clause);
-            }
-            free_ast(node->as.try_except_statement.finally_block);
+            visit(&node->as.try_except_statement.try_block, context);
+            if (node->as.try_except_statement.except_clause) visit(&node->as.try_except_statement.except_clause->body, context);
+            if (node->as.try_except_statement.finally_block) visit(&node->as.try_except_statement.finally_block, context);
             break;
         case AST_VAR_DECLARATION:
-            free_ast(node->as.var_declaration.initializer);
+            if (node->as.var_declaration.initializer) visit(&node->as.var_declaration.initializer, context);
             break;
-        case AST_ARGV_EXPRESSION:
-        case AST_STATIC_ACCESS:
-        case AST_GLOBAL_ACCESS:
-        case AST_RANDOM_EXPRESSION:
-        case AST_CAT_CONSTANT_EXPRESSION:
-        case AST_THIS_EXPRESSION:
-        case AST_NAMESPACE_ACCESS:
-        case AST_TIME_EXPRESSION:
-        case AST_BREAK_STATEMENT:
-        case AST_CONTINUE_STATEMENT:
-        case AST_IDENTIFIER:
-        case AST_LITERAL:
+        default:
             break;
     }
-    free(node);
+}
+
+static Token* parser_token(Parser* parser, size_t index) {
+    while (parser->lexed <= index) {
+        if (!lexer_next(&parser->lexer, &parser->window[parser->lexed % PARSER_TOKEN_WINDOW])) {
+            parser->had_error = true;
+            parser->gy->had_token_error = true;
+        }
+        parser->lexed++;
+    }
+    return &parser->window[index % PARSER_TOKEN_WINDOW];
 }
 
 static Token* peek(Parser* parser) {
-    return &parser->tokens[parser->current];
+    return parser_token(parser, parser->current);
 }
 
 static bool is_at_end(Parser* parser) {
@@ -1446,7 +2124,7 @@ static Token* consume(Parser* parser) {
     if (!is_at_end(parser)) {
         parser->current++;
     }
-    return &parser->tokens[parser->current - 1];
+    return parser_token(parser, parser->current - 1);
 }
 
 static void error_at_token(Parser* parser, Token* token, const char* message) {
@@ -1457,7 +2135,7 @@ static void error_at_token(Parser* parser, Token* token, const char* message) {
     if (token->type == TOKENEOF) {
         fprintf(stderr, "at end of file. ");
     } else {
-        fprintf(stderr, "at '%s'. ", token->lexeme);
+        fprintf(stderr, "at '%.*s'. ", (int)token->length, parser->gy->source_code + token->start);
     }
     fprintf(stderr, "%s\n", message);
 }
@@ -1480,16 +2158,67 @@ static bool match(Parser* parser, GraveyardTokenType type) {
 }
 
 static AstNode* create_node(Parser* parser, AstNodeType type) {
-    AstNode* node = malloc(sizeof(AstNode));
-    if (!node) {
-        parser->had_error = true;
-        perror("AST node malloc failed");
-        return NULL;
-    }
+    AstNode* node = ast_arena_alloc(&parser->gy->ast_arena, sizeof(AstNode));
     node->type = type;
+    if (type == AST_BLOCK) {
+        ast_arena_own(&parser->gy->ast_arena, node);
+    }
     return node;
 }
 
+static void* parser_alloc(Parser* parser, size_t size) {
+    return ast_arena_alloc(&parser->gy->ast_arena, size);
+}
+
+static void* parser_grow(Parser* parser, void* memory, size_t old_size, size_t new_size) {
+    return ast_arena_grow(&parser->gy->ast_arena, memory, old_size, new_size);
+}
+
+static Symbol* intern_token_lexeme(Parser* parser, const Token* token) {
+    const char* text = parser->gy->source_code + token->start;
+    if (token->type != STRING) {
+        return intern_symbol(&parser->gy->symbols, text, (int)token->length);
+    }
+
+    char stack_buffer[128];
+    char* decoded = stack_buffer;
+    if (token->length >= sizeof(stack_buffer)) {
+        decoded = malloc(token->length + 1);
+        if (!decoded) {
+            perror("intern_token_lexeme: malloc failed");
+            exit(1);
+        }
+    }
+    size_t len = 0;
+    for (size_t i = 0; i < token->length; i++) {
+        char ch = text[i];
+        if (ch == '\\' && i + 1 < token->length) {
+            char next_ch = text[++i];
+            switch (next_ch) {
+                case 'n':  decoded[len++] = '\n'; break;
+                case 't':  decoded[len++] = '\t'; break;
+                default:   decoded[len++] = next_ch; break;
+            }
+        } else {
+            decoded[len++] = ch;
+        }
+    }
+    decoded[len] = '\0';
+
+    Symbol* symbol = intern_symbol(&parser->gy->symbols, decoded, (int)len);
+    if (decoded != stack_buffer) free(decoded);
+    return symbol;
+}
+
+static AstToken ast_token(Parser* parser, const Token* token) {
+    AstToken result;
+    result.type = token->type;
+    result.line = token->line;
+    result.lexeme = intern_token_lexeme(parser, token)->chars;
+    result.symbol = token->symbol;
+    return result;
+}
+
 static int get_operator_precedence(GraveyardTokenType type) {
     switch (type) {
         case ASSIGNMENT:
@@ -1532,7 +2261,7 @@ static AstNode* parse_statement(Parser* parser);
 static AstNode* parse_expression(Parser* parser, int min_precedence);
 
 static AstNode* parse_formatted_string(Parser* parser) {
-    Token start_token = parser->tokens[parser->current - 1];
+    Token start_token = *parser_token(parser, parser->current - 1);
 
     AstNode* node = create_node(parser, AST_FORMATTED_STRING);
     if (!node) return NULL;
@@ -1540,20 +2269,19 @@ static AstNode* parse_formatted_string(Parser* parser) {
 
     node->as.formatted_string.capacity = 4;
     node->as.formatted_string.count = 0;
-    node->as.formatted_string.parts = malloc(node->as.formatted_string.capacity * sizeof(FmtStringPart));
-    if (!node->as.formatted_string.parts) {
-        perror("AST formatted string parts malloc failed");
-        free(node);
-        parser->had_error = true;
-        return NULL;
-    }
+    node->as.formatted_string.parts = parser_alloc(parser, node->as.formatted_string.capacity * sizeof(FmtStringPart));
 
     while (peek(parser)->type != FORMATTEDEND && !is_at_end(parser)) {
+        if (node->as.formatted_string.count >= node->as.formatted_string.capacity) {
+            size_t new_capacity = node->as.formatted_string.capacity * 2;
+            node->as.formatted_string.parts = parser_grow(parser, node->as.formatted_string.parts, node->as.formatted_string.capacity * sizeof(FmtStringPart), new_capacity * sizeof(FmtStringPart));
+            node->as.formatted_string.capacity = new_capacity;
+        }
 
         if (match(parser, FORMATTEDPART)) {
             FmtStringPart part;
             part.type = FMT_PART_LITERAL;
-            part.as.literal = parser->tokens[parser->current - 1];
+            part.as.literal = ast_token(parser, parser_token(parser, parser->current - 1));
             node->as.formatted_string.parts[node->as.formatted_string.count++] = part;
         } else if (match(parser, LEFTBRACE)) {
             FmtStringPart part;
@@ -1572,33 +2300,20 @@ static AstNode* parse_formatted_string(Parser* parser) {
 }
 
 static AstNode* parse_array_literal(Parser* parser) {
-    Token start_token = parser->tokens[parser->current - 1];
+    Token start_token = *parser_token(parser, parser->current - 1);
 
     AstNode* node = create_node(parser, AST_ARRAY_LITERAL);
     if (!node) return NULL;
     node->line = start_token.line;
     node->as.array_literal.capacity = 4;
     node->as.array_literal.count = 0;
-    node->as.array_literal.elements = malloc(node->as.array_literal.capacity * sizeof(AstNode*));
-    if (!node->as.array_literal.elements) {
-        perror("AST array elements malloc failed");
-        free(node);
-        parser->had_error = true;
-        return NULL;
-    }
+    node->as.array_literal.elements = parser_alloc(parser, node->as.array_literal.capacity * sizeof(AstNode*));
 
     if (peek(parser)->type != RIGHTBRACKET) {
         do {
             if (node->as.array_literal.count == node->as.array_literal.capacity) {
                 size_t new_capacity = node->as.array_literal.capacity * 2;
-                AstNode** new_elements = realloc(node->as.array_literal.elements, new_capacity * sizeof(AstNode*));
-                if (!new_elements) {
-                    perror("AST array elements realloc failed");
-                    free_ast(node);
-                    parser->had_error = true;
-                    return NULL;
-                }
-                node->as.array_literal.elements = new_elements;
+                node->as.array_literal.elements = parser_grow(parser, node->as.array_literal.elements, node->as.array_literal.capacity * sizeof(AstNode*), new_capacity * sizeof(AstNode*));
                 node->as.array_literal.capacity = new_capacity;
             }
             
@@ -1614,30 +2329,17 @@ static AstNode* parse_array_literal(Parser* parser) {
 static AstNode* parse_hashtable_literal(Parser* parser) {
     AstNode* node = create_node(parser, AST_HASHTABLE_LITERAL);
     if (!node) return NULL;
-    node->line = parser->tokens[parser->current - 1].line;
+    node->line = parser_token(parser, parser->current - 1)->line;
 
     node->as.hashtable_literal.capacity = 4;
     node->as.hashtable_literal.count = 0;
-    node->as.hashtable_literal.pairs = malloc(node->as.hashtable_literal.capacity * sizeof(AstNodeKeyValuePair));
-    if (!node->as.hashtable_literal.pairs) {
-        perror("AST hashtable pairs malloc failed");
-        free(node);
-        parser->had_error = true;
-        return NULL;
-    }
+    node->as.hashtable_literal.pairs = parser_alloc(parser, node->as.hashtable_literal.capacity * sizeof(AstNodeKeyValuePair));
 
     if (peek(parser)->type != RIGHTBRACE) {
         do {
             if (node->as.hashtable_literal.count >= node->as.hashtable_literal.capacity) {
                 size_t new_capacity = node->as.hashtable_literal.capacity * 2;
-                AstNodeKeyValuePair* new_pairs = realloc(node->as.hashtable_literal.pairs, new_capacity * sizeof(AstNodeKeyValuePair));
-                if (!new_pairs) {
-                    perror("AST hashtable pairs realloc failed");
-                    free_ast(node);
-                    parser->had_error = true;
-                    return NULL;
-                }
-                node->as.hashtable_literal.pairs = new_pairs;
+                node->as.hashtable_literal.pairs = parser_grow(parser, node->as.hashtable_literal.pairs, node->as.hashtable_literal.capacity * sizeof(AstNodeKeyValuePair), new_capacity * sizeof(AstNodeKeyValuePair));
                 node->as.hashtable_literal.capacity = new_capacity;
             }
 
@@ -1660,25 +2362,12 @@ static AstNode* parse_block(Parser* parser) {
     node->line = peek(parser)->line;
     node->as.block.capacity = 8;
     node->as.block.count = 0;
-    node->as.block.statements = malloc(node->as.block.capacity * sizeof(AstNode*));
-    if (!node->as.block.statements) {
-        perror("AST block statements malloc failed");
-        free(node);
-        parser->had_error = true;
-        return NULL;
-    }
+    node->as.block.statements = parser_alloc(parser, node->as.block.capacity * sizeof(AstNode*));
 
     while (peek(parser)->type != RIGHTBRACE && !is_at_end(parser)) {
         if (node->as.block.count >= node->as.block.capacity) {
             size_t new_capacity = node->as.block.capacity * 2;
-            AstNode** new_statements = realloc(node->as.block.statements, new_capacity * sizeof(AstNode*));
-            if (!new_statements) {
-                perror("AST block statements realloc failed");
-                free_ast(node);
-                parser->had_error = true;
-                return NULL;
-            }
-            node->as.block.statements = new_statements;
+            node->as.block.statements = parser_grow(parser, node->as.block.statements, node->as.block.capacity * sizeof(AstNode*), new_capacity * sizeof(AstNode*));
             node->as.block.capacity = new_capacity;
         }
 
@@ -1704,8 +2393,8 @@ static AstNode* parse_block(Parser* parser) {
 
 static AstNode* parse_return_statement(Parser* parser) {
     AstNode* node = create_node(parser, AST_RETURN_STATEMENT);
-    node->line = parser->tokens[parser->current - 1].line;
-    node->as.return_statement.keyword = parser->tokens[parser->current - 1];
+    node->line = parser_token(parser, parser->current - 1)->line;
+    node->as.return_statement.keyword = ast_token(parser, parser_token(parser, parser->current - 1));
 
     if (peek(parser)->type != SEMICOLON) {
         node->as.return_statement.value = parse_expression(parser, 1);
@@ -1722,55 +2411,42 @@ static AstNode* parse_call_expression(Parser* parser, AstNode* callee) {
     node->as.call_expression.callee = callee;
     node->as.call_expression.arg_capacity = 4;
     node->as.call_expression.arg_count = 0;
-    node->as.call_expression.arguments = malloc(node->as.call_expression.arg_capacity * sizeof(AstNode*));
+    node->as.call_expression.arguments = parser_alloc(parser, node->as.call_expression.arg_capacity * sizeof(AstNode*));
 
     if (peek(parser)->type != RIGHTPARENTHESES) {
         do {
             if (node->as.call_expression.arg_count >= node->as.call_expression.arg_capacity) {
                 size_t new_capacity = node->as.call_expression.arg_capacity * 2;
-                AstNode** new_args = realloc(node->as.call_expression.arguments, new_capacity * sizeof(AstNode*));
-                if (!new_args) {
-                    perror("AST call arguments realloc failed");
-                    free_ast(node);
-                    parser->had_error = true;
-                    return NULL;
-                }
-                node->as.call_expression.arguments = new_args;
+                node->as.call_expression.arguments = parser_grow(parser, node->as.call_expression.arguments, node->as.call_expression.arg_capacity * sizeof(AstNode*), new_capacity * sizeof(AstNode*));
                 node->as.call_expression.arg_capacity = new_capacity;
             }
             node->as.call_expression.arguments[node->as.call_expression.arg_count++] = parse_expression(parser, 1);
         } while (match(parser, COMMA));
     }
 
-    node->as.call_expression.paren = *expect(parser, RIGHTPARENTHESES, "Expected ')' after arguments.");
+    node->as.call_expression.paren = ast_token(parser, expect(parser, RIGHTPARENTHESES, "Expected ')' after arguments."));
     return node;
 }
 
 static AstNode* parse_function_declaration(Parser* parser, Token name) {
     AstNode* node = create_node(parser, AST_FUNCTION_DECLARATION);
     node->line = name.line;
-    node->as.function_declaration.name = name;
+    node->as.function_declaration.name = ast_token(parser, &name);
     node->as.function_declaration.param_capacity = 4;
     node->as.function_declaration.param_count = 0;
-    node->as.function_declaration.params = malloc(node->as.function_declaration.param_capacity * sizeof(Token));
+    node->as.function_declaration.params = parser_alloc(parser, node->as.function_declaration.param_capacity * sizeof(AstToken));
 
     while (match(parser, PARAMETER)) {
         if (node->as.function_declaration.param_count >= node->as.function_declaration.param_capacity) {
             size_t new_capacity = node->as.function_declaration.param_capacity * 2;
-            Token* new_params = realloc(node->as.function_declaration.params, new_capacity * sizeof(Token));
-            if (!new_params) {
-                perror("AST function parameters realloc failed");
-                free_ast(node);
-                parser->had_error = true;
-                return NULL;
-            }
-            node->as.function_declaration.params = new_params;
+            node->as.function_declaration.params = parser_grow(parser, node->as.function_declaration.params, node->as.function_declaration.param_capacity * sizeof(AstToken), new_capacity * sizeof(AstToken));
             node->as.function_declaration.param_capacity = new_capacity;
         }
         Token param_name = *expect(parser, IDENTIFIER, "Expected parameter name after '&'.");
-        node->as.function_declaration.params[node->as.function_declaration.param_count++] = param_name;
+        node->as.function_declaration.params[node->as.function_declaration.param_count++] = ast_token(parser, &param_name);
     }
 
+    node->as.function_declaration.is_memoized = match(parser, REFERENCE);
     expect(parser, LEFTBRACE, "Expected '{' to begin function body.");
     node->as.function_declaration.body = parse_block(parser);
 
@@ -1779,10 +2455,10 @@ static AstNode* parse_function_declaration(Parser* parser, Token name) {
 
 static AstNode* parse_namespace_declaration(Parser* parser) {
     AstNode* node = create_node(parser, AST_NAMESPACE_DECLARATION);
-    node->line = parser->tokens[parser->current - 1].line;
+    node->line = parser_token(parser, parser->current - 1)->line;
 
     Token name = *expect(parser, IDENTIFIER, "Expected namespace name after '::'.");
-    node->as.namespace_declaration.name = name;
+    node->as.namespace_declaration.name = ast_token(parser, &name);
 
     expect(parser, LEFTBRACE, "Expected '{' to begin namespace body.");
     node->as.namespace_declaration.body = parse_block(parser);
@@ -1791,10 +2467,10 @@ static AstNode* parse_namespace_declaration(Parser* parser) {
 }
 
 static AstNode* parse_fileread_statement(Parser* parser) {
-    Token variable = parser->tokens[parser->current - 2];
+    Token variable = *parser_token(parser, parser->current - 2);
     AstNode* node = create_node(parser, AST_FILEREAD_STATEMENT);
     node->line = variable.line;
-    node->as.fileread_statement.variable = variable;
+    node->as.fileread_statement.variable = ast_token(parser, &variable);
     node->as.fileread_statement.path_expr = parse_expression(parser, 1);
     
     return node;
@@ -1802,13 +2478,13 @@ static AstNode* parse_fileread_statement(Parser* parser) {
 
 static AstNode* parse_uid_expression(Parser* parser) {
     AstNode* node = create_node(parser, AST_UID_EXPRESSION);
-    node->line = parser->tokens[parser->current - 1].line;
+    node->line = parser_token(parser, parser->current - 1)->line;
     node->as.uid_expression.length_expr = parse_expression(parser, 13);
     return node;
 }
 
 static AstNode* parse_execute_or_eval_expression(Parser* parser) {
-    Token op_token = parser->tokens[parser->current - 1];
+    Token op_token = *parser_token(parser, parser->current - 1);
 
     if (match(parser, AT)) {
         AstNode* node = create_node(parser, AST_EXECUTE_EXPRESSION);
@@ -1824,30 +2500,30 @@ static AstNode* parse_execute_or_eval_expression(Parser* parser) {
 }
 
 static AstNode* parse_primary(Parser* parser) {
-    if (peek(parser)->type == FILEIN && parser->tokens[parser->current + 1].type == AT) {
+    if (peek(parser)->type == FILEIN && parser_token(parser, parser->current + 1)->type == AT) {
         consume(parser);
         consume(parser);
         
         AstNode* node = create_node(parser, AST_LISTDIR_EXPRESSION);
-        node->line = parser->tokens[parser->current - 1].line;
+        node->line = parser_token(parser, parser->current - 1)->line;
         node->as.listdir_expression.path_expr = parse_expression(parser, 1);
         return node;
     }
 
-    if (peek(parser)->type == DOUBLEQUESTION && parser->tokens[parser->current + 1].type == AT) {
+    if (peek(parser)->type == DOUBLEQUESTION && parser_token(parser, parser->current + 1)->type == AT) {
         consume(parser);
         consume(parser);
         
         AstNode* node = create_node(parser, AST_EXISTS_EXPRESSION);
-        node->line = parser->tokens[parser->current - 1].line;
+        node->line = parser_token(parser, parser->current - 1)->line;
         node->as.exists_expression.path_expr = parse_expression(parser, 1);
         return node;
     }
 
     if (match(parser, COLON)) {
         AstNode* node = create_node(parser, AST_ARGV_EXPRESSION);
-        node->line = parser->tokens[parser->current - 1].line;
-        node->as.argv_expression.keyword = parser->tokens[parser->current - 1];
+        node->line = parser_token(parser, parser->current - 1)->line;
+        node->as.argv_expression.keyword = ast_token(parser, parser_token(parser, parser->current - 1));
         return node;
     }
 
@@ -1861,7 +2537,7 @@ static AstNode* parse_primary(Parser* parser) {
             Token member_name = *expect(parser, IDENTIFIER, "Expected member name after '::#'.");
             AstNode* node = create_node(parser, AST_GLOBAL_ACCESS);
             node->line = member_name.line;
-            node->as.global_access.member_name = member_name;
+            node->as.global_access.member_name = ast_token(parser, &member_name);
             return node;
 
         } else if (peek(parser)->type == TYPE) {
@@ -1871,32 +2547,32 @@ static AstNode* parse_primary(Parser* parser) {
 
             AstNode* node = create_node(parser, AST_STATIC_ACCESS);
             node->line = type_name.line;
-            node->as.static_access.type_name = type_name;
-            node->as.static_access.member_name = member_name;
+            node->as.static_access.type_name = ast_token(parser, &type_name);
+            node->as.static_access.member_name = ast_token(parser, &member_name);
             return node;
 
         } else {
             AstNode* node = create_node(parser, AST_NAMESPACE_ACCESS);
-            node->line = parser->tokens[parser->current - 1].line;
+            node->line = parser_token(parser, parser->current - 1)->line;
             Token namespace_name = *expect(parser, IDENTIFIER, "Expected namespace name after '::'.");
             expect(parser, REFERENCE, "Expected '#' after namespace name for member access.");
             Token member_name = *expect(parser, IDENTIFIER, "Expected member name after '#'.");
-            node->as.namespace_access.namespace_name = namespace_name;
-            node->as.namespace_access.member_name = member_name;
+            node->as.namespace_access.namespace_name = ast_token(parser, &namespace_name);
+            node->as.namespace_access.member_name = ast_token(parser, &member_name);
             return node;
         }
     }
     if (match(parser, RANDOM)) {
         AstNode* node = create_node(parser, AST_RANDOM_EXPRESSION);
-        node->line = parser->tokens[parser->current - 1].line;
-        node->as.random_expression.keyword = parser->tokens[parser->current - 1];
+        node->line = parser_token(parser, parser->current - 1)->line;
+        node->as.random_expression.keyword = ast_token(parser, parser_token(parser, parser->current - 1));
         return node;
     }
     
     if (match(parser, CATCONSTANT)) {
         AstNode* node = create_node(parser, AST_CAT_CONSTANT_EXPRESSION);
-        node->line = parser->tokens[parser->current - 1].line;
-        node->as.cat_constant_expression.keyword = parser->tokens[parser->current - 1];
+        node->line = parser_token(parser, parser->current - 1)->line;
+        node->as.cat_constant_expression.keyword = ast_token(parser, parser_token(parser, parser->current - 1));
         return node;
     }
 
@@ -1905,30 +2581,30 @@ static AstNode* parse_primary(Parser* parser) {
     }
 
     if (match(parser, TYPE)) {
-        Token type_token = parser->tokens[parser->current - 1];
+        Token type_token = *parser_token(parser, parser->current - 1);
         AstNode* node = create_node(parser, AST_LITERAL);
         if (!node) return NULL;
         node->line = type_token.line;
-        node->as.literal.value = type_token;
+        node->as.literal.value = ast_token(parser, &type_token);
         return node;
     }
 
     if (match(parser, PERIOD)) {
-        Token dot_token = parser->tokens[parser->current - 1];
+        Token dot_token = *parser_token(parser, parser->current - 1);
         
         AstNode* this_node = create_node(parser, AST_THIS_EXPRESSION);
         if (!this_node) return NULL;
         this_node->line = dot_token.line;
-        this_node->as.this_expression.keyword = dot_token;
+        this_node->as.this_expression.keyword = ast_token(parser, &dot_token);
 
         Token member_name = *expect(parser, IDENTIFIER, "Expected member name after '.'.");
         
         AstNode* access_node = create_node(parser, AST_MEMBER_ACCESS);
-        if (!access_node) { free_ast(this_node); return NULL; }
+        if (!access_node) return NULL;
 
         access_node->line = member_name.line;
         access_node->as.member_access.object = this_node;
-        access_node->as.member_access.member = member_name;
+        access_node->as.member_access.member = ast_token(parser, &member_name);
         
         return access_node;
     }
@@ -1945,37 +2621,38 @@ static AstNode* parse_primary(Parser* parser) {
         match(parser, CASTBOOLEAN) || match(parser, CASTINTEGER) || match(parser, CASTFLOAT) ||
         match(parser, CASTSTRING) || match(parser, CASTARRAY) || match(parser, CASTHASHTABLE) ||
         match(parser, ASTERISK) || match(parser, CARET) || match(parser, BACKTICK)) {
-        Token operator_token = parser->tokens[parser->current - 1];
+        Token operator_token = *parser_token(parser, parser->current - 1);
         AstNode* right = parse_expression(parser, 12);
         if (!right) return NULL;
         AstNode* node = create_node(parser, AST_UNARY_OP);
-        if (!node) { free_ast(right); return NULL; }
+        if (!node) return NULL;
         node->line = operator_token.line;
-        node->as.unary_op.operator = operator_token;
+        node->as.unary_op.operator = ast_token(parser, &operator_token);
         node->as.unary_op.right = right;
         return node;
     }
     if (match(parser, TIME)) {
         AstNode* node = create_node(parser, AST_TIME_EXPRESSION);
-        node->line = parser->tokens[parser->current - 1].line;
-        node->as.time_expression.keyword = parser->tokens[parser->current - 1];
+        node->line = parser_token(parser, parser->current - 1)->line;
+        node->as.time_expression.keyword = ast_token(parser, parser_token(parser, parser->current - 1));
         return node;
     }
     if (match(parser, STRING) || match(parser, NUMBER) || 
         match(parser, TRUEVALUE) || match(parser, FALSEVALUE) || match(parser, NULLVALUE)) {
-        Token literal_token = parser->tokens[parser->current - 1];
+        Token literal_token = *parser_token(parser, parser->current - 1);
         AstNode* node = create_node(parser, AST_LITERAL);
         if (!node) return NULL;
         node->line = literal_token.line;
-        node->as.literal.value = literal_token;
+        node->as.literal.value = ast_token(parser, &literal_token);
+        decode_literal(parser, node);
         return node;
     }
     if (match(parser, IDENTIFIER)) {
-        Token identifier_token = parser->tokens[parser->current - 1];
+        Token identifier_token = *parser_token(parser, parser->current - 1);
         AstNode* node = create_node(parser, AST_IDENTIFIER);
         if (!node) return NULL;
         node->line = identifier_token.line;
-        node->as.identifier.name = identifier_token;
+        node->as.identifier.name = ast_token(parser, &identifier_token);
         return node;
     }
 
@@ -2022,13 +2699,7 @@ static AstNode* parse_postfix(Parser* parser) {
 
             if (is_slice) {
                 AstNode* slice_node = create_node(parser, AST_SLICE_EXPRESSION);
-                if (!slice_node) {
-                    free_ast(expr);
-                    free_ast(start_expr);
-                    free_ast(stop_expr);
-                    free_ast(step_expr);
-                    return NULL;
-                }
+                if (!slice_node) return NULL;
                 slice_node->line = expr->line;
                 slice_node->as.slice_expression.collection = expr;
                 slice_node->as.slice_expression.start_expr = start_expr;
@@ -2037,11 +2708,7 @@ static AstNode* parse_postfix(Parser* parser) {
                 expr = slice_node;
             } else {
                 AstNode* subscript_node = create_node(parser, AST_SUBSCRIPT);
-                if (!subscript_node) {
-                    free_ast(expr);
-                    free_ast(start_expr);
-                    return NULL;
-                }
+                if (!subscript_node) return NULL;
                 subscript_node->line = expr->line;
                 subscript_node->as.subscript.array = expr;
                 subscript_node->as.subscript.index = start_expr;
@@ -2049,12 +2716,12 @@ static AstNode* parse_postfix(Parser* parser) {
             }
 
         } else if (match(parser, REFERENCE)) {
-            Token op = parser->tokens[parser->current - 1];
+            Token op = *parser_token(parser, parser->current - 1);
             AstNode* key = parse_primary(parser);
             AstNode* lookup_node = create_node(parser, AST_BINARY_OP);
-            if (!lookup_node) { free_ast(expr); free_ast(key); return NULL; }
+            if (!lookup_node) return NULL;
             lookup_node->line = op.line;
-            lookup_node->as.binary_op.operator = op;
+            lookup_node->as.binary_op.operator = ast_token(parser, &op);
             lookup_node->as.binary_op.left = expr;
             lookup_node->as.binary_op.right = key;
             expr = lookup_node;
@@ -2066,11 +2733,11 @@ static AstNode* parse_postfix(Parser* parser) {
             Token member_name = *expect(parser, IDENTIFIER, "Expected member name after '.'.");
             
             AstNode* access_node = create_node(parser, AST_MEMBER_ACCESS);
-            if (!access_node) { free_ast(expr); return NULL; }
+            if (!access_node) return NULL;
 
             access_node->line = member_name.line;
             access_node->as.member_access.object = expr;
-            access_node->as.member_access.member = member_name;
+            access_node->as.member_access.member = ast_token(parser, &member_name);
             
             expr = access_node;
 
@@ -2083,19 +2750,18 @@ static AstNode* parse_postfix(Parser* parser) {
 }
 
 static AstNode* parse_for_statement(Parser* parser) {
-    Token iterator = parser->tokens[parser->current - 2];
+    Token iterator = *parser_token(parser, parser->current - 2);
     AstNode* node = create_node(parser, AST_FOR_STATEMENT);
     node->line = iterator.line;
-    node->as.for_statement.iterator = iterator;
+    node->as.for_statement.iterator = ast_token(parser, &iterator);
     node->as.for_statement.body = NULL;
     
-    node->as.for_statement.range_expressions = malloc(3 * sizeof(AstNode*));
+    node->as.for_statement.range_expressions = parser_alloc(parser, 3 * sizeof(AstNode*));
     node->as.for_statement.range_count = 0;
 
     do {
         if (node->as.for_statement.range_count >= 3) {
             error_at_token(parser, peek(parser), "For loop can have at most 3 range arguments.");
-            free_ast(node);
             return NULL;
         }
         node->as.for_statement.range_expressions[node->as.for_statement.range_count++] = parse_expression(parser, 1);
@@ -2109,7 +2775,7 @@ static AstNode* parse_for_statement(Parser* parser) {
 
 static AstNode* parse_while_statement(Parser* parser) {
     AstNode* node = create_node(parser, AST_WHILE_STATEMENT);
-    node->line = parser->tokens[parser->current - 1].line;
+    node->line = parser_token(parser, parser->current - 1)->line;
     node->as.while_statement.condition = parse_expression(parser, 1);
     expect(parser, LEFTBRACE, "Expected '{' after while condition.");
     node->as.while_statement.body = parse_block(parser);
@@ -2118,15 +2784,15 @@ static AstNode* parse_while_statement(Parser* parser) {
 
 static AstNode* parse_break_statement(Parser* parser) {
     AstNode* node = create_node(parser, AST_BREAK_STATEMENT);
-    node->line = parser->tokens[parser->current - 1].line;
-    node->as.break_statement.keyword = parser->tokens[parser->current - 1];
+    node->line = parser_token(parser, parser->current - 1)->line;
+    node->as.break_statement.keyword = ast_token(parser, parser_token(parser, parser->current - 1));
     return node;
 }
 
 static AstNode* parse_continue_statement(Parser* parser) {
     AstNode* node = create_node(parser, AST_CONTINUE_STATEMENT);
-    node->line = parser->tokens[parser->current - 1].line;
-    node->as.continue_statement.keyword = parser->tokens[parser->current - 1];
+    node->line = parser_token(parser, parser->current - 1)->line;
+    node->as.continue_statement.keyword = ast_token(parser, parser_token(parser, parser->current - 1));
     return node;
 }
 
@@ -2152,8 +2818,7 @@ static AstNode* parse_expression(Parser* parser, int min_precedence) {
                 left->type != AST_STATIC_ACCESS &&
                 left->type != AST_NAMESPACE_ACCESS &&
                 !(left->type == AST_BINARY_OP && left->as.binary_op.operator.type == REFERENCE)) {
-                error_at_token(parser, &parser->tokens[parser->current - 2], "Invalid assignment target.");
-                free_ast(left);
+                error_at_token(parser, parser_token(parser, parser->current - 2), "Invalid assignment target.");
                 return NULL;
             }
 
@@ -2184,17 +2849,17 @@ static AstNode* parse_expression(Parser* parser, int min_precedence) {
         
         Token operator_token = *consume(parser);
         AstNode* right = parse_expression(parser, current_precedence + 1);
-        if (!right) { free_ast(left); return NULL; }
+        if (!right) return NULL;
 
         AstNode* node;
         if (op_type == AND || op_type == OR) {
             node = create_node(parser, AST_LOGICAL_OP);
-            node->as.logical_op.operator = operator_token;
+            node->as.logical_op.operator = ast_token(parser, &operator_token);
             node->as.logical_op.left = left;
             node->as.logical_op.right = right;
         } else {
             node = create_node(parser, AST_BINARY_OP);
-            node->as.binary_op.operator = operator_token;
+            node->as.binary_op.operator = ast_token(parser, &operator_token);
             node->as.binary_op.left = left;
             node->as.binary_op.right = right;
         }
@@ -2206,7 +2871,7 @@ static AstNode* parse_expression(Parser* parser, int min_precedence) {
 }
 
 static AstNode* parse_print_statement(Parser* parser) {
-    int line = parser->tokens[parser->current - 1].line;
+    int line = parser_token(parser, parser->current - 1)->line;
 
     AstNode* node = create_node(parser, AST_PRINT_STATEMENT);
     if (!node) return NULL;
@@ -2214,25 +2879,12 @@ static AstNode* parse_print_statement(Parser* parser) {
 
     node->as.print_stmt.capacity = 4;
     node->as.print_stmt.count = 0;
-    node->as.print_stmt.expressions = malloc(node->as.print_stmt.capacity * sizeof(AstNode*));
-    if (!node->as.print_stmt.expressions) {
-        perror("AST print expressions malloc failed");
-        free(node);
-        parser->had_error = true;
-        return NULL;
-    }
+    node->as.print_stmt.expressions = parser_alloc(parser, node->as.print_stmt.capacity * sizeof(AstNode*));
 
     do {
         if (node->as.print_stmt.count == node->as.print_stmt.capacity) {
             size_t new_capacity = node->as.print_stmt.capacity * 2;
-            AstNode** new_expressions = realloc(node->as.print_stmt.expressions, new_capacity * sizeof(AstNode*));
-            if (!new_expressions) {
-                perror("AST print expressions realloc failed");
-                parser->had_error = true;
-                free_ast(node);
-                return NULL;
-            }
-            node->as.print_stmt.expressions = new_expressions;
+            node->as.print_stmt.expressions = parser_grow(parser, node->as.print_stmt.expressions, node->as.print_stmt.capacity * sizeof(AstNode*), new_capacity * sizeof(AstNode*));
             node->as.print_stmt.capacity = new_capacity;
         }
         
@@ -2244,10 +2896,10 @@ static AstNode* parse_print_statement(Parser* parser) {
 }
 
 static AstNode* parse_scan_statement(Parser* parser) {
-    Token variable = parser->tokens[parser->current - 2];
+    Token variable = *parser_token(parser, parser->current - 2);
     AstNode* node = create_node(parser, AST_SCAN_STATEMENT);
     node->line = variable.line;
-    node->as.scan_statement.variable = variable;
+    node->as.scan_statement.variable = ast_token(parser, &variable);
     node->as.scan_statement.prompt = parse_expression(parser, 1);
     
     return node;
@@ -2255,8 +2907,8 @@ static AstNode* parse_scan_statement(Parser* parser) {
 
 static AstNode* parse_raise_statement(Parser* parser) {
     AstNode* node = create_node(parser, AST_RAISE_STATEMENT);
-    node->line = parser->tokens[parser->current - 1].line;
-    node->as.raise_statement.keyword = parser->tokens[parser->current - 1];
+    node->line = parser_token(parser, parser->current - 1)->line;
+    node->as.raise_statement.keyword = ast_token(parser, parser_token(parser, parser->current - 1));
     node->as.raise_statement.error_expr = parse_expression(parser, 1);
     return node;
 }
@@ -2298,51 +2950,37 @@ static AstNode* parse_compound_assignment(Parser* parser) {
     }
 
     AstNode* left_side = create_node(parser, AST_IDENTIFIER);
-    if (!left_side) {
-        free_ast(right_side);
-        return NULL;
-    }
+    if (!left_side) return NULL;
     left_side->line = identifier.line;
-    left_side->as.identifier.name = identifier;
+    left_side->as.identifier.name = ast_token(parser, &identifier);
     
     AstNode* binary_op_node = create_node(parser, AST_BINARY_OP);
-    if (!binary_op_node) {
-        free_ast(left_side);
-        free_ast(right_side);
-        return NULL;
-    }
+    if (!binary_op_node) return NULL;
     binary_op_node->line = compound_op.line;
 
     GraveyardTokenType base_op_type = get_base_operator(compound_op.type);
     binary_op_node->as.binary_op.operator.type = base_op_type;
     
     switch (base_op_type) {
-        case PLUS:           snprintf(binary_op_node->as.binary_op.operator.lexeme, MAX_LEXEME_LEN, "+"); break;
-        case MINUS:          snprintf(binary_op_node->as.binary_op.operator.lexeme, MAX_LEXEME_LEN, "-"); break;
-        case ASTERISK:       snprintf(binary_op_node->as.binary_op.operator.lexeme, MAX_LEXEME_LEN, "*"); break;
-        case FORWARDSLASH:   snprintf(binary_op_node->as.binary_op.operator.lexeme, MAX_LEXEME_LEN, "/"); break;
-        case EXPONENTIATION: snprintf(binary_op_node->as.binary_op.operator.lexeme, MAX_LEXEME_LEN, "**"); break;
-        case MODULO:         snprintf(binary_op_node->as.binary_op.operator.lexeme, MAX_LEXEME_LEN, "/%%"); break;
-        default:             binary_op_node->as.binary_op.operator.lexeme[0] = '\0'; break;
+        case PLUS:           binary_op_node->as.binary_op.operator.lexeme = "+"; break;
+        case MINUS:          binary_op_node->as.binary_op.operator.lexeme = "-"; break;
+        case ASTERISK:       binary_op_node->as.binary_op.operator.lexeme = "*"; break;
+        case FORWARDSLASH:   binary_op_node->as.binary_op.operator.lexeme = "/"; break;
+        case EXPONENTIATION: binary_op_node->as.binary_op.operator.lexeme = "**"; break;
+        case MODULO:         binary_op_node->as.binary_op.operator.lexeme = "/%"; break;
+        default:             binary_op_node->as.binary_op.operator.lexeme = ""; break;
     }
 
     binary_op_node->as.binary_op.left = left_side;
     binary_op_node->as.binary_op.right = right_side;
 
     AstNode* assignment_target = create_node(parser, AST_IDENTIFIER);
-    if (!assignment_target) {
-        free_ast(binary_op_node);
-        return NULL;
-    }
+    if (!assignment_target) return NULL;
     assignment_target->line = identifier.line;
-    assignment_target->as.identifier.name = identifier;
+    assignment_target->as.identifier.name = ast_token(parser, &identifier);
     
     AstNode* assignment_node = create_node(parser, AST_ASSIGNMENT);
-    if (!assignment_node) {
-        free_ast(binary_op_node);
-        free_ast(assignment_target);
-        return NULL;
-    }
+    if (!assignment_node) return NULL;
     assignment_node->line = identifier.line;
     assignment_node->as.assignment.left = assignment_target;
     assignment_node->as.assignment.value = binary_op_node;
@@ -2357,43 +2995,30 @@ static AstNode* parse_inc_dec_statement(Parser* parser) {
     AstNode* left_side = create_node(parser, AST_IDENTIFIER);
     if (!left_side) return NULL;
     left_side->line = identifier.line;
-    left_side->as.identifier.name = identifier;
+    left_side->as.identifier.name = ast_token(parser, &identifier);
 
     AstNode* right_side = create_node(parser, AST_LITERAL);
-    if (!right_side) {
-        free_ast(left_side);
-        return NULL;
-    }
+    if (!right_side) return NULL;
     right_side->line = op.line;
     right_side->as.literal.value.type = NUMBER;
-    snprintf(right_side->as.literal.value.lexeme, MAX_LEXEME_LEN, "1");
+    right_side->as.literal.value.lexeme = "1";
+    decode_literal(parser, right_side);
 
     AstNode* binary_op_node = create_node(parser, AST_BINARY_OP);
-    if (!binary_op_node) {
-        free_ast(left_side);
-        free_ast(right_side);
-        return NULL;
-    }
+    if (!binary_op_node) return NULL;
     binary_op_node->line = op.line;
     binary_op_node->as.binary_op.operator.type = (op.type == INCREMENT) ? PLUS : MINUS;
-    snprintf(binary_op_node->as.binary_op.operator.lexeme, MAX_LEXEME_LEN, (op.type == INCREMENT) ? "+" : "-");
+    binary_op_node->as.binary_op.operator.lexeme = (op.type == INCREMENT) ? "+" : "-";
     binary_op_node->as.binary_op.left = left_side;
     binary_op_node->as.binary_op.right = right_side;
 
     AstNode* assignment_target = create_node(parser, AST_IDENTIFIER);
-    if (!assignment_target) {
-        free_ast(binary_op_node);
-        return NULL;
-    }
+    if (!assignment_target) return NULL;
     assignment_target->line = identifier.line;
-    assignment_target->as.identifier.name = identifier;
+    assignment_target->as.identifier.name = ast_token(parser, &identifier);
 
     AstNode* assignment_node = create_node(parser, AST_ASSIGNMENT);
-    if (!assignment_node) {
-        free_ast(binary_op_node);
-        free_ast(assignment_target);
-        return NULL;
-    }
+    if (!assignment_node) return NULL;
     assignment_node->line = identifier.line;
     assignment_node->as.assignment.left = assignment_target;
     assignment_node->as.assignment.value = binary_op_node;
@@ -2411,19 +3036,12 @@ static AstNode* parse_if_statement_after_condition(Parser* parser, AstNode* cond
 
     node->as.if_statement.else_if_capacity = 4;
     node->as.if_statement.else_if_count = 0;
-    node->as.if_statement.else_if_clauses = malloc(node->as.if_statement.else_if_capacity * sizeof(AstNodeElseIfClause));
+    node->as.if_statement.else_if_clauses = parser_alloc(parser, node->as.if_statement.else_if_capacity * sizeof(AstNodeElseIfClause));
     
     while (match(parser, COMMA)) {
         if (node->as.if_statement.else_if_count >= node->as.if_statement.else_if_capacity) {
             size_t new_capacity = node->as.if_statement.else_if_capacity * 2;
-            AstNodeElseIfClause* new_clauses = realloc(node->as.if_statement.else_if_clauses, new_capacity * sizeof(AstNodeElseIfClause));
-            if (!new_clauses) {
-                perror("AST if-else clauses realloc failed");
-                free_ast(node);
-                parser->had_error = true;
-                return NULL;
-            }
-            node->as.if_statement.else_if_clauses = new_clauses;
+            node->as.if_statement.else_if_clauses = parser_grow(parser, node->as.if_statement.else_if_clauses, node->as.if_statement.else_if_capacity * sizeof(AstNodeElseIfClause), new_capacity * sizeof(AstNodeElseIfClause));
             node->as.if_statement.else_if_capacity = new_capacity;
         }
         AstNodeElseIfClause* clause = &node->as.if_statement.else_if_clauses[node->as.if_statement.else_if_count++];
@@ -2449,7 +3067,7 @@ static AstNode* parse_type_declaration(Parser* parser) {
     if (!node) return NULL;
     
     node->line = type_name_token.line;
-    node->as.type_declaration.name = type_name_token;
+    node->as.type_declaration.name = ast_token(parser, &type_name_token);
 
     expect(parser, LEFTBRACE, "Expected '{' to begin type body.");
     node->as.type_declaration.body = parse_block(parser);
@@ -2459,14 +3077,14 @@ static AstNode* parse_type_declaration(Parser* parser) {
 
 static AstNode* parse_wait_statement(Parser* parser) {
     AstNode* node = create_node(parser, AST_WAIT_STATEMENT);
-    node->line = parser->tokens[parser->current - 1].line;
+    node->line = parser_token(parser, parser->current - 1)->line;
     node->as.wait_statement.duration_expr = parse_expression(parser, 1);
     return node;
 }
 
 static AstNode* parse_try_except_statement(Parser* parser) {
     AstNode* node = create_node(parser, AST_TRY_EXCEPT_STATEMENT);
-    node->line = parser->tokens[parser->current - 1].line;
+    node->line = parser_token(parser, parser->current - 1)->line;
     node->as.try_except_statement.except_clause = NULL;
     node->as.try_except_statement.finally_block = NULL;
 
@@ -2474,9 +3092,9 @@ static AstNode* parse_try_except_statement(Parser* parser) {
     node->as.try_except_statement.try_block = parse_block(parser);
 
     if (match(parser, COMMA)) {
-        node->as.try_except_statement.except_clause = malloc(sizeof(AstNodeExceptClause));
+        node->as.try_except_statement.except_clause = parser_alloc(parser, sizeof(AstNodeExceptClause));
         expect(parser, PARAMETER, "Expected '&' to introduce error variable in 'except' block.");
-        node->as.try_except_statement.except_clause->error_variable = *expect(parser, IDENTIFIER, "Expected variable name for error.");
+        node->as.try_except_statement.except_clause->error_variable = ast_token(parser, expect(parser, IDENTIFIER, "Expected variable name for error."));
         expect(parser, LEFTBRACE, "Expected '{' to begin 'except' block.");
         node->as.try_except_statement.except_clause->body = parse_block(parser);
     }
@@ -2491,9 +3109,9 @@ static AstNode* parse_try_except_statement(Parser* parser) {
 
 static AstNode* parse_statement(Parser* parser) {
     if (peek(parser)->type == TILDE) {
-        if (parser->tokens[parser->current + 1].type == IDENTIFIER &&
-           (parser->tokens[parser->current + 2].type == SEMICOLON ||
-            parser->tokens[parser->current + 2].type == ASSIGNMENT)) {
+        if (parser_token(parser, parser->current + 1)->type == IDENTIFIER &&
+           (parser_token(parser, parser->current + 2)->type == SEMICOLON ||
+            parser_token(parser, parser->current + 2)->type == ASSIGNMENT)) {
             
             consume(parser);
             Token name = *consume(parser);
@@ -2505,7 +3123,7 @@ static AstNode* parse_statement(Parser* parser) {
             
             AstNode* node = create_node(parser, AST_VAR_DECLARATION);
             node->line = name.line;
-            node->as.var_declaration.name = name;
+            node->as.var_declaration.name = ast_token(parser, &name);
             node->as.var_declaration.initializer = initializer;
             return node;
         } else {
@@ -2522,24 +3140,24 @@ static AstNode* parse_statement(Parser* parser) {
     if (match(parser, RETURN))    return parse_return_statement(parser);
     if (match(parser, PRINT))     return parse_print_statement(parser);
 
-    if (peek(parser)->type == TYPE && parser->tokens[parser->current + 1].type == LEFTBRACE) {
+    if (peek(parser)->type == TYPE && parser_token(parser, parser->current + 1)->type == LEFTBRACE) {
         return parse_type_declaration(parser);
     }
     
     if (peek(parser)->type == NAMESPACE &&
-        parser->tokens[parser->current + 1].type == IDENTIFIER &&
-        parser->tokens[parser->current + 2].type == LEFTBRACE) {
+        parser_token(parser, parser->current + 1)->type == IDENTIFIER &&
+        parser_token(parser, parser->current + 2)->type == LEFTBRACE) {
         consume(parser);
         return parse_namespace_declaration(parser);
     }
     if (peek(parser)->type == NAMESPACE &&
-        parser->tokens[parser->current + 1].type == LEFTBRACE) {
+        parser_token(parser, parser->current + 1)->type == LEFTBRACE) {
         consume(parser);
         error_at_token(parser, peek(parser), "Cannot declare a nested global scope. Use a named namespace instead.");
         return NULL;
     }
     if (match(parser, QUESTIONMARK)) {
-        Token keyword = parser->tokens[parser->current - 1];
+        Token keyword = *parser_token(parser, parser->current - 1);
         
         if (peek(parser)->type == LEFTBRACE) {
             return parse_try_except_statement(parser);
@@ -2550,7 +3168,7 @@ static AstNode* parse_statement(Parser* parser) {
             } else {
                 AstNode* node = create_node(parser, AST_ASSERT_STATEMENT);
                 node->line = keyword.line;
-                node->as.assert_statement.keyword = keyword;
+                node->as.assert_statement.keyword = ast_token(parser, &keyword);
                 node->as.assert_statement.condition = condition;
                 return node;
             }
@@ -2558,7 +3176,7 @@ static AstNode* parse_statement(Parser* parser) {
     }
 
     if (peek(parser)->type == IDENTIFIER) {
-        GraveyardTokenType next_token = parser->tokens[parser->current + 1].type;
+        GraveyardTokenType next_token = parser_token(parser, parser->current + 1)->type;
         
         if (next_token == FILEIN) {
             consume(parser); consume(parser);
@@ -2572,7 +3190,8 @@ static AstNode* parse_statement(Parser* parser) {
             consume(parser); consume(parser);
             return parse_scan_statement(parser);
         }
-        if (next_token == PARAMETER || next_token == LEFTBRACE) {
+        if (next_token == PARAMETER || next_token == LEFTBRACE ||
+            (next_token == REFERENCE && parser_token(parser, parser->current + 2)->type == LEFTBRACE)) {
             Token name = *consume(parser);
             return parse_function_declaration(parser, name);
         }
@@ -2606,17 +3225,17 @@ static AstNode* parse_statement(Parser* parser) {
     }
 
     error_at_token(parser, peek(parser), "Invalid use of expression as a statement.");
-    free_ast(expr);
     return NULL;
 }
 
 bool parse(Graveyard *gy) {
     Parser parser;
     parser.gy = gy;
-    parser.tokens = gy->tokens;
-    parser.token_count = gy->token_count;
+    lexer_init(&parser.lexer, gy);
+    parser.lexed = 0;
     parser.current = 0;
     parser.had_error = false;
+    gy->had_token_error = false;
 
     AstNode* root = create_node(&parser, AST_PROGRAM);
     if (!root) return false;
@@ -2624,13 +3243,7 @@ bool parse(Graveyard *gy) {
 
     root->as.program.capacity = 8;
     root->as.program.count = 0;
-    root->as.program.statements = malloc(root->as.program.capacity * sizeof(AstNode*));
-    if (!root->as.program.statements) {
-        perror("AST statements malloc failed");
-        free(root);
-        parser.had_error = true;
-        return false;
-    }
+    root->as.program.statements = parser_alloc(&parser, root->as.program.capacity * sizeof(AstNode*));
     
     gy->ast_root = root;
 
@@ -2653,13 +3266,7 @@ bool parse(Graveyard *gy) {
 
         if (root->as.program.count == root->as.program.capacity) {
             size_t new_capacity = root->as.program.capacity * 2;
-            AstNode** new_statements = realloc(root->as.program.statements, new_capacity * sizeof(AstNode*));
-            if (!new_statements) {
-                perror("AST statements realloc failed");
-                parser.had_error = true;
-                goto cleanup;
-            }
-            root->as.program.statements = new_statements;
+            root->as.program.statements = parser_grow(&parser, root->as.program.statements, root->as.program.capacity * sizeof(AstNode*), new_capacity * sizeof(AstNode*));
             root->as.program.capacity = new_capacity;
         }
         root->as.program.statements[root->as.program.count++] = statement;
@@ -2667,7 +3274,7 @@ bool parse(Graveyard *gy) {
 
 cleanup:
     if (parser.had_error) {
-        free_ast(gy->ast_root); 
+        ast_arena_free(gy, &gy->ast_arena);
         gy->ast_root = NULL;
     }
     
@@ -2834,7 +3441,7 @@ static void write_ast_node(FILE* file, AstNode* node, int indent) {
         }
 
         case AST_LITERAL: {
-            Token literal_token = node->as.literal.value;
+            AstToken literal_token = node->as.literal.value;
             switch (literal_token.type) {
                 case TYPE:
                     fprintf(file, "(LITERAL_TYPE value=\"");
@@ -2931,7 +3538,7 @@ static void write_ast_node(FILE* file, AstNode* node, int indent) {
             write_escaped_string(file, node->as.function_declaration.name.lexeme);
             fprintf(file, "\" params=\"");
             write_escaped_string(file, params_str);
-            fprintf(file, "\" line=%d\n", node->line);
+            fprintf(file, "\" memoize=%d line=%d\n", node->as.function_declaration.is_memoized ? 1 : 0, node->line);
             
             free(params_str);
             
@@ -3343,8 +3950,12 @@ static bool get_attribute_string(const char* line, const char* key, char* out_bu
     if (*value_start != '"') return false;
     value_start++;
 
-    const char* value_end = strchr(value_start, '"');
-    if (!value_end) return false;
+    const char* value_end = value_start;
+    while (*value_end && *value_end != '"') {
+        if (*value_end == '\\' && value_end[1] != '\0') value_end++;
+        value_end++;
+    }
+    if (*value_end != '"') return false;
 
     size_t len = value_end - value_start;
     
@@ -3362,6 +3973,26 @@ static bool get_attribute_string(const char* line, const char* key, char* out_bu
     return true;
 }
 
+static bool get_lexeme_attribute(Parser* parser, const char* line, const char* key, AstToken* token) {
+    size_t size = strlen(line) + 1;
+    char* lexeme = malloc(size);
+    if (!lexeme) {
+        perror("get_lexeme_attribute: malloc failed");
+        exit(1);
+    }
+    bool found = get_attribute_string(line, key, lexeme, size);
+    if (!found) lexeme[0] = '\0';
+    token->lexeme = intern_cstring(&parser->gy->symbols, lexeme)->chars;
+    free(lexeme);
+    return found;
+}
+
+static bool get_name_attribute(Parser* parser, const char* line, const char* key, AstToken* token) {
+    bool found = get_lexeme_attribute(parser, line, key, token);
+    token->symbol = intern_token_name(&parser->gy->symbols, token->lexeme);
+    return found;
+}
+
 static int get_attribute_int(const char* line, const char* key) {
     const char* key_ptr = strstr(line, key);
     if (!key_ptr) return -1;
@@ -3436,23 +4067,13 @@ static AstNodeType get_node_type_from_string(const char* type_str) {
 
 static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int expected_indent, Parser* dummy_parser_for_node_creation);
 
-bool load_ast_from_file(Graveyard* gy, const char* filename) {
-    long file_size = 0;
-    FILE* file = fopen(filename, "r");
-    if (!file) {
-        perror("load_ast_from_file: Could not open file");
-        return false;
-    }
-    char* buffer = load(file, &file_size);
-    fclose(file);
-    if (!buffer) return false;
-
+static bool load_ast_from_buffer(Graveyard* gy, char* buffer) {
     Lines lines;
     lines.count = 0;
     int capacity = 64; 
     lines.lines = malloc(capacity * sizeof(char*));
     if (!lines.lines) {
-        perror("load_ast_from_file: malloc failed");
+        perror("load_ast_from_buffer: malloc failed");
         free(buffer);
         return false;
     }
@@ -3464,7 +4085,7 @@ bool load_ast_from_file(Graveyard* gy, const char* filename) {
             
             char** temp = realloc(lines.lines, capacity * sizeof(char*));
             if (!temp) {
-                perror("load_ast_from_file: realloc for lines failed");
+                perror("load_ast_from_buffer: realloc for lines failed");
                 free(lines.lines);
                 free(buffer);
                 return false;
@@ -3477,13 +4098,14 @@ bool load_ast_from_file(Graveyard* gy, const char* filename) {
 
     int current_line = 0;
     Parser dummy_parser = {0};
+    dummy_parser.gy = gy;
     gy->ast_root = parse_node_recursive(&lines, &current_line, 0, &dummy_parser);
     
     free(lines.lines);
     free(buffer);
 
     if (dummy_parser.had_error) {
-        free_ast(gy->ast_root);
+        ast_arena_free(gy, &gy->ast_arena);
         gy->ast_root = NULL;
         return false;
     }
@@ -3491,6 +4113,20 @@ bool load_ast_from_file(Graveyard* gy, const char* filename) {
     return gy->ast_root != NULL;
 }
 
+bool load_ast_from_file(Graveyard* gy, const char* filename) {
+    long file_size = 0;
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        perror("load_ast_from_file: Could not open file");
+        return false;
+    }
+    char* buffer = load(file, &file_size);
+    fclose(file);
+    if (!buffer) return false;
+
+    return load_ast_from_buffer(gy, buffer);
+}
+
 static AstNode* parse_optional_expr(Lines* lines, int* idx, int indent, Parser* p) {
     if (*idx < lines->count && strstr(lines->lines[*idx], "(NULL_EXPR)")) {
         (*idx)++;
@@ -3540,22 +4176,13 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
         case AST_PROGRAM: {
             node->as.program.capacity = 8;
             node->as.program.count = 0;
-            node->as.program.statements = malloc(node->as.program.capacity * sizeof(AstNode*));
-            if (!node->as.program.statements) { parser->had_error = true; free(node); return NULL; }
+            node->as.program.statements = parser_alloc(parser, node->as.program.capacity * sizeof(AstNode*));
 
             AstNode* child;
             while ((child = parse_node_recursive(lines, current_line_idx, expected_indent + 1, parser))) {
                 if (node->as.program.count >= node->as.program.capacity) {
                     size_t new_capacity = node->as.program.capacity * 2;
-                    AstNode** temp = realloc(node->as.program.statements, new_capacity * sizeof(AstNode*));
-                    if (!temp) {
-                        perror("AST program statements realloc failed");
-                        parser->had_error = true;
-                        free_ast(child);
-                        free_ast(node);
-                        return NULL;
-                    }
-                    node->as.program.statements = temp;
+                    node->as.program.statements = parser_grow(parser, node->as.program.statements, node->as.program.capacity * sizeof(AstNode*), new_capacity * sizeof(AstNode*));
                     node->as.program.capacity = new_capacity;
                 }
                 node->as.program.statements[node->as.program.count++] = child;
@@ -3566,22 +4193,13 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
         case AST_PRINT_STATEMENT: {
             node->as.print_stmt.capacity = 4;
             node->as.print_stmt.count = 0;
-            node->as.print_stmt.expressions = malloc(node->as.print_stmt.capacity * sizeof(AstNode*));
-            if (!node->as.print_stmt.expressions) { parser->had_error = true; free(node); return NULL; }
+            node->as.print_stmt.expressions = parser_alloc(parser, node->as.print_stmt.capacity * sizeof(AstNode*));
 
             AstNode* child;
             while ((child = parse_node_recursive(lines, current_line_idx, expected_indent + 1, parser))) {
                 if (node->as.print_stmt.count >= node->as.print_stmt.capacity) {
                     size_t new_capacity = node->as.print_stmt.capacity * 2;
-                    AstNode** temp = realloc(node->as.print_stmt.expressions, new_capacity * sizeof(AstNode*));
-                    if (!temp) {
-                        perror("AST print expressions realloc failed");
-                        parser->had_error = true;
-                        free_ast(child);
-                        free_ast(node);
-                        return NULL;
-                    }
-                    node->as.print_stmt.expressions = temp;
+                    node->as.print_stmt.expressions = parser_grow(parser, node->as.print_stmt.expressions, node->as.print_stmt.capacity * sizeof(AstNode*), new_capacity * sizeof(AstNode*));
                     node->as.print_stmt.capacity = new_capacity;
                 }
                 node->as.print_stmt.expressions[node->as.print_stmt.count++] = child;
@@ -3592,22 +4210,13 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
         case AST_ARRAY_LITERAL: {
             node->as.array_literal.capacity = 4;
             node->as.array_literal.count = 0;
-            node->as.array_literal.elements = malloc(node->as.array_literal.capacity * sizeof(AstNode*));
-            if (!node->as.array_literal.elements) { parser->had_error = true; free(node); return NULL; }
+            node->as.array_literal.elements = parser_alloc(parser, node->as.array_literal.capacity * sizeof(AstNode*));
 
             AstNode* child;
             while ((child = parse_node_recursive(lines, current_line_idx, expected_indent + 1, parser))) {
                 if (node->as.array_literal.count >= node->as.array_literal.capacity) {
                     size_t new_capacity = node->as.array_literal.capacity * 2;
-                    AstNode** temp = realloc(node->as.array_literal.elements, new_capacity * sizeof(AstNode*));
-                    if (!temp) {
-                        perror("AST array elements realloc failed");
-                        parser->had_error = true;
-                        free_ast(child);
-                        free_ast(node);
-                        return NULL;
-                    }
-                    node->as.array_literal.elements = temp;
+                    node->as.array_literal.elements = parser_grow(parser, node->as.array_literal.elements, node->as.array_literal.capacity * sizeof(AstNode*), new_capacity * sizeof(AstNode*));
                     node->as.array_literal.capacity = new_capacity;
                 }
                 node->as.array_literal.elements[node->as.array_literal.count++] = child;
@@ -3618,8 +4227,7 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
         case AST_HASHTABLE_LITERAL: {
             node->as.hashtable_literal.capacity = 4;
             node->as.hashtable_literal.count = 0;
-            node->as.hashtable_literal.pairs = malloc(node->as.hashtable_literal.capacity * sizeof(AstNodeKeyValuePair));
-            if (!node->as.hashtable_literal.pairs) { parser->had_error = true; free(node); return NULL; }
+            node->as.hashtable_literal.pairs = parser_alloc(parser, node->as.hashtable_literal.capacity * sizeof(AstNodeKeyValuePair));
 
             while (*current_line_idx < lines->count && get_indent_level(lines->lines[*current_line_idx]) > expected_indent) {
                 const char* pair_line = lines->lines[*current_line_idx];
@@ -3631,14 +4239,7 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
 
                     if (node->as.hashtable_literal.count >= node->as.hashtable_literal.capacity) {
                         size_t new_capacity = node->as.hashtable_literal.capacity * 2;
-                        AstNodeKeyValuePair* temp = realloc(node->as.hashtable_literal.pairs, new_capacity * sizeof(AstNodeKeyValuePair));
-                        if (!temp) {
-                            perror("AST hashtable pairs realloc failed");
-                            parser->had_error = true;
-                            free_ast(node);
-                            return NULL;
-                        }
-                        node->as.hashtable_literal.pairs = temp;
+                        node->as.hashtable_literal.pairs = parser_grow(parser, node->as.hashtable_literal.pairs, node->as.hashtable_literal.capacity * sizeof(AstNodeKeyValuePair), new_capacity * sizeof(AstNodeKeyValuePair));
                         node->as.hashtable_literal.capacity = new_capacity;
                     }
                     
@@ -3658,10 +4259,14 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
         case AST_FORMATTED_STRING: {
             node->as.formatted_string.capacity = 4;
             node->as.formatted_string.count = 0;
-            node->as.formatted_string.parts = malloc(node->as.formatted_string.capacity * sizeof(FmtStringPart));
-            if (!node->as.formatted_string.parts) { parser->had_error = true; free(node); return NULL; }
+            node->as.formatted_string.parts = parser_alloc(parser, node->as.formatted_string.capacity * sizeof(FmtStringPart));
 
             while (*current_line_idx < lines->count && get_indent_level(lines->lines[*current_line_idx]) > expected_indent) {
+                if (node->as.formatted_string.count >= node->as.formatted_string.capacity) {
+                    size_t new_capacity = node->as.formatted_string.capacity * 2;
+                    node->as.formatted_string.parts = parser_grow(parser, node->as.formatted_string.parts, node->as.formatted_string.capacity * sizeof(FmtStringPart), new_capacity * sizeof(FmtStringPart));
+                    node->as.formatted_string.capacity = new_capacity;
+                }
                 const char* part_line = lines->lines[*current_line_idx];
                 char part_type_str[64];
                 get_node_type_from_line(part_line, part_type_str, sizeof(part_type_str));
@@ -3669,7 +4274,7 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
                 FmtStringPart part;
                 if (strcmp(part_type_str, "FORMATTEDPART") == 0) {
                     part.type = FMT_PART_LITERAL;
-                    get_attribute_string(part_line, "value=", part.as.literal.lexeme, MAX_LEXEME_LEN);
+                    get_lexeme_attribute(parser, part_line, "value=", &part.as.literal);
                     part.as.literal.type = FORMATTEDSTRING;
                     node->as.formatted_string.parts[node->as.formatted_string.count++] = part;
                     (*current_line_idx)++;
@@ -3694,8 +4299,8 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
         }
 
         case AST_BINARY_OP: {
-            get_attribute_string(line, "op=", node->as.binary_op.operator.lexeme, MAX_LEXEME_LEN);
-            char* op_str = node->as.binary_op.operator.lexeme;
+            get_lexeme_attribute(parser, line, "op=", &node->as.binary_op.operator);
+            const char* op_str = node->as.binary_op.operator.lexeme;
             size_t op_len = strlen(op_str);
             if (op_len == 3) node->as.binary_op.operator.type = identify_three_char_token(op_str[0], op_str[1], op_str[2]);
             else if (op_len == 2) node->as.binary_op.operator.type = identify_two_char_token(op_str[0], op_str[1]);
@@ -3706,9 +4311,9 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
         }
 
         case AST_LOGICAL_OP: {
-            get_attribute_string(line, "op=", node->as.logical_op.operator.lexeme, MAX_LEXEME_LEN);
+            get_lexeme_attribute(parser, line, "op=", &node->as.logical_op.operator);
             
-            char* op_str = node->as.logical_op.operator.lexeme;
+            const char* op_str = node->as.logical_op.operator.lexeme;
             size_t op_len = strlen(op_str);
             if (op_len == 2) {
                 node->as.logical_op.operator.type = identify_two_char_token(op_str[0], op_str[1]);
@@ -3722,9 +4327,9 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
         }
 
         case AST_UNARY_OP: {
-            get_attribute_string(line, "op=", node->as.unary_op.operator.lexeme, MAX_LEXEME_LEN);
+            get_lexeme_attribute(parser, line, "op=", &node->as.unary_op.operator);
 
-            char* op_str = node->as.unary_op.operator.lexeme;
+            const char* op_str = node->as.unary_op.operator.lexeme;
             size_t op_len = strlen(op_str);
 
             if (op_len == 2) {
@@ -3740,7 +4345,7 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
         }
 
         case AST_LITERAL: {
-            get_attribute_string(line, "value=", node->as.literal.value.lexeme, MAX_LEXEME_LEN);
+            get_lexeme_attribute(parser, line, "value=", &node->as.literal.value);
             if (strcmp(type_str, "LITERAL_STR") == 0) {
                 node->as.literal.value.type = STRING;
             } else if (strcmp(type_str, "LITERAL_NUM") == 0) {
@@ -3752,12 +4357,14 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
                 node->as.literal.value.type = NULLVALUE;
             } else if (strcmp(type_str, "LITERAL_TYPE") == 0) {
                 node->as.literal.value.type = TYPE;
+                node->as.literal.value.symbol = intern_token_name(&parser->gy->symbols, node->as.literal.value.lexeme);
             }
+            decode_literal(parser, node);
             break;
         }
 
         case AST_IDENTIFIER: {
-            get_attribute_string(line, "name=", node->as.identifier.name.lexeme, MAX_LEXEME_LEN);
+            get_name_attribute(parser, line, "name=", &node->as.identifier.name);
             break;
         }
 
@@ -3775,21 +4382,13 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
         case AST_BLOCK: {
             node->as.block.capacity = 8;
             node->as.block.count = 0;
-            node->as.block.statements = malloc(node->as.block.capacity * sizeof(AstNode*));
-            if (!node->as.block.statements) { parser->had_error = true; free(node); return NULL; }
+            node->as.block.statements = parser_alloc(parser, node->as.block.capacity * sizeof(AstNode*));
 
             AstNode* child;
             while ((child = parse_node_recursive(lines, current_line_idx, expected_indent + 1, parser))) {
                 if (node->as.block.count >= node->as.block.capacity) {
                     size_t new_capacity = node->as.block.capacity * 2;
-                    AstNode** new_statements = realloc(node->as.block.statements, new_capacity * sizeof(AstNode*));
-                    if (!new_statements) {
-                        perror("AST block statements realloc failed");
-                        free_ast(node);
-                        parser->had_error = true;
-                        return NULL;
-                    }
-                    node->as.block.statements = new_statements;
+                    node->as.block.statements = parser_grow(parser, node->as.block.statements, node->as.block.capacity * sizeof(AstNode*), new_capacity * sizeof(AstNode*));
                     node->as.block.capacity = new_capacity;
                 }
                 node->as.block.statements[node->as.block.count++] = child;
@@ -3807,20 +4406,18 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
         }
 
         case AST_FUNCTION_DECLARATION: {
-            get_attribute_string(line, "name=", node->as.function_declaration.name.lexeme, MAX_LEXEME_LEN);
+            get_name_attribute(parser, line, "name=", &node->as.function_declaration.name);
             node->as.function_declaration.name.type = IDENTIFIER;
 
             const char* params_attr_start = strstr(line, "params=\"");
             if (!params_attr_start) {
                 parser->had_error = true; 
-                free(node); 
                 return NULL;
             }
             params_attr_start += strlen("params=\"");
             const char* params_attr_end = strchr(params_attr_start, '"');
             if (!params_attr_end) {
                 parser->had_error = true; 
-                free(node); 
                 return NULL;
             }
 
@@ -3829,7 +4426,6 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
             if (!params_buffer) {
                 perror("AST function params malloc failed");
                 parser->had_error = true; 
-                free(node); 
                 return NULL;
             }
             
@@ -3837,35 +4433,20 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
 
             node->as.function_declaration.param_capacity = 4;
             node->as.function_declaration.param_count = 0;
-            node->as.function_declaration.params = malloc(node->as.function_declaration.param_capacity * sizeof(Token));
-            if (!node->as.function_declaration.params) {
-                parser->had_error = true;
-                free(params_buffer);
-                free(node);
-                return NULL;
-            }
+            node->as.function_declaration.params = parser_alloc(parser, node->as.function_declaration.param_capacity * sizeof(AstToken));
 
             char* param_name = strtok(params_buffer, " ");
             while (param_name != NULL) {
                 if (node->as.function_declaration.param_count >= node->as.function_declaration.param_capacity) {
                     size_t new_capacity = node->as.function_declaration.param_capacity * 2;
-                    Token* new_params = realloc(node->as.function_declaration.params, new_capacity * sizeof(Token));
-                    if (!new_params) {
-                        perror("AST function params realloc failed");
-                        parser->had_error = true;
-                        free(params_buffer);
-                        free_ast(node);
-                        return NULL;
-                    }
-                    node->as.function_declaration.params = new_params;
+                    node->as.function_declaration.params = parser_grow(parser, node->as.function_declaration.params, node->as.function_declaration.param_capacity * sizeof(AstToken), new_capacity * sizeof(AstToken));
                     node->as.function_declaration.param_capacity = new_capacity;
                 }
-                Token param_token;
+                AstToken param_token;
                 param_token.type = IDENTIFIER;
                 param_token.line = node->line;
-                param_token.column = 0;
-                strncpy(param_token.lexeme, param_name, MAX_LEXEME_LEN - 1);
-                param_token.lexeme[MAX_LEXEME_LEN - 1] = '\0';
+                param_token.lexeme = intern_cstring(&parser->gy->symbols, param_name)->chars;
+                param_token.symbol = intern_token_name(&parser->gy->symbols, param_token.lexeme);
                 node->as.function_declaration.params[node->as.function_declaration.param_count++] = param_token;
                 
                 param_name = strtok(NULL, " ");
@@ -3873,6 +4454,7 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
             
             free(params_buffer);
 
+            node->as.function_declaration.is_memoized = get_attribute_int(line, "memoize=") == 1;
             node->as.function_declaration.body = parse_node_recursive(lines, current_line_idx, expected_indent + 1, parser);
             break;
         }
@@ -3882,21 +4464,13 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
             
             node->as.call_expression.arg_capacity = 4;
             node->as.call_expression.arg_count = 0;
-            node->as.call_expression.arguments = malloc(node->as.call_expression.arg_capacity * sizeof(AstNode*));
-            if (!node->as.call_expression.arguments) { parser->had_error = true; free_ast(node); return NULL; }
+            node->as.call_expression.arguments = parser_alloc(parser, node->as.call_expression.arg_capacity * sizeof(AstNode*));
 
             AstNode* child;
             while ((child = parse_node_recursive(lines, current_line_idx, expected_indent + 1, parser))) {
                 if (node->as.call_expression.arg_count >= node->as.call_expression.arg_capacity) {
                     size_t new_capacity = node->as.call_expression.arg_capacity * 2;
-                    AstNode** new_args = realloc(node->as.call_expression.arguments, new_capacity * sizeof(AstNode*));
-                    if (!new_args) {
-                        perror("AST call arguments realloc failed");
-                        free_ast(node);
-                        parser->had_error = true;
-                        return NULL;
-                    }
-                    node->as.call_expression.arguments = new_args;
+                    node->as.call_expression.arguments = parser_grow(parser, node->as.call_expression.arguments, node->as.call_expression.arg_capacity * sizeof(AstNode*), new_capacity * sizeof(AstNode*));
                     node->as.call_expression.arg_capacity = new_capacity;
                 }
                 node->as.call_expression.arguments[node->as.call_expression.arg_count++] = child;
@@ -3908,8 +4482,7 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
             node->as.if_statement.else_branch = NULL;
             node->as.if_statement.else_if_capacity = 4;
             node->as.if_statement.else_if_count = 0;
-            node->as.if_statement.else_if_clauses = malloc(node->as.if_statement.else_if_capacity * sizeof(AstNodeElseIfClause));
-            if (!node->as.if_statement.else_if_clauses) { parser->had_error = true; free(node); return NULL; }
+            node->as.if_statement.else_if_clauses = parser_alloc(parser, node->as.if_statement.else_if_capacity * sizeof(AstNodeElseIfClause));
 
             while (*current_line_idx < lines->count && get_indent_level(lines->lines[*current_line_idx]) > expected_indent) {
                 const char* part_line = lines->lines[*current_line_idx];
@@ -3926,14 +4499,7 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
                 } else if (strcmp(part_type_str, "ELSE_IF_CLAUSE") == 0) {
                     if (node->as.if_statement.else_if_count >= node->as.if_statement.else_if_capacity) {
                         size_t new_capacity = node->as.if_statement.else_if_capacity * 2;
-                        AstNodeElseIfClause* temp = realloc(node->as.if_statement.else_if_clauses, new_capacity * sizeof(AstNodeElseIfClause));
-                        if (!temp) {
-                            perror("AST if-else clauses realloc failed");
-                            parser->had_error = true;
-                            free_ast(node);
-                            return NULL;
-                        }
-                        node->as.if_statement.else_if_clauses = temp;
+                        node->as.if_statement.else_if_clauses = parser_grow(parser, node->as.if_statement.else_if_clauses, node->as.if_statement.else_if_capacity * sizeof(AstNodeElseIfClause), new_capacity * sizeof(AstNodeElseIfClause));
                         node->as.if_statement.else_if_capacity = new_capacity;
                     }
                     AstNodeElseIfClause* clause = &node->as.if_statement.else_if_clauses[node->as.if_statement.else_if_count++];
@@ -3965,10 +4531,10 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
         }
 
         case AST_FOR_STATEMENT: {
-            get_attribute_string(line, "iterator=", node->as.for_statement.iterator.lexeme, MAX_LEXEME_LEN);
+            get_name_attribute(parser, line, "iterator=", &node->as.for_statement.iterator);
             size_t range_count = get_attribute_int(line, "range_count=");
             node->as.for_statement.range_count = range_count;
-            node->as.for_statement.range_expressions = malloc(range_count * sizeof(AstNode*));
+            node->as.for_statement.range_expressions = parser_alloc(parser, range_count * sizeof(AstNode*));
 
             for (size_t i = 0; i < range_count; i++) {
                 node->as.for_statement.range_expressions[i] = parse_node_recursive(lines, current_line_idx, expected_indent + 1, parser);
@@ -3978,7 +4544,7 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
         }
 
         case AST_SCAN_STATEMENT: {
-            get_attribute_string(line, "variable=", node->as.scan_statement.variable.lexeme, MAX_LEXEME_LEN);
+            get_name_attribute(parser, line, "variable=", &node->as.scan_statement.variable);
             node->as.scan_statement.prompt = parse_node_recursive(lines, current_line_idx, expected_indent + 1, parser);
             break;
         }
@@ -3989,31 +4555,31 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
         }
 
         case AST_NAMESPACE_DECLARATION: {
-            get_attribute_string(line, "name=", node->as.namespace_declaration.name.lexeme, MAX_LEXEME_LEN);
+            get_name_attribute(parser, line, "name=", &node->as.namespace_declaration.name);
             node->as.namespace_declaration.body = parse_node_recursive(lines, current_line_idx, expected_indent + 1, parser);
             break;
         }
         case AST_NAMESPACE_ACCESS: {
-            get_attribute_string(line, "namespace=", node->as.namespace_access.namespace_name.lexeme, MAX_LEXEME_LEN);
-            get_attribute_string(line, "member=", node->as.namespace_access.member_name.lexeme, MAX_LEXEME_LEN);
+            get_name_attribute(parser, line, "namespace=", &node->as.namespace_access.namespace_name);
+            get_name_attribute(parser, line, "member=", &node->as.namespace_access.member_name);
             break;
         }
 
         case AST_FILEREAD_STATEMENT: {
-            get_attribute_string(line, "variable=", node->as.fileread_statement.variable.lexeme, MAX_LEXEME_LEN);
+            get_name_attribute(parser, line, "variable=", &node->as.fileread_statement.variable);
             node->as.fileread_statement.variable.type = IDENTIFIER;
             node->as.fileread_statement.path_expr = parse_node_recursive(lines, current_line_idx, expected_indent + 1, parser);
             break;
         }
 
         case AST_TYPE_DECLARATION: {
-            get_attribute_string(line, "name=", node->as.type_declaration.name.lexeme, MAX_LEXEME_LEN);
+            get_name_attribute(parser, line, "name=", &node->as.type_declaration.name);
             node->as.type_declaration.body = parse_node_recursive(lines, current_line_idx, expected_indent + 1, parser);
             break;
         }
 
         case AST_MEMBER_ACCESS: {
-            get_attribute_string(line, "member=", node->as.member_access.member.lexeme, MAX_LEXEME_LEN);
+            get_name_attribute(parser, line, "member=", &node->as.member_access.member);
             node->as.member_access.object = parse_node_recursive(lines, current_line_idx, expected_indent + 1, parser);
             break;
         }
@@ -4029,14 +4595,14 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
         }
 
         case AST_GLOBAL_ACCESS: {
-            get_attribute_string(line, "member=", node->as.global_access.member_name.lexeme, MAX_LEXEME_LEN);
+            get_name_attribute(parser, line, "member=", &node->as.global_access.member_name);
             node->as.global_access.member_name.type = IDENTIFIER;
             break;
         }
 
         case AST_STATIC_ACCESS: {
-            get_attribute_string(line, "type=", node->as.static_access.type_name.lexeme, MAX_LEXEME_LEN);
-            get_attribute_string(line, "member=", node->as.static_access.member_name.lexeme, MAX_LEXEME_LEN);
+            get_name_attribute(parser, line, "type=", &node->as.static_access.type_name);
+            get_name_attribute(parser, line, "member=", &node->as.static_access.member_name);
             node->as.static_access.type_name.type = TYPE;
             node->as.static_access.member_name.type = IDENTIFIER;
             break;
@@ -4083,10 +4649,10 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
                 if (strcmp(part_type_str, "TRY_BLOCK") == 0) {
                     node->as.try_except_statement.try_block = parse_node_recursive(lines, current_line_idx, expected_indent + 2, parser);
                 } else if (strcmp(part_type_str, "EXCEPT_CLAUSE") == 0) {
-                    AstNodeExceptClause* clause = malloc(sizeof(AstNodeExceptClause));
-                    if (!clause) { parser->had_error = true; free_ast(node); return NULL; }
+                    AstNodeExceptClause* clause = parser_alloc(parser, sizeof(AstNodeExceptClause));
+                    if (!clause) { parser->had_error = true; return NULL; }
                     
-                    get_attribute_string(part_line, "error_var=", clause->error_variable.lexeme, MAX_LEXEME_LEN);
+                    get_name_attribute(parser, part_line, "error_var=", &clause->error_variable);
                     clause->error_variable.type = IDENTIFIER;
                     clause->body = parse_node_recursive(lines, current_line_idx, expected_indent + 2, parser);
                     node->as.try_except_statement.except_clause = clause;
@@ -4101,7 +4667,7 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
         }
 
         case AST_VAR_DECLARATION: {
-            get_attribute_string(line, "name=", node->as.var_declaration.name.lexeme, MAX_LEXEME_LEN);
+            get_name_attribute(parser, line, "name=", &node->as.var_declaration.name);
             node->as.var_declaration.name.type = IDENTIFIER;
             
             if (*current_line_idx < lines->count && get_indent_level(lines->lines[*current_line_idx]) > expected_indent) {
@@ -4124,7 +4690,7 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
         default: break;
     }
     
-    if (parser->had_error) { free_ast(node); return NULL; }
+    if (parser->had_error) return NULL;
     
     bool is_block_node = false;
     switch(type) {
@@ -4176,13 +4742,11 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
              } else {
                  fprintf(stderr, "AST Deserializer Error [line %d]: Malformed AST. Expected closing ')' for node started on line %d.\n", *current_line_idx + 1, node->line);
                  parser->had_error = true;
-                 free_ast(node);
                  return NULL;
              }
         } else {
             fprintf(stderr, "AST Deserializer Error: Unterminated AST node (reached end of file) for node started on line %d.\n", node->line);
             parser->had_error = true;
-            free_ast(node);
             return NULL;
         }
     }
@@ -4190,2703 +4754,7310 @@ static AstNode* parse_node_recursive(Lines* lines, int* current_line_idx, int ex
     return node;
 }
 
-//EXECUTE-------------------------------------------------------
-void monolith_init(Monolith* monolith) {
-    monolith->count = 0;
-    monolith->capacity = 8;
-    monolith->entries = malloc(monolith->capacity * sizeof(MonolithEntry));
-    if (!monolith->entries) {
-        perror("monolith_init: malloc failed");
+//RESOLVE---------------------------------------------------------------------
+
+typedef struct {
+    ScopeLayout** scopes;
+    int count;
+    int capacity;
+    bool declaring;
+    Symbol* this_symbol;
+    bool allow_tail_calls;
+    AstArena* arena;
+} Resolver;
+
+static ScopeLayout* scope_layout_new() {
+    ScopeLayout* layout = malloc(sizeof(ScopeLayout));
+    if (!layout) {
+        perror("scope_layout_new: malloc failed");
         exit(1);
     }
-    for (int i = 0; i < monolith->capacity; i++) {
-        monolith->entries[i].key = NULL;
+    layout->names = NULL;
+    layout->count = 0;
+    layout->capacity = 0;
+    layout->param_slots = NULL;
+    layout->param_count = 0;
+    return layout;
+}
+
+static void scope_layout_free(ScopeLayout* layout) {
+    if (!layout) return;
+    free(layout->names);
+    free(layout->param_slots);
+    free(layout);
+}
+
+static int scope_layout_find(ScopeLayout* layout, Symbol* name) {
+    for (int i = 0; i < layout->count; i++) {
+        if (layout->names[i] == name) {
+            return i;
+        }
     }
+    return -1;
 }
 
-static void dec_ref(GraveyardValue value);
-static void free_value(GraveyardValue value);
+static int scope_layout_declare(ScopeLayout* layout, Symbol* name) {
+    int slot = scope_layout_find(layout, name);
+    if (slot >= 0) return slot;
 
-void monolith_free(Monolith* monolith) {
-    for (int i = 0; i < monolith->capacity; i++) {
-        MonolithEntry* entry = &monolith->entries[i];
-        if (entry->key != NULL) {
-            // printf("DEBUG: Dec-ref'ing '%s' in monolith.\n", entry->key); // <-- ADD THIS
-            dec_ref(entry->value);
-            free(entry->key);
+    if (layout->count >= layout->capacity) {
+        int new_capacity = layout->capacity < 4 ? 4 : layout->capacity * 2;
+        Symbol** temp = realloc(layout->names, new_capacity * sizeof(Symbol*));
+        if (!temp) {
+            perror("scope_layout_declare: realloc failed");
+            exit(1);
         }
+        layout->names = temp;
+        layout->capacity = new_capacity;
     }
-    free(monolith->entries);
-    monolith->entries = NULL;
-    monolith->count = 0;
-    monolith->capacity = 0;
+    layout->names[layout->count] = name;
+    return layout->count++;
 }
 
-const char* value_type_name(ValueType type) {
-    switch(type) {
-        case VAL_STRING: return "String";
-        case VAL_ARRAY: return "Array";
-        case VAL_HASHTABLE: return "Hashtable";
-        case VAL_FUNCTION: return "Function";
-        case VAL_INSTANCE: return "Instance";
-        case VAL_TYPE: return "Type";
-        case VAL_BOUND_METHOD: return "BoundMethod";
-        default: return "Primitive";
+static void resolver_push(Resolver* resolver, ScopeLayout* layout) {
+    if (resolver->count >= resolver->capacity) {
+        int new_capacity = resolver->capacity < 16 ? 16 : resolver->capacity * 2;
+        ScopeLayout** temp = realloc(resolver->scopes, new_capacity * sizeof(ScopeLayout*));
+        if (!temp) {
+            perror("resolver_push: realloc failed");
+            exit(1);
+        }
+        resolver->scopes = temp;
+        resolver->capacity = new_capacity;
     }
+    resolver->scopes[resolver->count++] = layout;
 }
 
-static void inc_ref(GraveyardValue value) {
-    switch (value.type) {
-        case VAL_STRING:     if (value.as.string) value.as.string->ref_count++;         break;
-        case VAL_ARRAY:      if (value.as.array) value.as.array->ref_count++;           break;
-        case VAL_HASHTABLE:  if (value.as.hashtable) value.as.hashtable->ref_count++;   break;
-        case VAL_FUNCTION:   if (value.as.function) value.as.function->ref_count++;     break;
-        case VAL_TYPE:       if (value.as.type) value.as.type->ref_count++;             break;
-        case VAL_INSTANCE:   if (value.as.instance) value.as.instance->ref_count++;     break;
-        case VAL_BOUND_METHOD: if (value.as.bound_method) value.as.bound_method->ref_count++; break;
-        default:
-            break;
+static void resolver_pop(Resolver* resolver) {
+    resolver->count--;
+}
+
+static ScopeLayout* block_layout(AstNode* block) {
+    if (block->as.block.layout == NULL) {
+        block->as.block.layout = scope_layout_new();
     }
+    return block->as.block.layout;
 }
 
-static GraveyardValue create_type_value_from_ptr(GraveyardType* type) {
-    GraveyardValue val;
-    val.type = VAL_TYPE;
-    val.as.type = type;
-    return val;
+static void resolver_declare(Resolver* resolver, Symbol* name) {
+    if (!resolver->declaring) return;
+    ScopeLayout* current = resolver->scopes[resolver->count - 1];
+    if (current != NULL) {
+        scope_layout_declare(current, name);
+    }
 }
 
-static void free_value(GraveyardValue value) {
-    // printf("FREEING: %-12s at %p\n", value_type_name(value.type), value.as.object);
-    switch (value.type) {
-        case VAL_STRING: {
-            GraveyardString* string = value.as.string;
-            free(string->chars);
-            free(string);
-            break;
+static void resolver_resolve(Resolver* resolver, VariableResolution* resolution, Symbol* name) {
+    if (resolver->declaring) return;
+
+    int depth = 0;
+    while (depth < resolver->count && resolver->scopes[resolver->count - 1 - depth] != NULL) {
+        depth++;
+    }
+
+    resolution->depth = depth;
+    resolution->slots = NULL;
+    if (depth == 0) return;
+
+    resolution->slots = ast_arena_alloc(resolver->arena, depth * sizeof(int));
+    for (int i = 0; i < depth; i++) {
+        resolution->slots[i] = scope_layout_find(resolver->scopes[resolver->count - 1 - i], name);
+    }
+}
+
+static void resolve_node(Resolver* resolver, AstNode* node);
+
+static void resolve_child(AstNode** slot, void* context) {
+    resolve_node((Resolver*)context, *slot);
+}
+
+static void resolve_statements(Resolver* resolver, AstNode* block) {
+    for (size_t i = 0; i < block->as.block.count; i++) {
+        resolve_node(resolver, block->as.block.statements[i]);
+    }
+}
+
+static void resolve_block(Resolver* resolver, AstNode* block) {
+    resolver_push(resolver, block_layout(block));
+    resolve_statements(resolver, block);
+    resolver_pop(resolver);
+}
+
+static void resolve_function(Resolver* resolver, AstNode* node, bool is_method) {
+    AstNode* body = node->as.function_declaration.body;
+    ScopeLayout* layout = block_layout(body);
+    bool enclosing_allow_tail_calls = resolver->allow_tail_calls;
+    resolver->allow_tail_calls = true;
+    resolver_push(resolver, layout);
+
+    if (resolver->declaring) {
+        size_t param_count = node->as.function_declaration.param_count;
+        free(layout->param_slots);
+        layout->param_slots = malloc((param_count > 0 ? param_count : 1) * sizeof(int));
+        if (!layout->param_slots) {
+            perror("resolve_function: malloc failed");
+            exit(1);
         }
-        case VAL_ARRAY: {
-            GraveyardArray* array = value.as.array;
-            if (array->ref_count == -1) return;
-            array->ref_count = -1;
-            for (size_t i = 0; i < array->count; i++) {
-                dec_ref(array->values[i]);
-            }
-            free(array->values);
-            free(array);
-            break;
+        layout->param_count = (int)param_count;
+        for (size_t i = 0; i < param_count; i++) {
+            layout->param_slots[i] = scope_layout_declare(layout, node->as.function_declaration.params[i].symbol);
         }
-        case VAL_HASHTABLE: {
-            GraveyardHashtable* ht = value.as.hashtable;
-            if (ht->ref_count == -1) return;
-            ht->ref_count = -1;
-            for (int i = 0; i < ht->capacity; i++) {
-                if (ht->entries[i].is_in_use) {
-                    dec_ref(ht->entries[i].key);
-                    dec_ref(ht->entries[i].value);
-                }
+        if (is_method) {
+            scope_layout_declare(layout, resolver->this_symbol);
+        }
+    }
+
+    resolve_statements(resolver, body);
+    resolver_pop(resolver);
+    resolver->allow_tail_calls = enclosing_allow_tail_calls;
+}
+
+static void resolve_node(Resolver* resolver, AstNode* node) {
+    if (node == NULL) return;
+
+    switch (node->type) {
+        case AST_PROGRAM:
+            resolver_push(resolver, NULL);
+            ast_visit_children(node, resolve_child, resolver);
+            resolver_pop(resolver);
+            return;
+
+        case AST_IDENTIFIER:
+            resolver_resolve(resolver, &node->as.identifier.resolution, node->as.identifier.name.symbol);
+            return;
+
+        case AST_THIS_EXPRESSION:
+            resolver_resolve(resolver, &node->as.this_expression.resolution, resolver->this_symbol);
+            return;
+
+        case AST_RETURN_STATEMENT:
+            if (node->as.return_statement.value != NULL && node->as.return_statement.value->type == AST_CALL_EXPRESSION) {
+                node->as.return_statement.value->as.call_expression.is_tail_call = resolver->allow_tail_calls;
             }
-            free(ht->entries);
-            free(ht);
             break;
-        }
-        case VAL_FUNCTION: {
-            GraveyardFunction* func = value.as.function;
-            dec_ref(func->name);
-            free(func);
+
+        case AST_ASSIGNMENT:
+            if (node->as.assignment.left->type == AST_IDENTIFIER) {
+                resolver_declare(resolver, node->as.assignment.left->as.identifier.name.symbol);
+            }
             break;
-        }
-        case VAL_TYPE: {
-            GraveyardType* type = value.as.type;
-            dec_ref(type->name);
-            monolith_free(&type->fields);
-            monolith_free(&type->methods);
-            free(type);
+
+        case AST_VAR_DECLARATION:
+            resolver_declare(resolver, node->as.var_declaration.name.symbol);
+            resolver_resolve(resolver, &node->as.var_declaration.resolution, node->as.var_declaration.name.symbol);
             break;
-        }
-        case VAL_INSTANCE: {
-            GraveyardInstance* instance = value.as.instance;
-            dec_ref(create_type_value_from_ptr(instance->type));
-            monolith_free(&instance->fields);
-            free(instance);
+
+        case AST_SCAN_STATEMENT:
+            resolver_declare(resolver, node->as.scan_statement.variable.symbol);
             break;
-        }
-        case VAL_BOUND_METHOD: {
-            GraveyardBoundMethod* bound = value.as.bound_method;
-            dec_ref(bound->receiver);
-            dec_ref(bound->function);
-            free(bound);
+
+        case AST_FILEREAD_STATEMENT:
+            resolver_declare(resolver, node->as.fileread_statement.variable.symbol);
             break;
+
+        case AST_FUNCTION_DECLARATION:
+            resolver_declare(resolver, node->as.function_declaration.name.symbol);
+            resolve_function(resolver, node, false);
+            return;
+
+        case AST_TYPE_DECLARATION: {
+            resolver_declare(resolver, node->as.type_declaration.name.symbol);
+
+            AstNode* body_node = node->as.type_declaration.body;
+            for (size_t i = 0; i < body_node->as.block.count; i++) {
+                AstNode* stmt = body_node->as.block.statements[i];
+                if (stmt->type == AST_FUNCTION_DECLARATION) {
+                    resolve_function(resolver, stmt, true);
+                } else if (stmt->type == AST_EXPRESSION_STATEMENT && stmt->as.expression_statement.expression->type == AST_ASSIGNMENT) {
+                    resolver_push(resolver, NULL);
+                    resolve_node(resolver, stmt->as.expression_statement.expression->as.assignment.value);
+                    resolver_pop(resolver);
+                }
+            }
+            return;
+        }
+
+        case AST_NAMESPACE_DECLARATION: {
+            bool enclosing_allow_tail_calls = resolver->allow_tail_calls;
+            resolver->allow_tail_calls = false;
+            resolver_push(resolver, NULL);
+            resolve_statements(resolver, node->as.namespace_declaration.body);
+            resolver_pop(resolver);
+            resolver->allow_tail_calls = enclosing_allow_tail_calls;
+            return;
+        }
+
+        case AST_IF_STATEMENT:
+            resolve_node(resolver, node->as.if_statement.condition);
+            resolve_block(resolver, node->as.if_statement.then_branch);
+            for (size_t i = 0; i < node->as.if_statement.else_if_count; i++) {
+                resolve_node(resolver, node->as.if_statement.else_if_clauses[i].condition);
+                resolve_block(resolver, node->as.if_statement.else_if_clauses[i].body);
+            }
+            if (node->as.if_statement.else_branch != NULL) {
+                resolve_block(resolver, node->as.if_statement.else_branch);
+            }
+            return;
+
+        case AST_WHILE_STATEMENT:
+            resolve_node(resolver, node->as.while_statement.condition);
+            resolve_block(resolver, node->as.while_statement.body);
+            return;
+
+        case AST_FOR_STATEMENT:
+            for (size_t i = 0; i < node->as.for_statement.range_count; i++) {
+                resolve_node(resolver, node->as.for_statement.range_expressions[i]);
+            }
+            resolver_push(resolver, block_layout(node->as.for_statement.body));
+            resolver_declare(resolver, node->as.for_statement.iterator.symbol);
+            resolve_statements(resolver, node->as.for_statement.body);
+            resolver_pop(resolver);
+            return;
+
+        case AST_BLOCK:
+            resolve_block(resolver, node);
+            return;
+
+        case AST_TRY_EXCEPT_STATEMENT: {
+            AstNodeExceptClause* clause = node->as.try_except_statement.except_clause;
+            bool enclosing_allow_tail_calls = resolver->allow_tail_calls;
+            resolver->allow_tail_calls = false;
+            resolve_node(resolver, node->as.try_except_statement.try_block);
+            if (clause != NULL) {
+                resolver_push(resolver, block_layout(clause->body));
+                resolver_declare(resolver, clause->error_variable.symbol);
+                resolve_statements(resolver, clause->body);
+                resolver_pop(resolver);
+            }
+            resolve_node(resolver, node->as.try_except_statement.finally_block);
+            resolver->allow_tail_calls = enclosing_allow_tail_calls;
+            return;
         }
+
         default:
-            break; 
+            break;
     }
+
+    ast_visit_children(node, resolve_child, resolver);
 }
 
-static void dec_ref(GraveyardValue value) {
-    switch (value.type) {
-        case VAL_STRING:
-            if (value.as.string && --value.as.string->ref_count == 0) free_value(value);
+typedef struct {
+    AstNode* statement;
+} EscapeAnalysis;
+
+static void mark_consumed_value(EscapeAnalysis* analysis, AstNode* node) {
+    if (node == NULL || analysis->statement == NULL) return;
+
+    switch (node->type) {
+        case AST_ARRAY_LITERAL:
+        case AST_HASHTABLE_LITERAL:
+        case AST_FORMATTED_STRING:
+            node->allocates_scratch = true;
             break;
-        case VAL_ARRAY:
-            if (value.as.array && --value.as.array->ref_count == 0) free_value(value);
+        case AST_BINARY_OP:
+            node->allocates_scratch = node->as.binary_op.operator.type == PLUS;
             break;
-        case VAL_HASHTABLE:
-            if (value.as.hashtable && --value.as.hashtable->ref_count == 0) free_value(value);
+        default:
             break;
-        case VAL_FUNCTION:
-            if (value.as.function && --value.as.function->ref_count == 0) free_value(value);
+    }
+}
+
+static bool unary_consumes_operand(GraveyardTokenType op_type) {
+    switch (op_type) {
+        case NOT:
+        case TYPEOF:
+        case ASTERISK:
+        case CARET:
+        case BACKTICK:
+        case CASTBOOLEAN:
+        case CASTINTEGER:
+        case CASTFLOAT:
+        case CASTSTRING:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool binary_consumes_operands(GraveyardTokenType op_type) {
+    switch (op_type) {
+        case REFERENCE:
+        case EQUALITY:
+        case INEQUALITY:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void analyze_escapes(AstNode** slot, void* context) {
+    AstNode* node = *slot;
+    if (node == NULL) return;
+
+    EscapeAnalysis* analysis = context;
+
+    switch (node->type) {
+        case AST_PROGRAM:
+        case AST_BLOCK: {
+            AstNode* enclosing = analysis->statement;
+            size_t count = node->type == AST_PROGRAM ? node->as.program.count : node->as.block.count;
+            AstNode** statements = node->type == AST_PROGRAM ? node->as.program.statements : node->as.block.statements;
+            for (size_t i = 0; i < count; i++) {
+                analysis->statement = statements[i];
+                analyze_escapes(&statements[i], analysis);
+            }
+            analysis->statement = enclosing;
+            return;
+        }
+        case AST_ASSIGNMENT: {
+            AstNode* target = node->as.assignment.left;
+            if (target->type == AST_BINARY_OP || target->type == AST_SUBSCRIPT) {
+                ast_visit_children(target, analyze_escapes, context);
+            } else {
+                analyze_escapes(&node->as.assignment.left, analysis);
+            }
+            analyze_escapes(&node->as.assignment.value, analysis);
+            return;
+        }
+        case AST_PRINT_STATEMENT:
+            for (size_t i = 0; i < node->as.print_stmt.count; i++) {
+                mark_consumed_value(analysis, node->as.print_stmt.expressions[i]);
+            }
             break;
-        case VAL_TYPE:
-             if (value.as.type && --value.as.type->ref_count == 0) free_value(value);
+        case AST_UNARY_OP:
+            if (unary_consumes_operand(node->as.unary_op.operator.type)) {
+                mark_consumed_value(analysis, node->as.unary_op.right);
+            }
             break;
-        case VAL_INSTANCE:
-             if (value.as.instance && --value.as.instance->ref_count == 0) free_value(value);
+        case AST_BINARY_OP:
+            if (binary_consumes_operands(node->as.binary_op.operator.type)) {
+                mark_consumed_value(analysis, node->as.binary_op.left);
+                mark_consumed_value(analysis, node->as.binary_op.right);
+            }
             break;
-        case VAL_BOUND_METHOD:
-             if (value.as.bound_method && --value.as.bound_method->ref_count == 0) free_value(value);
+        case AST_SUBSCRIPT:
+            mark_consumed_value(analysis, node->as.subscript.array);
+            break;
+        case AST_FORMATTED_STRING:
+            for (size_t i = 0; i < node->as.formatted_string.count; i++) {
+                if (node->as.formatted_string.parts[i].type == FMT_PART_EXPRESSION) {
+                    mark_consumed_value(analysis, node->as.formatted_string.parts[i].as.expression);
+                }
+            }
+            break;
+        case AST_IF_STATEMENT:
+            mark_consumed_value(analysis, node->as.if_statement.condition);
+            for (size_t i = 0; i < node->as.if_statement.else_if_count; i++) {
+                mark_consumed_value(analysis, node->as.if_statement.else_if_clauses[i].condition);
+            }
+            break;
+        case AST_TERNARY_EXPRESSION:
+            mark_consumed_value(analysis, node->as.ternary_expression.condition);
+            break;
+        case AST_ASSERT_STATEMENT:
+            mark_consumed_value(analysis, node->as.assert_statement.condition);
+            break;
+        case AST_WHILE_STATEMENT: {
+            AstNode* enclosing = analysis->statement;
+            analysis->statement = NULL;
+            analyze_escapes(&node->as.while_statement.condition, analysis);
+            analysis->statement = enclosing;
+            analyze_escapes(&node->as.while_statement.body, analysis);
+            return;
+        }
+        case AST_FOR_STATEMENT:
+            if (node->as.for_statement.range_count == 1) {
+                mark_consumed_value(analysis, node->as.for_statement.range_expressions[0]);
+            }
             break;
         default:
             break;
     }
-}
 
-static void runtime_error(Graveyard* gy, int line, const char* format, ...) {
-    va_list args;
-    va_start(args, format);
-    vsnprintf(gy->error_message, sizeof(gy->error_message), format, args);
-    va_end(args);
-    
-    gy->error_line = line;
-    gy->had_runtime_error = true;
+    if (node->allocates_scratch && analysis->statement != NULL) {
+        analysis->statement->releases_scratch = true;
+    }
+
+    ast_visit_children(node, analyze_escapes, context);
 }
 
-static char* generate_random_hex_string(int length) {
-    if (length <= 0) return NULL;
+static void bind_node_handlers(AstNode** slot, void* context);
 
-    int num_bytes = (length + 1) / 2;
-    unsigned char* random_bytes = malloc(num_bytes);
-    if (!random_bytes) return NULL;
+bool resolve(Graveyard* gy) {
+    if (!gy || !gy->ast_root) return false;
 
-#ifdef _WIN32
-    HCRYPTPROV hCryptProv;
-    if (!CryptAcquireContext(&hCryptProv, NULL, NULL, PROV_RSA_FULL, CRYPT_VERIFYCONTEXT)) {
-        free(random_bytes);
-        return NULL;
-    }
-    if (!CryptGenRandom(hCryptProv, num_bytes, random_bytes)) {
-        CryptReleaseContext(hCryptProv, 0);
-        free(random_bytes);
-        return NULL;
+    Resolver resolver = { NULL, 0, 0, true, gy->this_symbol, false, &gy->ast_arena };
+    resolve_node(&resolver, gy->ast_root);
+    resolver.declaring = false;
+    resolve_node(&resolver, gy->ast_root);
+    free(resolver.scopes);
+    EscapeAnalysis escapes = { NULL };
+    analyze_escapes(&gy->ast_root, &escapes);
+    bind_node_handlers(&gy->ast_root, NULL);
+
+    return true;
+}
+
+//EXECUTE-------------------------------------------------------
+static void slab_allocator_init(SlabAllocator* slabs) {
+    memset(slabs, 0, sizeof(SlabAllocator));
+}
+
+static void slab_allocator_free(SlabAllocator* slabs) {
+    SlabChunk* chunk = slabs->chunks;
+    while (chunk != NULL) {
+        SlabChunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
     }
-    CryptReleaseContext(hCryptProv, 0);
-#else
-    FILE* urandom = fopen("/dev/urandom", "r");
-    if (!urandom) {
-        free(random_bytes);
-        return NULL;
+    SlabLarge* large = slabs->large;
+    while (large != NULL) {
+        SlabLarge* next = large->next;
+        free(large);
+        large = next;
     }
-    fread(random_bytes, 1, num_bytes, urandom);
-    fclose(urandom);
-#endif
+    slab_allocator_init(slabs);
+}
 
-    char* hex_string = malloc(length + 1);
-    if (!hex_string) {
-        free(random_bytes);
-        return NULL;
-    }
+static size_t slab_rounded_size(size_t size) {
+    if (size > SLAB_MAX_SIZE) return size;
+    return (size + SLAB_GRANULE - 1) & ~(size_t)(SLAB_GRANULE - 1);
+}
 
-    for (int i = 0; i < num_bytes; i++) {
-        sprintf(hex_string + (i * 2), "%02x", random_bytes[i]);
+static void* slab_alloc(SlabAllocator* slabs, SlabKind kind, size_t size) {
+    void* memory;
+
+    if (size > SLAB_MAX_SIZE) {
+        SlabLarge* large = malloc(sizeof(SlabLarge) + size);
+        if (!large) {
+            perror("slab_alloc: malloc failed");
+            exit(1);
+        }
+        large->prev = NULL;
+        large->next = slabs->large;
+        if (slabs->large != NULL) slabs->large->prev = large;
+        slabs->large = large;
+        memory = large + 1;
+    } else {
+        size_t rounded = slab_rounded_size(size);
+        SlabClass* slab_class = &slabs->classes[rounded / SLAB_GRANULE - 1];
+        if (slab_class->free_list != NULL) {
+            memory = slab_class->free_list;
+            slab_class->free_list = slab_class->free_list->next;
+        } else {
+            if (slab_class->cursor == NULL || slab_class->cursor + rounded > slab_class->limit) {
+                SlabChunk* chunk = malloc(sizeof(SlabChunk) + SLAB_CHUNK_SIZE);
+                if (!chunk) {
+                    perror("slab_alloc: chunk malloc failed");
+                    exit(1);
+                }
+                chunk->next = slabs->chunks;
+                slabs->chunks = chunk;
+                slabs->reserved_bytes += SLAB_CHUNK_SIZE;
+                slab_class->cursor = chunk->data;
+                slab_class->limit = chunk->data + SLAB_CHUNK_SIZE;
+            }
+            memory = slab_class->cursor;
+            slab_class->cursor += rounded;
+        }
     }
-    hex_string[length] = '\0';
-    
-    free(random_bytes);
-    return hex_string;
-}
 
-static Environment* get_global_environment(Graveyard* gy) {
-    Environment* env = gy->environment;
-    while (env->enclosing != NULL) {
-        env = env->enclosing;
+    slabs->live_objects[kind]++;
+    slabs->live_bytes[kind] += slab_rounded_size(size);
+    if (slabs->live_bytes[kind] > slabs->peak_bytes[kind]) {
+        slabs->peak_bytes[kind] = slabs->live_bytes[kind];
     }
-    return env;
+    return memory;
 }
 
-static bool are_values_equal(GraveyardValue a, GraveyardValue b) {
-    if (a.type != b.type) {
-        return false;
-    }
+static void slab_free(SlabAllocator* slabs, SlabKind kind, void* memory, size_t size) {
+    slabs->live_objects[kind]--;
+    slabs->live_bytes[kind] -= slab_rounded_size(size);
 
-    switch (a.type) {
-        case VAL_NULL:   return true;
-        case VAL_BOOL:   return a.as.boolean == b.as.boolean;
-        case VAL_NUMBER: return a.as.number == b.as.number;
-        case VAL_STRING:
-            return a.as.string->length == b.as.string->length && strcmp(a.as.string->chars, b.as.string->chars) == 0;
-        case VAL_ARRAY: return a.as.array == b.as.array;
-        default:
-            return false;
+    if (size > SLAB_MAX_SIZE) {
+        SlabLarge* large = (SlabLarge*)memory - 1;
+        if (large->prev != NULL) {
+            large->prev->next = large->next;
+        } else {
+            slabs->large = large->next;
+        }
+        if (large->next != NULL) large->next->prev = large->prev;
+        free(large);
+        return;
     }
+
+    SlabClass* slab_class = &slabs->classes[slab_rounded_size(size) / SLAB_GRANULE - 1];
+    SlabFreeNode* node = memory;
+    node->next = slab_class->free_list;
+    slab_class->free_list = node;
 }
 
-static uint32_t hash_string(const char* key, int length) {
-    uint32_t hash = 5381;
-    for (int i = 0; i < length; i++) {
-        hash = ((hash << 5) + hash) + key[i];
+void monolith_init(Monolith* monolith) {
+    monolith->count = 0;
+    monolith->capacity = 8;
+    monolith->entries = malloc(monolith->capacity * sizeof(MonolithEntry));
+    if (!monolith->entries) {
+        perror("monolith_init: malloc failed");
+        exit(1);
+    }
+    for (int i = 0; i < monolith->capacity; i++) {
+        monolith->entries[i].key = NULL;
     }
-    return hash;
 }
-static uint32_t hash_graveyard_value(GraveyardValue value);
 
-static GraveyardValue create_hashtable_value() {
-    GraveyardValue val;
-    val.type = VAL_HASHTABLE;
-    GraveyardHashtable* ht = malloc(sizeof(GraveyardHashtable));
-    ht->count = 0;
-    ht->capacity = 8;
-    ht->ref_count = 1;
-    ht->entries = malloc(ht->capacity * sizeof(HashtableEntry));
-    for (int i = 0; i < ht->capacity; i++) {
-        ht->entries[i].is_in_use = false;
-        ht->entries[i].key.type = VAL_NULL;
+static void dec_ref(Graveyard* gy, GraveyardValue value);
+static void free_value(Graveyard* gy, GraveyardValue value);
+static void gc_note_allocation(Graveyard* gy);
+
+void monolith_free(Graveyard* gy, Monolith* monolith) {
+    for (int i = 0; i < monolith->capacity; i++) {
+        MonolithEntry* entry = &monolith->entries[i];
+        if (entry->key != NULL) {
+            // printf("DEBUG: Dec-ref'ing '%s' in monolith.\n", entry->key->chars); // <-- ADD THIS
+            dec_ref(gy, entry->value);
+        }
     }
-    val.as.hashtable = ht;
-    return val;
+    free(monolith->entries);
+    monolith->entries = NULL;
+    monolith->count = 0;
+    monolith->capacity = 0;
 }
 
-static uint32_t hash_graveyard_value(GraveyardValue value) {
-    switch (value.type) {
+const char* value_type_name(ValueType type) {
+    switch(type) {
+        case VAL_STRING: return "String";
+        case VAL_ARRAY: return "Array";
+        case VAL_HASHTABLE: return "Hashtable";
+        case VAL_FUNCTION: return "Function";
+        case VAL_INSTANCE: return "Instance";
+        case VAL_TYPE: return "Type";
+        case VAL_BOUND_METHOD: return "BoundMethod";
+        default: return "Primitive";
+    }
+}
+
+static void inc_ref(GraveyardValue value) {
+    switch (VALUE_TYPE(value)) {
+        case VAL_STRING:     if (AS_STRING(value)) AS_STRING(value)->ref_count++;         break;
+        case VAL_ARRAY:      if (AS_ARRAY(value)) AS_ARRAY(value)->ref_count++;           break;
+        case VAL_HASHTABLE:  if (AS_HASHTABLE(value)) AS_HASHTABLE(value)->ref_count++;   break;
+        case VAL_FUNCTION:   if (AS_FUNCTION(value)) AS_FUNCTION(value)->ref_count++;     break;
+        case VAL_TYPE:       if (AS_TYPE(value)) AS_TYPE(value)->ref_count++;             break;
+        case VAL_INSTANCE:   if (AS_INSTANCE(value)) AS_INSTANCE(value)->ref_count++;     break;
+        case VAL_BOUND_METHOD: if (AS_BOUND_METHOD(value)) AS_BOUND_METHOD(value)->ref_count++; break;
+        default:
+            break;
+    }
+}
+
+static GraveyardValue create_type_value_from_ptr(GraveyardType* type) {
+    return OBJECT_VALUE(VAL_TYPE, type);
+}
+
+static void free_container_memory(Graveyard* gy, GraveyardValue value) {
+    switch (VALUE_TYPE(value)) {
+        case VAL_ARRAY:
+            free(AS_ARRAY(value)->values);
+            slab_free(&gy->slabs, SLAB_ARRAY, AS_ARRAY(value), sizeof(GraveyardArray));
+            break;
+        case VAL_HASHTABLE:
+            free(AS_HASHTABLE(value)->entries);
+            slab_free(&gy->slabs, SLAB_HASHTABLE, AS_HASHTABLE(value), sizeof(GraveyardHashtable));
+            break;
+        case VAL_INSTANCE:
+            free(AS_INSTANCE(value)->fields);
+            slab_free(&gy->slabs, SLAB_INSTANCE, AS_INSTANCE(value), sizeof(GraveyardInstance));
+            break;
+        case VAL_BOUND_METHOD:
+            slab_free(&gy->slabs, SLAB_BOUND_METHOD, AS_BOUND_METHOD(value), sizeof(GraveyardBoundMethod));
+            break;
+        default:
+            break;
+    }
+}
+
+static void free_value(Graveyard* gy, GraveyardValue value) {
+    // printf("FREEING: %-12s at %p\n", value_type_name(VALUE_TYPE(value)), AS_OBJECT(value));
+    switch (VALUE_TYPE(value)) {
+        case VAL_STRING: {
+            GraveyardString* string = AS_STRING(value);
+            if (string->is_scratch) return;
+            slab_free(&gy->slabs, SLAB_STRING, string, sizeof(GraveyardString) + string->length + 1);
+            break;
+        }
+        case VAL_ARRAY: {
+            GraveyardArray* array = AS_ARRAY(value);
+            if (array->ref_count == -1) return;
+            array->ref_count = -1;
+            for (size_t i = 0; i < array->count; i++) {
+                dec_ref(gy, array->values[i]);
+            }
+            if (array->is_scratch) return;
+            if (array->gc.buffered) {
+                array->gc.color = GC_BLACK;
+                return;
+            }
+            free_container_memory(gy, value);
+            break;
+        }
+        case VAL_HASHTABLE: {
+            GraveyardHashtable* ht = AS_HASHTABLE(value);
+            if (ht->ref_count == -1) return;
+            ht->ref_count = -1;
+            for (int i = 0; i < ht->capacity; i++) {
+                if (ht->entries[i].is_in_use) {
+                    dec_ref(gy, ht->entries[i].key);
+                    dec_ref(gy, ht->entries[i].value);
+                }
+            }
+            if (ht->is_scratch) return;
+            if (ht->gc.buffered) {
+                ht->gc.color = GC_BLACK;
+                return;
+            }
+            free_container_memory(gy, value);
+            break;
+        }
+        case VAL_FUNCTION: {
+            GraveyardFunction* func = AS_FUNCTION(value);
+            dec_ref(gy, func->name);
+            memo_cache_free(gy, func->memo);
+            free(func);
+            break;
+        }
+        case VAL_TYPE: {
+            GraveyardType* type = AS_TYPE(value);
+            dec_ref(gy, type->name);
+            monolith_free(gy, &type->fields);
+            monolith_free(gy, &type->methods);
+            free(type);
+            break;
+        }
+        case VAL_INSTANCE: {
+            GraveyardInstance* instance = AS_INSTANCE(value);
+            dec_ref(gy, create_type_value_from_ptr(instance->type));
+            for (int i = 0; i < instance->shape->count; i++) {
+                dec_ref(gy, instance->fields[i]);
+            }
+            if (instance->gc.buffered) {
+                instance->gc.color = GC_BLACK;
+                return;
+            }
+            free_container_memory(gy, value);
+            break;
+        }
+        case VAL_BOUND_METHOD: {
+            GraveyardBoundMethod* bound = AS_BOUND_METHOD(value);
+            dec_ref(gy, bound->receiver);
+            dec_ref(gy, bound->function);
+            if (bound->gc.buffered) {
+                bound->gc.color = GC_BLACK;
+                return;
+            }
+            free_container_memory(gy, value);
+            break;
+        }
+        default:
+            break; 
+    }
+}
+
+static void gc_stack_push(GcStack* stack, GraveyardValue value) {
+    if (stack->count >= stack->capacity) {
+        size_t new_capacity = stack->capacity < 64 ? 64 : stack->capacity * 2;
+        GraveyardValue* new_values = realloc(stack->values, new_capacity * sizeof(GraveyardValue));
+        if (!new_values) {
+            perror("gc_stack_push: realloc failed");
+            exit(1);
+        }
+        stack->values = new_values;
+        stack->capacity = new_capacity;
+    }
+    stack->values[stack->count++] = value;
+}
+
+static void gc_possible_root(Graveyard* gy, GraveyardValue value, GcHeader* header) {
+    if (header->color == GC_PURPLE || header->color == GC_GREEN) return;
+    header->color = GC_PURPLE;
+    if (!header->buffered) {
+        header->buffered = true;
+        gc_stack_push(&gy->cycle_collector.roots, value);
+        if (gy->cycle_collector.roots.count >= GC_ROOT_THRESHOLD) {
+            gy->cycle_collector.pending = true;
+        }
+    }
+}
+
+static void dec_ref(Graveyard* gy, GraveyardValue value) {
+    switch (VALUE_TYPE(value)) {
         case VAL_STRING:
-            return hash_string(value.as.string->chars, value.as.string->length);
-        case VAL_NUMBER:
-            return (uint32_t)value.as.number;
-        case VAL_BOOL:
-            return value.as.boolean ? 1 : 0;
-        case VAL_NULL:
-            return 2;
+            if (AS_STRING(value) && --AS_STRING(value)->ref_count == 0) free_value(gy, value);
+            break;
+        case VAL_ARRAY:
+            if (!AS_ARRAY(value)) break;
+            if (--AS_ARRAY(value)->ref_count == 0) free_value(gy, value);
+            else if (AS_ARRAY(value)->ref_count > 0) gc_possible_root(gy, value, &AS_ARRAY(value)->gc);
+            break;
+        case VAL_HASHTABLE:
+            if (!AS_HASHTABLE(value)) break;
+            if (--AS_HASHTABLE(value)->ref_count == 0) free_value(gy, value);
+            else if (AS_HASHTABLE(value)->ref_count > 0) gc_possible_root(gy, value, &AS_HASHTABLE(value)->gc);
+            break;
+        case VAL_FUNCTION:
+            if (AS_FUNCTION(value) && --AS_FUNCTION(value)->ref_count == 0) free_value(gy, value);
+            break;
+        case VAL_TYPE:
+             if (AS_TYPE(value) && --AS_TYPE(value)->ref_count == 0) free_value(gy, value);
+            break;
+        case VAL_INSTANCE:
+            if (!AS_INSTANCE(value)) break;
+            if (--AS_INSTANCE(value)->ref_count == 0) free_value(gy, value);
+            else if (AS_INSTANCE(value)->ref_count > 0) gc_possible_root(gy, value, &AS_INSTANCE(value)->gc);
+            break;
+        case VAL_BOUND_METHOD:
+            if (!AS_BOUND_METHOD(value)) break;
+            if (--AS_BOUND_METHOD(value)->ref_count == 0) free_value(gy, value);
+            else if (AS_BOUND_METHOD(value)->ref_count > 0) gc_possible_root(gy, value, &AS_BOUND_METHOD(value)->gc);
+            break;
         default:
-            return 0;
+            break;
+    }
+}
+
+static GcHeader* gc_header(GraveyardValue value) {
+    switch (VALUE_TYPE(value)) {
+        case VAL_ARRAY:        return AS_ARRAY(value) ? &AS_ARRAY(value)->gc : NULL;
+        case VAL_HASHTABLE:    return AS_HASHTABLE(value) ? &AS_HASHTABLE(value)->gc : NULL;
+        case VAL_INSTANCE:     return AS_INSTANCE(value) ? &AS_INSTANCE(value)->gc : NULL;
+        case VAL_BOUND_METHOD: return AS_BOUND_METHOD(value) ? &AS_BOUND_METHOD(value)->gc : NULL;
+        default:               return NULL;
+    }
+}
+
+static int* gc_ref_count(GraveyardValue value) {
+    switch (VALUE_TYPE(value)) {
+        case VAL_ARRAY:        return &AS_ARRAY(value)->ref_count;
+        case VAL_HASHTABLE:    return &AS_HASHTABLE(value)->ref_count;
+        case VAL_INSTANCE:     return &AS_INSTANCE(value)->ref_count;
+        default:               return &AS_BOUND_METHOD(value)->ref_count;
+    }
+}
+
+typedef void (*GcVisitor)(GraveyardValue child, void* context);
+
+static void gc_visit_children(GraveyardValue value, GcVisitor visit, void* context) {
+    switch (VALUE_TYPE(value)) {
+        case VAL_ARRAY: {
+            GraveyardArray* array = AS_ARRAY(value);
+            for (size_t i = 0; i < array->count; i++) {
+                visit(array->values[i], context);
+            }
+            break;
+        }
+        case VAL_HASHTABLE: {
+            GraveyardHashtable* ht = AS_HASHTABLE(value);
+            for (int i = 0; i < ht->capacity; i++) {
+                if (ht->entries[i].is_in_use) {
+                    visit(ht->entries[i].key, context);
+                    visit(ht->entries[i].value, context);
+                }
+            }
+            break;
+        }
+        case VAL_INSTANCE: {
+            GraveyardInstance* instance = AS_INSTANCE(value);
+            visit(create_type_value_from_ptr(instance->type), context);
+            for (int i = 0; i < instance->shape->count; i++) {
+                visit(instance->fields[i], context);
+            }
+            break;
+        }
+        case VAL_BOUND_METHOD:
+            visit(AS_BOUND_METHOD(value)->receiver, context);
+            visit(AS_BOUND_METHOD(value)->function, context);
+            break;
+        default:
+            break;
+    }
+}
+
+static void gc_mark_gray_child(GraveyardValue child, void* context) {
+    GcHeader* header = gc_header(child);
+    if (header == NULL || header->color == GC_GREEN) return;
+    (*gc_ref_count(child))--;
+    gc_stack_push(context, child);
+}
+
+static void gc_mark_gray(GraveyardValue root, GcStack* stack) {
+    gc_stack_push(stack, root);
+    while (stack->count > 0) {
+        GraveyardValue value = stack->values[--stack->count];
+        GcHeader* header = gc_header(value);
+        if (header->color == GC_GRAY) continue;
+        header->color = GC_GRAY;
+        gc_visit_children(value, gc_mark_gray_child, stack);
+    }
+}
+
+static void gc_scan_black_child(GraveyardValue child, void* context) {
+    GcHeader* header = gc_header(child);
+    if (header == NULL || header->color == GC_GREEN) return;
+    (*gc_ref_count(child))++;
+    if (header->color != GC_BLACK) {
+        header->color = GC_BLACK;
+        gc_stack_push(context, child);
+    }
+}
+
+static void gc_scan_black(GraveyardValue value, GcStack* stack) {
+    size_t base = stack->count;
+    gc_header(value)->color = GC_BLACK;
+    gc_stack_push(stack, value);
+    while (stack->count > base) {
+        GraveyardValue current = stack->values[--stack->count];
+        gc_visit_children(current, gc_scan_black_child, stack);
+    }
+}
+
+static void gc_push_container(GraveyardValue child, void* context) {
+    GcHeader* header = gc_header(child);
+    if (header != NULL && header->color != GC_GREEN) {
+        gc_stack_push(context, child);
+    }
+}
+
+static void gc_scan(GraveyardValue root, GcStack* stack) {
+    gc_stack_push(stack, root);
+    while (stack->count > 0) {
+        GraveyardValue value = stack->values[--stack->count];
+        GcHeader* header = gc_header(value);
+        if (header->color != GC_GRAY) continue;
+        if (*gc_ref_count(value) > 0) {
+            gc_scan_black(value, stack);
+        } else {
+            header->color = GC_WHITE;
+            gc_visit_children(value, gc_push_container, stack);
+        }
+    }
+}
+
+static void gc_collect_white(GraveyardValue root, GcStack* stack, GcStack* garbage) {
+    gc_stack_push(stack, root);
+    while (stack->count > 0) {
+        GraveyardValue value = stack->values[--stack->count];
+        GcHeader* header = gc_header(value);
+        if (header->color != GC_WHITE || header->buffered) continue;
+        header->color = GC_COLLECTING;
+        gc_stack_push(garbage, value);
+        gc_visit_children(value, gc_push_container, stack);
+    }
+}
+
+static void gc_release_child(GraveyardValue child, void* context) {
+    GcHeader* header = gc_header(child);
+    if (header != NULL && header->color == GC_COLLECTING) return;
+    dec_ref((Graveyard*)context, child);
+}
+
+static void cycle_collect(Graveyard* gy) {
+    CycleCollector* collector = &gy->cycle_collector;
+    struct timespec start, end;
+    timespec_get(&start, TIME_UTC);
+
+    GcStack roots = collector->roots;
+    collector->roots = (GcStack){ NULL, 0, 0 };
+    collector->pending = false;
+    collector->allocations = 0;
+
+    GcStack stack = { NULL, 0, 0 };
+    GcStack garbage = { NULL, 0, 0 };
+    size_t candidate_count = 0;
+
+    for (size_t i = 0; i < roots.count; i++) {
+        GraveyardValue root = roots.values[i];
+        GcHeader* header = gc_header(root);
+        if (header->color == GC_PURPLE && *gc_ref_count(root) > 0) {
+            gc_mark_gray(root, &stack);
+            roots.values[candidate_count++] = root;
+        } else {
+            header->buffered = false;
+            if (header->color == GC_BLACK && *gc_ref_count(root) <= 0) {
+                free_container_memory(gy, root);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < candidate_count; i++) {
+        gc_scan(roots.values[i], &stack);
+    }
+
+    for (size_t i = 0; i < candidate_count; i++) {
+        gc_header(roots.values[i])->buffered = false;
+    }
+    for (size_t i = 0; i < candidate_count; i++) {
+        gc_collect_white(roots.values[i], &stack, &garbage);
+    }
+
+    for (size_t i = 0; i < garbage.count; i++) {
+        gc_visit_children(garbage.values[i], gc_release_child, gy);
+    }
+    for (size_t i = 0; i < garbage.count; i++) {
+        free_container_memory(gy, garbage.values[i]);
+    }
+
+    collector->collections++;
+    collector->freed_objects += garbage.count;
+
+    free(roots.values);
+    free(stack.values);
+    free(garbage.values);
+
+    timespec_get(&end, TIME_UTC);
+    double pause = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+    collector->total_pause += pause;
+    if (pause > collector->max_pause) collector->max_pause = pause;
+}
+
+static void gc_note_allocation(Graveyard* gy) {
+    if (++gy->cycle_collector.allocations >= GC_ALLOCATION_THRESHOLD && gy->cycle_collector.roots.count > 0) {
+        gy->cycle_collector.pending = true;
+    }
+}
+
+static inline void gc_safepoint(Graveyard* gy) {
+    if (gy->cycle_collector.pending) cycle_collect(gy);
+}
+
+static void runtime_error(Graveyard* gy, int line, const char* format, ...) {
+    if (gy->had_runtime_error) return;
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(gy->error_message, sizeof(gy->error_message), format, args);
+    va_end(args);
+    
+    gy->error_line = line;
+    gy->had_runtime_error = true;
+}
+
+static char* generate_random_hex_string(int length) {
+    if (length <= 0) return NULL;
+
+    int num_bytes = (length + 1) / 2;
+    unsigned char* random_bytes = malloc(num_bytes);
+    if (!random_bytes) return NULL;
+
+#ifdef _WIN32
+    HCRYPTPROV hCryptProv;
+    if (!CryptAcquireContext(&hCryptProv, NULL, NULL, PROV_RSA_FULL, CRYPT_VERIFYCONTEXT)) {
+        free(random_bytes);
+        return NULL;
+    }
+    if (!CryptGenRandom(hCryptProv, num_bytes, random_bytes)) {
+        CryptReleaseContext(hCryptProv, 0);
+        free(random_bytes);
+        return NULL;
+    }
+    CryptReleaseContext(hCryptProv, 0);
+#else
+    FILE* urandom = fopen("/dev/urandom", "r");
+    if (!urandom) {
+        free(random_bytes);
+        return NULL;
     }
+    fread(random_bytes, 1, num_bytes, urandom);
+    fclose(urandom);
+#endif
+
+    char* hex_string = malloc(length + 1);
+    if (!hex_string) {
+        free(random_bytes);
+        return NULL;
+    }
+
+    for (int i = 0; i < num_bytes; i++) {
+        sprintf(hex_string + (i * 2), "%02x", random_bytes[i]);
+    }
+    hex_string[length] = '\0';
+    
+    free(random_bytes);
+    return hex_string;
+}
+
+static Environment* get_global_environment(Graveyard* gy) {
+    Environment* env = gy->environment;
+    while (env->enclosing != NULL) {
+        env = env->enclosing;
+    }
+    return env;
+}
+
+static bool are_values_equal(GraveyardValue a, GraveyardValue b) {
+    if (VALUE_TYPE(a) != VALUE_TYPE(b)) {
+        return false;
+    }
+
+    switch (VALUE_TYPE(a)) {
+        case VAL_NULL:   return true;
+        case VAL_BOOL:   return AS_BOOL(a) == AS_BOOL(b);
+        case VAL_NUMBER: return AS_NUMBER(a) == AS_NUMBER(b);
+        case VAL_STRING:
+            return AS_STRING(a)->length == AS_STRING(b)->length && strcmp(AS_STRING(a)->chars, AS_STRING(b)->chars) == 0;
+        case VAL_ARRAY: return AS_ARRAY(a) == AS_ARRAY(b);
+        default:
+            return false;
+    }
+}
+
+static uint32_t hash_graveyard_value(GraveyardValue value);
+
+static GraveyardValue create_hashtable_value(Graveyard* gy) {
+    GraveyardHashtable* ht = slab_alloc(&gy->slabs, SLAB_HASHTABLE, sizeof(GraveyardHashtable));
+    ht->count = 0;
+    ht->capacity = 8;
+    ht->ref_count = 1;
+    ht->is_scratch = false;
+    ht->gc.color = GC_BLACK;
+    ht->gc.buffered = false;
+    gc_note_allocation(gy);
+    ht->entries = malloc(ht->capacity * sizeof(HashtableEntry));
+    for (int i = 0; i < ht->capacity; i++) {
+        ht->entries[i].is_in_use = false;
+        ht->entries[i].key = NULL_VALUE;
+    }
+    return OBJECT_VALUE(VAL_HASHTABLE, ht);
+}
+
+static uint32_t hash_graveyard_value(GraveyardValue value) {
+    switch (VALUE_TYPE(value)) {
+        case VAL_STRING:
+            return hash_string(AS_STRING(value)->chars, AS_STRING(value)->length);
+        case VAL_NUMBER:
+            return (uint32_t)AS_NUMBER(value);
+        case VAL_BOOL:
+            return AS_BOOL(value) ? 1 : 0;
+        case VAL_NULL:
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+static HashtableEntry* hashtable_find_entry(HashtableEntry* entries, int capacity, GraveyardValue key) {
+    uint32_t index = hash_graveyard_value(key) % capacity;
+    for (;;) {
+        HashtableEntry* entry = &entries[index];
+        if (!entry->is_in_use || are_values_equal(entry->key, key)) {
+            return entry;
+        }
+        index = (index + 1) % capacity;
+    }
+}
+
+static void hashtable_resize(GraveyardHashtable* ht, int new_capacity) {
+    HashtableEntry* new_entries = malloc(new_capacity * sizeof(HashtableEntry));
+    if (!new_entries) {
+        perror("hashtable_resize: malloc failed");
+        exit(1);
+    }
+    for (int i = 0; i < new_capacity; i++) {
+        new_entries[i].is_in_use = false;
+        new_entries[i].key = NULL_VALUE;
+    }
+
+    ht->count = 0;
+    for (int i = 0; i < ht->capacity; i++) {
+        HashtableEntry* entry = &ht->entries[i];
+        if (!entry->is_in_use) continue;
+
+        HashtableEntry* dest = hashtable_find_entry(new_entries, new_capacity, entry->key);
+        dest->key = entry->key;
+        dest->value = entry->value;
+        
+        dest->is_in_use = true;
+        ht->count++;
+    }
+
+    free(ht->entries);
+    ht->entries = new_entries;
+    ht->capacity = new_capacity;
+}
+
+static void hashtable_set(Graveyard* gy, GraveyardHashtable* ht, GraveyardValue key, GraveyardValue value) {
+    if (ht->count + 1 > ht->capacity * 0.75) {
+        int new_capacity = ht->capacity < 8 ? 8 : ht->capacity * 2;
+        hashtable_resize(ht, new_capacity);
+    }
+
+    HashtableEntry* entry = hashtable_find_entry(ht->entries, ht->capacity, key);
+    
+    bool is_new_key = !entry->is_in_use;
+    if (is_new_key) {
+        entry->is_in_use = true;
+        ht->count++;
+        inc_ref(key);
+        entry->key = key;
+        inc_ref(value);
+    } else {
+        dec_ref(gy, entry->value);
+        inc_ref(value);
+    }
+    
+    entry->value = value;
+}
+
+static MonolithEntry* find_entry(MonolithEntry* entries, int capacity, Symbol* key) {
+    uint32_t index = key->hash & (capacity - 1);
+    for (;;) {
+        MonolithEntry* entry = &entries[index];
+        if (entry->key == NULL || entry->key == key) {
+            return entry;
+        }
+        index = (index + 1) & (capacity - 1);
+    }
+}
+
+static GraveyardValue create_null_value() {
+    return NULL_VALUE;
+}
+
+static GraveyardValue create_string_value(Graveyard* gy, const char* chars) {
+    size_t length = strlen(chars);
+    GraveyardString* string_obj = slab_alloc(&gy->slabs, SLAB_STRING, sizeof(GraveyardString) + length + 1);
+    string_obj->chars = (char*)(string_obj + 1);
+    memcpy(string_obj->chars, chars, length);
+    string_obj->chars[length] = '\0';
+    string_obj->length = length;
+    string_obj->ref_count = 1;
+    string_obj->is_scratch = false;
+
+    return OBJECT_VALUE(VAL_STRING, string_obj);
+}
+
+static MemoCache* memo_cache_new(AstNode* declaration) {
+    MemoCache* cache = malloc(sizeof(MemoCache));
+    if (!cache) {
+        perror("memo_cache_new: malloc failed");
+        exit(1);
+    }
+    cache->declaration = declaration;
+    cache->arity = (int)declaration->as.function_declaration.param_count;
+    cache->count = 0;
+    cache->lru_head = -1;
+    cache->lru_tail = -1;
+    cache->keys = malloc((cache->arity > 0 ? cache->arity : 1) * MEMO_CACHE_CAPACITY * sizeof(GraveyardValue));
+    if (!cache->keys) {
+        perror("memo_cache_new: key malloc failed");
+        exit(1);
+    }
+    for (int i = 0; i < MEMO_CACHE_CAPACITY; i++) {
+        cache->buckets[i] = -1;
+    }
+    return cache;
+}
+
+static void memo_cache_free(Graveyard* gy, MemoCache* cache) {
+    if (cache == NULL) return;
+    for (int i = 0; i < cache->count; i++) {
+        for (int j = 0; j < cache->arity; j++) {
+            dec_ref(gy, cache->keys[i * cache->arity + j]);
+        }
+        dec_ref(gy, cache->entries[i].result);
+    }
+    free(cache->keys);
+    free(cache);
+}
+
+static bool memo_value_cacheable(GraveyardValue value) {
+    switch (VALUE_TYPE(value)) {
+        case VAL_NUMBER:
+        case VAL_STRING:
+        case VAL_BOOL:
+        case VAL_NULL:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static uint32_t memo_hash_key(GraveyardValue* args, int arity) {
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < arity; i++) {
+        hash ^= hash_graveyard_value(args[i]) + (uint32_t)VALUE_TYPE(args[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void memo_lru_unlink(MemoCache* cache, int index) {
+    MemoEntry* entry = &cache->entries[index];
+    if (entry->lru_prev >= 0) cache->entries[entry->lru_prev].lru_next = entry->lru_next;
+    else cache->lru_head = entry->lru_next;
+    if (entry->lru_next >= 0) cache->entries[entry->lru_next].lru_prev = entry->lru_prev;
+    else cache->lru_tail = entry->lru_prev;
+}
+
+static void memo_lru_push_front(MemoCache* cache, int index) {
+    MemoEntry* entry = &cache->entries[index];
+    entry->lru_prev = -1;
+    entry->lru_next = cache->lru_head;
+    if (cache->lru_head >= 0) cache->entries[cache->lru_head].lru_prev = index;
+    cache->lru_head = index;
+    if (cache->lru_tail < 0) cache->lru_tail = index;
+}
+
+static bool memo_cache_lookup(MemoCache* cache, uint32_t hash, GraveyardValue* args, GraveyardValue* out_result) {
+    for (int index = cache->buckets[hash & (MEMO_CACHE_CAPACITY - 1)]; index >= 0; index = cache->entries[index].bucket_next) {
+        MemoEntry* entry = &cache->entries[index];
+        if (entry->hash != hash) continue;
+
+        GraveyardValue* key = &cache->keys[index * cache->arity];
+        bool matches = true;
+        for (int i = 0; i < cache->arity && matches; i++) {
+            matches = are_values_equal(key[i], args[i]);
+        }
+        if (!matches) continue;
+
+        if (cache->lru_head != index) {
+            memo_lru_unlink(cache, index);
+            memo_lru_push_front(cache, index);
+        }
+        *out_result = entry->result;
+        inc_ref(*out_result);
+        return true;
+    }
+    return false;
+}
+
+static void memo_cache_store(Graveyard* gy, MemoCache* cache, uint32_t hash, GraveyardValue* args, GraveyardValue result) {
+    int index;
+    if (cache->count < MEMO_CACHE_CAPACITY) {
+        index = cache->count++;
+    } else {
+        index = cache->lru_tail;
+        MemoEntry* victim = &cache->entries[index];
+        int* link = &cache->buckets[victim->hash & (MEMO_CACHE_CAPACITY - 1)];
+        while (*link != index) {
+            link = &cache->entries[*link].bucket_next;
+        }
+        *link = victim->bucket_next;
+        memo_lru_unlink(cache, index);
+        for (int i = 0; i < cache->arity; i++) {
+            dec_ref(gy, cache->keys[index * cache->arity + i]);
+        }
+        dec_ref(gy, victim->result);
+    }
+
+    MemoEntry* entry = &cache->entries[index];
+    entry->hash = hash;
+    entry->result = result;
+    inc_ref(result);
+    for (int i = 0; i < cache->arity; i++) {
+        cache->keys[index * cache->arity + i] = args[i];
+    }
+
+    int* bucket = &cache->buckets[hash & (MEMO_CACHE_CAPACITY - 1)];
+    entry->bucket_next = *bucket;
+    *bucket = index;
+    memo_lru_push_front(cache, index);
+}
+
+static GraveyardValue create_function_value(Graveyard* gy, AstNode* node) {
+    GraveyardFunction* func = malloc(sizeof(GraveyardFunction));
+
+    func->ref_count = 1;
+    func->arity = node->as.function_declaration.param_count;
+    func->body = node->as.function_declaration.body;
+    func->params = node->as.function_declaration.params;
+    
+    func->closure = gy->environment;
+    func->memo = NULL;
+    if (node->as.function_declaration.is_memoized && func->arity <= MEMO_MAX_ARITY) {
+        func->memo = memo_cache_new(node);
+    }
+
+    func->name = create_string_value(gy, node->as.function_declaration.name.lexeme);
+
+    return OBJECT_VALUE(VAL_FUNCTION, func);
+}
+
+static inline GraveyardValue execute_node(Graveyard* gy, AstNode* node) {
+    return node->handler(gy, node);
+}
+
+static bool calculate_slice_bounds(long length, AstNode* start_expr, AstNode* stop_expr, AstNode* step_expr, long* out_start, long* out_stop, long* out_step, Graveyard* gy) {
+
+    *out_step = 1;
+    if (step_expr) {
+        GraveyardValue step_val = execute_node(gy, step_expr);
+        if (VALUE_TYPE(step_val) != VAL_NUMBER) {
+            dec_ref(gy, step_val);
+            return false; 
+        }
+        *out_step = (long)AS_NUMBER(step_val);
+        dec_ref(gy, step_val);
+    }
+
+    if (*out_step == 0) {
+        return false;
+    }
+
+    *out_start = (*out_step > 0) ? 0 : length - 1;
+    if (start_expr) {
+        GraveyardValue start_val = execute_node(gy, start_expr);
+        if (VALUE_TYPE(start_val) == VAL_NUMBER) {
+            *out_start = (long)AS_NUMBER(start_val);
+            if (*out_start < 0) *out_start += length;
+        }
+        dec_ref(gy, start_val);
+    }
+
+    *out_stop = (*out_step > 0) ? length : -1;
+    if (stop_expr) {
+        GraveyardValue stop_val = execute_node(gy, stop_expr);
+        if (VALUE_TYPE(stop_val) == VAL_NUMBER) {
+            *out_stop = (long)AS_NUMBER(stop_val);
+            if (*out_stop < 0) *out_stop += length;
+        }
+        dec_ref(gy, stop_val);
+    }
+
+    if (*out_start < 0) *out_start = 0;
+    if (*out_start > length) *out_start = length;
+    if (*out_stop > length) *out_stop = length;
+    
+    return true;
+}
+
+static GraveyardValue execute_block(Graveyard* gy, AstNode* block_node, Environment* environment) {
+    Environment* previous = gy->environment;
+    gy->environment = environment;
+    GraveyardValue last_val = create_null_value();
+
+    for (size_t i = 0; i < block_node->as.block.count; i++) {
+        dec_ref(gy, last_val);
+        last_val = execute_node(gy, block_node->as.block.statements[i]);
+        gc_safepoint(gy);
+        if (gy->is_returning || gy->encountered_break || gy->encountered_continue) {
+            break;
+        }
+    }
+
+    gy->environment = previous;
+    return last_val;
+}
+
+static void monolith_resize(Monolith* monolith, int new_capacity) {
+    MonolithEntry* new_entries = malloc(new_capacity * sizeof(MonolithEntry));
+    if (!new_entries) {
+        perror("monolith_resize: malloc failed");
+        exit(1); 
+    }
+    for (int i = 0; i < new_capacity; i++) {
+        new_entries[i].key = NULL;
+    }
+
+    for (int i = 0; i < monolith->capacity; i++) {
+        MonolithEntry* entry = &monolith->entries[i];
+        if (entry->key == NULL) continue;
+
+        MonolithEntry* dest = find_entry(new_entries, new_capacity, entry->key);
+        dest->key = entry->key;
+        dest->value = entry->value;
+    }
+
+    free(monolith->entries);
+    monolith->entries = new_entries;
+    monolith->capacity = new_capacity;
+}
+
+bool monolith_set(Graveyard* gy, Monolith* monolith, Symbol* key, GraveyardValue value) {
+    if (monolith->count + 1 > monolith->capacity * 0.75) {
+        int new_capacity = monolith->capacity < 8 ? 8 : monolith->capacity * 2;
+        monolith_resize(monolith, new_capacity);
+    }
+
+    MonolithEntry* entry = find_entry(monolith->entries, monolith->capacity, key);
+    bool is_new_key = entry->key == NULL;
+
+    if (!is_new_key) {
+        dec_ref(gy, entry->value);
+    }
+    
+    inc_ref(value);
+    entry->value = value;
+
+    if (is_new_key) {
+        monolith->count++;
+        entry->key = key;
+    }
+    
+    return true;
+}
+
+bool monolith_get(Monolith* monolith, Symbol* key, GraveyardValue* out_value) {
+    if (monolith->count == 0) return false;
+
+    MonolithEntry* entry = find_entry(monolith->entries, monolith->capacity, key);
+    if (entry->key == NULL) {
+        return false;
+    }
+
+    *out_value = entry->value;
+    return true;
+}
+
+static Shape* shape_new(Shape* parent, Symbol* name) {
+    Shape* shape = malloc(sizeof(Shape));
+    if (!shape) {
+        perror("shape_new: malloc failed");
+        exit(1);
+    }
+    shape->count = parent ? parent->count + 1 : 0;
+    shape->names = NULL;
+    if (shape->count > 0) {
+        shape->names = malloc(shape->count * sizeof(Symbol*));
+        if (!shape->names) {
+            perror("shape_new: malloc failed");
+            exit(1);
+        }
+        if (parent->count > 0) {
+            memcpy(shape->names, parent->names, parent->count * sizeof(Symbol*));
+        }
+        shape->names[parent->count] = name;
+    }
+    shape->transitions = NULL;
+    shape->transition_count = 0;
+    shape->transition_capacity = 0;
+    return shape;
+}
+
+static void shape_free(Shape* shape) {
+    for (int i = 0; i < shape->transition_count; i++) {
+        shape_free(shape->transitions[i].shape);
+    }
+    free(shape->transitions);
+    free(shape->names);
+    free(shape);
+}
+
+static Shape* shape_transition(Shape* shape, Symbol* name) {
+    for (int i = 0; i < shape->transition_count; i++) {
+        if (shape->transitions[i].name == name) return shape->transitions[i].shape;
+    }
+    if (shape->transition_count == shape->transition_capacity) {
+        shape->transition_capacity = shape->transition_capacity < 4 ? 4 : shape->transition_capacity * 2;
+        shape->transitions = realloc(shape->transitions, shape->transition_capacity * sizeof(ShapeTransition));
+        if (!shape->transitions) {
+            perror("shape_transition: realloc failed");
+            exit(1);
+        }
+    }
+    Shape* next = shape_new(shape, name);
+    shape->transitions[shape->transition_count].name = name;
+    shape->transitions[shape->transition_count].shape = next;
+    shape->transition_count++;
+    return next;
+}
+
+static int shape_find_slot(Shape* shape, Symbol* name) {
+    for (int i = 0; i < shape->count; i++) {
+        if (shape->names[i] == name) return i;
+    }
+    return -1;
+}
+
+static GraveyardValue create_type_value(GraveyardValue name) {
+    GraveyardType* type = malloc(sizeof(GraveyardType));
+    type->ref_count = 1;
+    type->name = name;
+    monolith_init(&type->fields);
+    monolith_init(&type->methods);
+    type->instance_shape = NULL;
+    type->instance_shape_field_count = -1;
+    return OBJECT_VALUE(VAL_TYPE, type);
+}
+
+static GraveyardValue create_instance_value(Graveyard* gy, GraveyardValue type_value) {
+    GraveyardType* type = AS_TYPE(type_value);
+    if (type->instance_shape == NULL || type->instance_shape_field_count != type->fields.count) {
+        Shape* shape = gy->root_shape;
+        for (int i = 0; i < type->fields.capacity; i++) {
+            MonolithEntry* entry = &type->fields.entries[i];
+            if (entry->key != NULL) {
+                shape = shape_transition(shape, entry->key);
+            }
+        }
+        type->instance_shape = shape;
+        type->instance_shape_field_count = type->fields.count;
+    }
+
+    GraveyardInstance* instance = slab_alloc(&gy->slabs, SLAB_INSTANCE, sizeof(GraveyardInstance));
+    instance->ref_count = 1;
+    instance->gc.color = GC_BLACK;
+    instance->gc.buffered = false;
+    gc_note_allocation(gy);
+    instance->type = type;
+    instance->shape = type->instance_shape;
+    instance->field_capacity = instance->shape->count;
+    instance->fields = NULL;
+    if (instance->field_capacity > 0) {
+        instance->fields = malloc(instance->field_capacity * sizeof(GraveyardValue));
+        if (!instance->fields) {
+            perror("create_instance_value: malloc failed");
+            exit(1);
+        }
+    }
+
+    int slot = 0;
+    for (int i = 0; i < type->fields.capacity; i++) {
+        MonolithEntry* entry = &type->fields.entries[i];
+        if (entry->key != NULL) {
+            inc_ref(entry->value);
+            instance->fields[slot++] = entry->value;
+        }
+    }
+
+    inc_ref(type_value);
+    return OBJECT_VALUE(VAL_INSTANCE, instance);
+}
+
+static void instance_set_field(Graveyard* gy, GraveyardInstance* instance, Symbol* name, GraveyardValue value) {
+    int slot = shape_find_slot(instance->shape, name);
+    inc_ref(value);
+    if (slot >= 0) {
+        dec_ref(gy, instance->fields[slot]);
+        instance->fields[slot] = value;
+        return;
+    }
+    if (instance->shape->count == instance->field_capacity) {
+        instance->field_capacity = instance->field_capacity < 4 ? 4 : instance->field_capacity * 2;
+        instance->fields = realloc(instance->fields, instance->field_capacity * sizeof(GraveyardValue));
+        if (!instance->fields) {
+            perror("instance_set_field: realloc failed");
+            exit(1);
+        }
+    }
+    instance->fields[instance->shape->count] = value;
+    instance->shape = shape_transition(instance->shape, name);
+}
+
+static size_t environment_size(ScopeLayout* layout) {
+    return sizeof(Environment) + (layout != NULL ? layout->count : 0) * sizeof(GraveyardValue);
+}
+
+Environment* environment_new(Graveyard* gy, Environment* enclosing) {
+    Environment* env = slab_alloc(&gy->slabs, SLAB_ENVIRONMENT, sizeof(Environment));
+    env->enclosing = enclosing;
+    env->layout = NULL;
+    monolith_init(&env->values);
+    return env;
+}
+
+Environment* environment_acquire(Graveyard* gy, Environment* enclosing, ScopeLayout* layout) {
+    int slot_count = layout != NULL ? layout->count : 0;
+    Environment* env = slab_alloc(&gy->slabs, SLAB_ENVIRONMENT, environment_size(layout));
+    env->values.entries = NULL;
+    env->values.capacity = 0;
+    env->values.count = 0;
+    env->enclosing = enclosing;
+    env->layout = layout;
+    for (int i = 0; i < slot_count; i++) {
+        env->slots[i] = UNDEFINED_VALUE;
+    }
+    return env;
+}
+
+void environment_release(Graveyard* gy, Environment* env) {
+    int slot_count = env->layout != NULL ? env->layout->count : 0;
+    for (int i = 0; i < slot_count; i++) {
+        dec_ref(gy, env->slots[i]);
+    }
+    monolith_free(gy, &env->values);
+    slab_free(&gy->slabs, SLAB_ENVIRONMENT, env, environment_size(env->layout));
+}
+
+void environment_free(Graveyard* gy, Environment* env) {
+    if (env->layout != NULL) {
+        for (int i = 0; i < env->layout->count; i++) {
+            dec_ref(gy, env->slots[i]);
+        }
+    }
+    monolith_free(gy, &env->values);
+    slab_free(&gy->slabs, SLAB_ENVIRONMENT, env, environment_size(env->layout));
+}
+
+static void environment_set_slot(Graveyard* gy, Environment* env, int slot, GraveyardValue value) {
+    GraveyardValue old_value = env->slots[slot];
+    inc_ref(value);
+    env->slots[slot] = value;
+    dec_ref(gy, old_value);
+}
+
+static int environment_slot_of(Environment* env, Symbol* name) {
+    return env->layout != NULL ? scope_layout_find(env->layout, name) : -1;
+}
+
+void environment_define(Graveyard* gy, Environment* env, Symbol* name, GraveyardValue value) {
+    int slot = environment_slot_of(env, name);
+    if (slot >= 0) {
+        environment_set_slot(gy, env, slot, value);
+        return;
+    }
+    monolith_set(gy, &env->values, name, value);
+}
+
+void environment_define_parameter(Graveyard* gy, Environment* env, GraveyardFunction* function, size_t index, GraveyardValue value) {
+    if (env->layout != NULL && index < (size_t)env->layout->param_count) {
+        environment_set_slot(gy, env, env->layout->param_slots[index], value);
+        return;
+    }
+    environment_define(gy, env, function->params[index].symbol, value);
+}
+
+GraveyardValue environment_parameter(Environment* env, GraveyardFunction* function, size_t index) {
+    if (env->layout != NULL && index < (size_t)env->layout->param_count) {
+        return env->slots[env->layout->param_slots[index]];
+    }
+    GraveyardValue value = create_null_value();
+    monolith_get(&env->values, function->params[index].symbol, &value);
+    return value;
+}
+
+static bool environment_assign_local(Graveyard* gy, Environment* env, Symbol* name, GraveyardValue value) {
+    int slot = environment_slot_of(env, name);
+    if (slot >= 0 && VALUE_TYPE(env->slots[slot]) != VAL_UNDEFINED) {
+        environment_set_slot(gy, env, slot, value);
+        return true;
+    }
+    if (env->values.count > 0 && find_entry(env->values.entries, env->values.capacity, name)->key != NULL) {
+        monolith_set(gy, &env->values, name, value);
+        return true;
+    }
+    return false;
+}
+
+bool environment_assign(Graveyard* gy, Environment* env, Symbol* name, GraveyardValue value) {
+    for (; env != NULL; env = env->enclosing) {
+        if (environment_assign_local(gy, env, name, value)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool environment_get(Environment* env, Symbol* name, GraveyardValue* out_value) {
+    for (; env != NULL; env = env->enclosing) {
+        int slot = environment_slot_of(env, name);
+        if (slot >= 0 && VALUE_TYPE(env->slots[slot]) != VAL_UNDEFINED) {
+            *out_value = env->slots[slot];
+            return true;
+        }
+        if (monolith_get(&env->values, name, out_value)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool resolved_get(Graveyard* gy, VariableResolution* resolution, Symbol* name, GraveyardValue* out_value) {
+    Environment* env = gy->environment;
+    for (int i = 0; i < resolution->depth; i++) {
+        int slot = resolution->slots[i];
+        if (slot >= 0 && VALUE_TYPE(env->slots[slot]) != VAL_UNDEFINED) {
+            *out_value = env->slots[slot];
+            return true;
+        }
+        if (monolith_get(&env->values, name, out_value)) {
+            return true;
+        }
+        env = env->enclosing;
+    }
+
+    return environment_get(env, name, out_value);
+}
+
+void resolved_define(Graveyard* gy, VariableResolution* resolution, Symbol* name, GraveyardValue value) {
+    if (resolution->depth > 0 && resolution->slots[0] >= 0) {
+        environment_set_slot(gy, gy->environment, resolution->slots[0], value);
+        return;
+    }
+    environment_define(gy, gy->environment, name, value);
+}
+
+void resolved_assign(Graveyard* gy, VariableResolution* resolution, Symbol* name, GraveyardValue value) {
+    Environment* env = gy->environment;
+    for (int i = 0; i < resolution->depth; i++) {
+        int slot = resolution->slots[i];
+        if (slot >= 0 && VALUE_TYPE(env->slots[slot]) != VAL_UNDEFINED) {
+            environment_set_slot(gy, env, slot, value);
+            return;
+        }
+        if (env->values.count > 0 && find_entry(env->values.entries, env->values.capacity, name)->key != NULL) {
+            monolith_set(gy, &env->values, name, value);
+            return;
+        }
+        env = env->enclosing;
+    }
+
+    if (!environment_assign(gy, env, name, value)) {
+        resolved_define(gy, resolution, name, value);
+    }
+}
+
+static GraveyardValue create_bool_value(bool value) {
+    return BOOL_VALUE(value);
+}
+
+static GraveyardValue create_number_value(double value) {
+    return NUMBER_VALUE(value);
+}
+
+// Numbers are always doubles. Integral ones up to 2^53 take int64 paths for modulo, subscripts
+// and hashtable keys. Loop iterators are still stored as doubles, and the VM's range opcodes count in doubles.
+static inline bool number_to_int64(double number, int64_t* out) {
+    if (!(number >= -9007199254740992.0 && number <= 9007199254740992.0)) return false;
+    int64_t integer = (int64_t)number;
+    if ((double)integer != number) return false;
+    *out = integer;
+    return true;
+}
+
+static inline bool is_integral_number(double number) {
+    int64_t integer;
+    return number_to_int64(number, &integer) || fmod(number, 1.0) == 0;
+}
+
+static double number_modulo(double left, double right) {
+    int64_t a, b;
+    if (number_to_int64(left, &a) && number_to_int64(right, &b) && b != 0) {
+        int64_t remainder = a % b;
+        if (remainder == 0 && signbit(left)) return -0.0;
+        return (double)remainder;
+    }
+    return fmod(left, right);
+}
+
+static GraveyardValue create_array_value(Graveyard* gy) {
+    GraveyardArray* array_obj = slab_alloc(&gy->slabs, SLAB_ARRAY, sizeof(GraveyardArray));
+    array_obj->capacity = 8;
+    array_obj->count = 0;
+    array_obj->values = malloc(array_obj->capacity * sizeof(GraveyardValue));
+    array_obj->ref_count = 1;
+    array_obj->is_scratch = false;
+    array_obj->gc.color = GC_BLACK;
+    array_obj->gc.buffered = false;
+    gc_note_allocation(gy);
+
+    return OBJECT_VALUE(VAL_ARRAY, array_obj);
+}
+
+static void* scratch_alloc(ScratchRegion* region, size_t size) {
+    size = (size + 7) & ~(size_t)7;
+
+    ScratchChunk* chunk = region->current;
+    if (chunk == NULL || chunk->used + size > chunk->capacity) {
+        ScratchChunk* next = chunk != NULL ? chunk->next : region->head;
+        if (next == NULL || next->capacity < size) {
+            size_t capacity = size > SCRATCH_CHUNK_SIZE ? size : SCRATCH_CHUNK_SIZE;
+            ScratchChunk* fresh = malloc(sizeof(ScratchChunk) + capacity);
+            if (!fresh) {
+                perror("scratch_alloc: malloc failed");
+                exit(1);
+            }
+            fresh->capacity = capacity;
+            fresh->next = next;
+            if (chunk != NULL) {
+                chunk->next = fresh;
+            } else {
+                region->head = fresh;
+            }
+            next = fresh;
+        }
+        next->used = 0;
+        region->current = chunk = next;
+    }
+
+    void* memory = chunk->data + chunk->used;
+    chunk->used += size;
+    return memory;
+}
+
+static inline ScratchMark scratch_mark(ScratchRegion* region) {
+    ScratchMark mark = { region->current, region->current != NULL ? region->current->used : 0 };
+    return mark;
+}
+
+static inline void scratch_release(ScratchRegion* region, ScratchMark mark) {
+    region->current = mark.chunk;
+    if (mark.chunk != NULL) {
+        mark.chunk->used = mark.used;
+    }
+}
+
+static GraveyardString* create_scratch_string(Graveyard* gy, size_t length) {
+    GraveyardString* string_obj = scratch_alloc(&gy->scratch, sizeof(GraveyardString));
+    string_obj->chars = scratch_alloc(&gy->scratch, length + 1);
+    string_obj->chars[length] = '\0';
+    string_obj->length = length;
+    string_obj->ref_count = 1;
+    string_obj->is_scratch = true;
+    return string_obj;
+}
+
+static GraveyardValue create_scratch_array(Graveyard* gy, size_t capacity) {
+    GraveyardArray* array_obj = scratch_alloc(&gy->scratch, sizeof(GraveyardArray));
+    array_obj->capacity = capacity;
+    array_obj->count = 0;
+    array_obj->values = capacity > 0 ? scratch_alloc(&gy->scratch, capacity * sizeof(GraveyardValue)) : NULL;
+    array_obj->ref_count = 1;
+    array_obj->is_scratch = true;
+    array_obj->gc.color = GC_GREEN;
+    array_obj->gc.buffered = false;
+
+    return OBJECT_VALUE(VAL_ARRAY, array_obj);
+}
+
+static GraveyardValue create_scratch_hashtable(Graveyard* gy, size_t pair_count) {
+    int capacity = 8;
+    while (pair_count + 1 > capacity * 0.75) {
+        capacity *= 2;
+    }
+
+    GraveyardHashtable* ht = scratch_alloc(&gy->scratch, sizeof(GraveyardHashtable));
+    ht->count = 0;
+    ht->capacity = capacity;
+    ht->ref_count = 1;
+    ht->is_scratch = true;
+    ht->gc.color = GC_GREEN;
+    ht->gc.buffered = false;
+    ht->entries = scratch_alloc(&gy->scratch, capacity * sizeof(HashtableEntry));
+    for (int i = 0; i < capacity; i++) {
+        ht->entries[i].is_in_use = false;
+        ht->entries[i].key = NULL_VALUE;
+    }
+    return OBJECT_VALUE(VAL_HASHTABLE, ht);
+}
+
+static void value_to_string(GraveyardValue value, char* buffer, size_t buffer_size) {
+    if (!buffer || buffer_size == 0) return;
+
+    switch (VALUE_TYPE(value)) {
+        case VAL_NULL:
+            strncpy(buffer, "null", buffer_size - 1);
+            break;
+        case VAL_BOOL:
+            strncpy(buffer, AS_BOOL(value) ? "true" : "false", buffer_size - 1);
+            break;
+        case VAL_NUMBER:
+            snprintf(buffer, buffer_size, "%g", AS_NUMBER(value));
+            break;
+        case VAL_STRING:
+            snprintf(buffer, buffer_size, "\"%s\"", AS_STRING(value)->chars);
+            break;
+        case VAL_FUNCTION:
+            snprintf(buffer, buffer_size, "%s", AS_STRING(AS_FUNCTION(value)->name)->chars);
+            break;
+
+        case VAL_ARRAY: {
+            size_t capacity = 128;
+            char* result = malloc(capacity);
+            if (!result) { buffer[0] = '\0'; return; }
+            strcpy(result, "[");
+            size_t len = 1;
+
+            GraveyardArray* arr = AS_ARRAY(value);
+            for (size_t i = 0; i < arr->count; i++) {
+                char element_str[256];
+                value_to_string(arr->values[i], element_str, sizeof(element_str));
+                
+                size_t part_len = strlen(element_str);
+                size_t comma_len = (i < arr->count - 1) ? 2 : 0;
+
+                if (len + part_len + comma_len + 2 > capacity) {
+                    capacity = (len + part_len + comma_len + 2) * 2;
+                    char* temp = realloc(result, capacity);
+                    if (!temp) { free(result); buffer[0] = '\0'; return; }
+                    result = temp;
+                }
+                
+                strcat(result, element_str);
+                len += part_len;
+                if (comma_len > 0) {
+                    strcat(result, ", ");
+                    len += comma_len;
+                }
+            }
+            strcat(result, "]");
+            strncpy(buffer, result, buffer_size - 1);
+            free(result);
+            break;
+        }
+        case VAL_HASHTABLE: {
+            size_t capacity = 128;
+            char* result = malloc(capacity);
+            if (!result) { buffer[0] = '\0'; return; }
+            strcpy(result, "{");
+            size_t len = 1;
+
+            GraveyardHashtable* ht = AS_HASHTABLE(value);
+            int printed = 0;
+            for (int i = 0; i < ht->capacity; i++) {
+                if (ht->entries[i].is_in_use) {
+                    char key_str[256], val_str[256];
+                    value_to_string(ht->entries[i].key, key_str, sizeof(key_str));
+                    value_to_string(ht->entries[i].value, val_str, sizeof(val_str));
+
+                    size_t part_len = strlen(key_str) + strlen(val_str) + 2;
+                    size_t comma_len = (printed > 0) ? 2 : 0;
+
+                    if (len + part_len + comma_len + 2 > capacity) {
+                        capacity = (len + part_len + comma_len + 2) * 2;
+                        char* temp = realloc(result, capacity);
+                        if (!temp) { free(result); buffer[0] = '\0'; return; }
+                        result = temp;
+                    }
+
+                    if (comma_len > 0) strcat(result, ", ");
+                    strcat(result, key_str);
+                    strcat(result, ": ");
+                    strcat(result, val_str);
+                    len += part_len + comma_len;
+                    printed++;
+                }
+            }
+            strcat(result, "}");
+            strncpy(buffer, result, buffer_size - 1);
+            free(result);
+            break;
+        }
+        default:
+            strncpy(buffer, "(unknown)", buffer_size - 1);
+            break;
+    }
+    buffer[buffer_size - 1] = '\0';
+}
+
+static bool is_value_falsy(GraveyardValue value) {
+    switch (VALUE_TYPE(value)) {
+        case VAL_NULL:   return true;
+        case VAL_BOOL:   return !AS_BOOL(value);
+        case VAL_NUMBER: return AS_NUMBER(value) == 0;
+        case VAL_ARRAY:  return AS_ARRAY(value)->count == 0;
+        default:         return false;
+    }
+}
+
+static void array_append(GraveyardArray* array, GraveyardValue value) {
+    if (array->count >= array->capacity) {
+        size_t new_capacity = (array->capacity == 0) ? 8 : array->capacity * 2;
+        GraveyardValue* temp = realloc(array->values, new_capacity * sizeof(GraveyardValue));
+        if (!temp) {
+            perror("array_append: realloc failed");
+            exit(1);
+        }
+        array->values = temp;
+        array->capacity = new_capacity;
+    }
+    
+    inc_ref(value);
+    array->values[array->count++] = value;
+}
+
+void monolith_print(Graveyard* gy, Monolith* monolith, int indent);
+
+void print_value(Graveyard* gy, GraveyardValue value) {
+    switch (VALUE_TYPE(value)) {
+        case VAL_BOOL:
+            printf(AS_BOOL(value) ? "$" : "%%");
+            break;
+        case VAL_NULL:
+        case VAL_UNDEFINED:
+            printf("|");
+            break;
+        case VAL_NUMBER: {
+            double num = AS_NUMBER(value);
+            int64_t integer;
+            if (number_to_int64(num, &integer) && !(integer == 0 && signbit(num))) {
+                printf("%lld", (long long)integer);
+            } else if (is_integral_number(num)) {
+                printf("%.0f", num);
+            } else {
+                char buffer[64];
+                snprintf(buffer, sizeof(buffer), "%.15f", num);
+                char* end = buffer + strlen(buffer) - 1;
+                while (end > buffer && *end == '0') { *end = '\0'; end--; }
+                if (end > buffer && *end == '.') { *end = '\0'; }
+                printf("%s", buffer);
+            }
+            break;
+        }
+        case VAL_STRING:
+            printf("%s", AS_STRING(value)->chars);
+            break;
+        case VAL_ARRAY:
+            printf("[");
+            for (size_t i = 0; i < AS_ARRAY(value)->count; i++) {
+                print_value(gy, AS_ARRAY(value)->values[i]);
+                if (i < AS_ARRAY(value)->count - 1) {
+                    printf(", ");
+                }
+            }
+            printf("]");
+            break;
+        case VAL_HASHTABLE:
+            printf("{");
+            int printed = 0;
+            for (int i = 0; i < AS_HASHTABLE(value)->capacity; i++) {
+                HashtableEntry* entry = &AS_HASHTABLE(value)->entries[i];
+                if (entry->is_in_use) {
+                    if (printed > 0) printf(", ");
+                    print_value(gy, entry->key);
+                    printf(": ");
+                    print_value(gy, entry->value);
+                    printed++;
+                }
+            }
+            printf("}");
+            break;
+        case VAL_TYPE:
+            printf("<type: %s>", AS_STRING(AS_TYPE(value)->name)->chars);
+            break;
+        case VAL_INSTANCE: {
+            GraveyardInstance* instance = AS_INSTANCE(value);
+            Monolith fields;
+            monolith_init(&fields);
+            for (int i = 0; i < instance->shape->count; i++) {
+                monolith_set(gy, &fields, instance->shape->names[i], instance->fields[i]);
+            }
+            printf("<instance of %s> {\n", AS_STRING(instance->type->name)->chars);
+            monolith_print(gy, &fields, 2);
+            printf("  }");
+            monolith_free(gy, &fields);
+            break;
+        }
+        case VAL_FUNCTION:
+            printf("<function: %s>", AS_STRING(AS_FUNCTION(value)->name)->chars);
+            break;
+        case VAL_BOUND_METHOD:
+            printf("<method: %s bound to instance>", AS_STRING(AS_FUNCTION(AS_BOUND_METHOD(value)->function)->name)->chars);
+            break;
+        case VAL_ENVIRONMENT:
+            printf("<namespace>");
+            break;
+    }
+}
+
+void monolith_print(Graveyard* gy, Monolith* monolith, int indent) {
+    char indent_str[32] = "";
+    for (int i = 0; i < indent; i++) {
+        strcat(indent_str, "  ");
+    }
+
+    if (monolith->count == 0) {
+        printf("%s(empty)\n", indent_str);
+        return;
+    }
+
+    for (int i = 0; i < monolith->capacity; i++) {
+        MonolithEntry* entry = &monolith->entries[i];
+        if (entry->key != NULL) {
+            printf("%s%s = ", indent_str, entry->key->chars);
+            print_value(gy, entry->value);
+            printf("\n");
+        }
+    }
+}
+
+void print_environment_recursive(Graveyard* gy, Environment* env, int depth) {
+    if (env == NULL) return;
+
+    printf("\n--- Scope Level %d ", depth);
+    if (depth == 0) {
+        printf("(Global) ---\n");
+    } else {
+        printf("---\n");
+    }
+    
+    monolith_print(gy, &env->values, 1);
+    
+    print_environment_recursive(gy, env->enclosing, depth + 1);
+}
+
+static void print_memo_stats(AstNode** slot, void* context) {
+    AstNode* node = *slot;
+    if (node == NULL) return;
+    if (node->type == AST_FUNCTION_DECLARATION && node->as.function_declaration.is_memoized) {
+        printf("  %s: %zu hits, %zu misses\n", node->as.function_declaration.name.lexeme,
+               node->as.function_declaration.memo_hits, node->as.function_declaration.memo_misses);
+        *(bool*)context = true;
+    }
+    ast_visit_children(node, print_memo_stats, context);
+}
+
+void graveyard_debug_print(Graveyard* gy) {
+    printf("========================================\n");
+    printf("        GRAVEYARD DEBUG DUMP\n");
+    printf("========================================\n");
+    
+    printf("\n--- Defined Namespaces ---\n");
+    monolith_print(gy, &gy->namespaces, 1);
+    
+    Environment* global_env = get_global_environment(gy);
+    printf("\n--- Defined Types ---\n");
+    bool has_types = false;
+    for (int i = 0; i < global_env->values.capacity; i++) {
+        MonolithEntry* entry = &global_env->values.entries[i];
+        if (entry->key != NULL && VALUE_TYPE(entry->value) == VAL_TYPE) {
+            printf("  %s\n", entry->key->chars);
+            has_types = true;
+        }
+    }
+    if (!has_types) printf("  (none)\n");
+
+    printf("\n--- Specialized Nodes ---\n");
+    printf("  specialized: %d\n", gy->specialized_node_count);
+    printf("  deoptimized: %d\n", gy->deoptimized_node_count);
+
+    printf("\n--- JIT ---\n");
+    printf("  compiled functions: %d\n", gy->jit_compiled_count);
+
+    printf("\n--- Cycle Collector ---\n");
+    printf("  collections: %d\n", gy->cycle_collector.collections);
+    printf("  freed objects: %zu\n", gy->cycle_collector.freed_objects);
+    printf("  pending roots: %zu\n", gy->cycle_collector.roots.count);
+    printf("  total pause: %.3f ms\n", gy->cycle_collector.total_pause * 1000.0);
+    printf("  max pause: %.3f ms\n", gy->cycle_collector.max_pause * 1000.0);
+
+    printf("\n--- Allocator ---\n");
+    static const char* slab_kind_names[SLAB_KIND_COUNT] = { "String", "Array", "Hashtable", "Instance", "BoundMethod", "Environment" };
+    for (int i = 0; i < SLAB_KIND_COUNT; i++) {
+        printf("  %-12s live: %zu objects, %zu bytes  peak: %zu bytes\n", slab_kind_names[i], gy->slabs.live_objects[i], gy->slabs.live_bytes[i], gy->slabs.peak_bytes[i]);
+    }
+    printf("  reserved: %zu bytes\n", gy->slabs.reserved_bytes);
+
+    printf("\n--- Memoized Functions ---\n");
+    bool has_memoized = false;
+    print_memo_stats(&gy->ast_root, &has_memoized);
+    if (!has_memoized) printf("  (none)\n");
+
+    printf("\n--- Final Environment Chain ---\n");
+    print_environment_recursive(gy, gy->environment, 0);
+    
+    printf("\n========================================\n");
+}
+
+void graveyard_free(Graveyard *gy) {
+    if (!gy) return;
+    // printf("DEBUG: Starting final cleanup...\n"); // <-- ADD THIS
+    free(gy->source_code);
+    free(gy->tokens);
+    ast_arena_free(gy, &gy->ast_arena);
+    
+    dec_ref(gy, gy->arguments);
+    dec_ref(gy, gy->last_executed_value);
+    dec_ref(gy, gy->return_value);
+
+    for (int i = 0; i < CALL_STACK_MAX_SEGMENTS && gy->stack_segments[i] != NULL; i++) {
+#ifdef GRAVEYARD_STACK_SEGMENTS
+        munmap(gy->stack_segments[i]->memory, CALL_STACK_SEGMENT_SIZE);
+#endif
+        free(gy->stack_segments[i]);
+    }
+
+    Environment* env = gy->environment;
+    while (env != NULL) {
+        Environment* next = env->enclosing;
+        environment_free(gy, env);
+        env = next;
+    }
+
+    ScratchChunk* chunk = gy->scratch.head;
+    while (chunk != NULL) {
+        ScratchChunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    
+    for (int i = 0; i < gy->namespaces.capacity; i++) {
+        MonolithEntry* entry = &gy->namespaces.entries[i];
+        if (entry->key != NULL) {
+            Environment* ns_env = AS_ENVIRONMENT(entry->value);
+            environment_free(gy, ns_env);
+        }
+    }
+    monolith_free(gy, &gy->namespaces);
+    while (gy->cycle_collector.roots.count > 0) {
+        cycle_collect(gy);
+    }
+    free(gy->cycle_collector.roots.values);
+    gy->cycle_collector.roots = (GcStack){ NULL, 0, 0 };
+    slab_allocator_free(&gy->slabs);
+    shape_free(gy->root_shape);
+    symbol_table_free(&gy->symbols);
+    // printf("DEBUG: Cleanup complete. Freeing main struct.\n"); // <-- ADD THIS
+    free(gy);
+}
+
+Graveyard *graveyard_init(const char *mode, const char *filename) {
+    Graveyard *gy = malloc(sizeof(Graveyard));
+    if (!gy) {
+        perror("graveyard_init: malloc failed");
+        return NULL;
+    }
+    gy->mode = mode;
+    gy->filename = filename;
+    gy->source_code = NULL;
+    gy->tokens = NULL;
+    gy->token_count = 0;
+    gy->had_token_error = false;
+    gy->ast_root = NULL;
+    ast_arena_init(&gy->ast_arena);
+    gy->last_executed_value = create_null_value();
+    gy->optimize_level = 1;
+    gy->specialized_node_count = 0;
+    gy->jit_enabled = false;
+    gy->jit_compiled_count = 0;
+    gy->deoptimized_node_count = 0;
+    slab_allocator_init(&gy->slabs);
+    memset(&gy->cycle_collector, 0, sizeof(CycleCollector));
+    symbol_table_init(&gy->symbols);
+    gy->this_symbol = intern_cstring(&gy->symbols, "this");
+    gy->root_shape = shape_new(NULL, NULL);
+    gy->environment = environment_new(gy, NULL);
+    gy->scratch.head = NULL;
+    gy->scratch.current = NULL;
+    monolith_init(&gy->namespaces);
+    gy->is_returning = false;
+    gy->return_value = create_null_value();
+    gy->call_environment = NULL;
+    gy->has_tail_call = false;
+    gy->stack_base = 0;
+    gy->stack_budget = 0;
+    gy->stack_limit = 0;
+    memset(gy->stack_segments, 0, sizeof(gy->stack_segments));
+    gy->stack_segment_depth = 0;
+    gy->stack_segment_limit = 0;
+    gy->vm_frame_limit = 0;
+    gy->encountered_break = false;
+    gy->encountered_continue = false;
+    gy->had_runtime_error = false;
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    srand((unsigned int)ts.tv_sec ^ (unsigned int)ts.tv_nsec);
+    return gy;
+}
+
+void graveyard_set_arguments(Graveyard* gy, int count, char* args[]) {
+    gy->arguments = create_hashtable_value(gy);
+    GraveyardValue args_list = create_array_value(gy);
+    GraveyardValue kwargs_ht = create_hashtable_value(gy);
+
+    for (int i = 0; i < count; i++) {
+        char* arg = args[i];
+        if (strncmp(arg, "--", 2) == 0) {
+            char* key = arg + 2;
+            char* value_ptr = strchr(key, '=');
+            
+            if (value_ptr != NULL) {
+                *value_ptr = '\0';
+                char* value = value_ptr + 1;
+                hashtable_set(gy, AS_HASHTABLE(kwargs_ht), create_string_value(gy, key), create_string_value(gy, value));
+            } else {
+                hashtable_set(gy, AS_HASHTABLE(kwargs_ht), create_string_value(gy, key), create_bool_value(true));
+            }
+        } else if (strncmp(arg, "-", 1) == 0) {
+            char* key = arg + 1;
+            hashtable_set(gy, AS_HASHTABLE(kwargs_ht), create_string_value(gy, key), create_bool_value(true));
+        } else {
+            array_append(AS_ARRAY(args_list), create_string_value(gy, arg));
+        }
+    }
+
+    hashtable_set(gy, AS_HASHTABLE(gy->arguments), create_string_value(gy, "args"), args_list);
+    hashtable_set(gy, AS_HASHTABLE(gy->arguments), create_string_value(gy, "kwargs"), kwargs_ht);
+}
+
+static GraveyardValue evaluate_unary_op(Graveyard* gy, GraveyardTokenType op_type, GraveyardValue right, int line) {
+    GraveyardValue result = create_null_value();
+
+    switch (op_type) {
+        case MINUS:
+            if (VALUE_TYPE(right) != VAL_NUMBER) {
+                runtime_error(gy, line, "Operand for negation must be a number");
+            } else {
+                result = create_number_value(-AS_NUMBER(right));
+            }
+            break;
+
+        case NOT:
+            result = create_bool_value(is_value_falsy(right));
+            break;
+
+        case TYPEOF: {
+            switch (VALUE_TYPE(right)) {
+                case VAL_BOOL:         result = create_string_value(gy, "boolean"); break;
+                case VAL_NULL:         result = create_string_value(gy, "null"); break;
+                case VAL_STRING:       result = create_string_value(gy, "string"); break;
+                case VAL_ARRAY:        result = create_string_value(gy, "array"); break;
+                case VAL_HASHTABLE:    result = create_string_value(gy, "hashtable"); break;
+                case VAL_FUNCTION:
+                case VAL_BOUND_METHOD: result = create_string_value(gy, "function"); break;
+                case VAL_TYPE:         result = create_string_value(gy, "type"); break;
+                case VAL_INSTANCE:     result = create_string_value(gy, AS_STRING(AS_INSTANCE(right)->type->name)->chars); break;
+                case VAL_NUMBER:
+                    if (is_integral_number(AS_NUMBER(right))) {
+                        result = create_string_value(gy, "integer");
+                    } else {
+                        result = create_string_value(gy, "float");
+                    }
+                    break;
+                default:
+                    result = create_string_value(gy, "unknown"); break;
+            }
+            break;
+        }
+
+        case CASTBOOLEAN: {
+            result = create_bool_value(!is_value_falsy(right));
+            break;
+        }
+
+        case CASTINTEGER: {
+            switch (VALUE_TYPE(right)) {
+                case VAL_NUMBER: result = create_number_value((int)AS_NUMBER(right)); break;
+                case VAL_BOOL:   result = create_number_value(AS_BOOL(right) ? 1 : 0); break;
+                case VAL_NULL:   result = create_number_value(0); break;
+                case VAL_STRING: {
+                    char* end;
+                    long val = strtol(AS_STRING(right)->chars, &end, 10);
+                    if (*end != '\0') {
+                        runtime_error(gy, line, "Cannot cast non-numeric string to integer");
+                    } else {
+                        result = create_number_value(val);
+                    }
+                    break;
+                }
+                default:
+                    runtime_error(gy, line, "Cannot cast this type to integer");
+                    break;
+            }
+            break;
+        }
+
+        case CASTFLOAT: {
+            switch (VALUE_TYPE(right)) {
+                case VAL_NUMBER: result = create_number_value((double)AS_NUMBER(right)); break;
+                case VAL_BOOL:   result = create_number_value(AS_BOOL(right) ? 1.0 : 0.0); break;
+                case VAL_NULL:   result = create_number_value(0.0); break;
+                case VAL_STRING: {
+                    char* end;
+                    double val = strtod(AS_STRING(right)->chars, &end);
+                    if (*end != '\0') {
+                        runtime_error(gy, line, "Cannot cast non-numeric string to float");
+                    } else {
+                        result = create_number_value(val);
+                    }
+                    break;
+                }
+                default:
+                    runtime_error(gy, line, "Cannot cast this type to float");
+                    break;
+            }
+            break;
+        }
+        
+        case CASTSTRING: {
+            char buffer[1024];
+            value_to_string(right, buffer, sizeof(buffer));
+            result = create_string_value(gy, buffer);
+            break;
+        }
+
+        case CASTARRAY: {
+            switch (VALUE_TYPE(right)) {
+                case VAL_ARRAY:       inc_ref(right); result = right; break;
+                case VAL_NULL:        result = create_array_value(gy); break;
+                case VAL_HASHTABLE: {
+                    GraveyardValue arr_val = create_array_value(gy);
+                    GraveyardHashtable* ht = AS_HASHTABLE(right);
+                    for (int i = 0; i < ht->capacity; i++) {
+                        if (ht->entries[i].is_in_use) {
+                            array_append(AS_ARRAY(arr_val), ht->entries[i].value);
+                        }
+                    }
+                    result = arr_val;
+                    break;
+                }
+                case VAL_STRING: {
+                    GraveyardValue arr_val = create_array_value(gy);
+                    GraveyardString* str = AS_STRING(right);
+                    for (size_t i = 0; i < str->length; i++) {
+                        char char_buf[2] = { str->chars[i], '\0' };
+                        array_append(AS_ARRAY(arr_val), create_string_value(gy, char_buf));
+                    }
+                    result = arr_val;
+                    break;
+                }
+                default: {
+                    GraveyardValue arr_val = create_array_value(gy);
+                    array_append(AS_ARRAY(arr_val), right);
+                    result = arr_val;
+                    break;
+                }
+            }
+            break;
+        }
+
+        case CASTHASHTABLE: {
+            switch (VALUE_TYPE(right)) {
+                case VAL_HASHTABLE:
+                    inc_ref(right);
+                    result = right;
+                    break;
+                case VAL_NULL:
+                    result = create_hashtable_value(gy);
+                    break;
+                case VAL_ARRAY: {
+                    GraveyardValue ht_val = create_hashtable_value(gy);
+                    GraveyardArray* arr = AS_ARRAY(right);
+                    bool cast_error = false;
+
+                    for (size_t i = 0; i < arr->count; i++) {
+                        GraveyardValue key = arr->values[i];
+                        
+                        bool is_valid_key = (VALUE_TYPE(key) == VAL_BOOL || VALUE_TYPE(key) == VAL_NULL || VALUE_TYPE(key) == VAL_STRING ||
+                                            (VALUE_TYPE(key) == VAL_NUMBER && is_integral_number(AS_NUMBER(key))));
+
+                        if (!is_valid_key) {
+                            runtime_error(gy, line, "Array contains an invalid type for a hashtable key");
+                            cast_error = true;
+                            break;
+                        }
+
+                        if (hashtable_find_entry(AS_HASHTABLE(ht_val)->entries, AS_HASHTABLE(ht_val)->capacity, key)->is_in_use) {
+                            runtime_error(gy, line, "Duplicate key found when casting array to hashtable");
+                            cast_error = true;
+                            break;
+                        }
+                        hashtable_set(gy, AS_HASHTABLE(ht_val), key, create_null_value());
+                    }
+
+                    if (cast_error) {
+                        dec_ref(gy, ht_val);
+                    } else {
+                        result = ht_val;
+                    }
+                    break;
+                }
+                default: {
+                    GraveyardValue key = right;
+                    bool is_valid_key = (VALUE_TYPE(key) == VAL_BOOL || VALUE_TYPE(key) == VAL_NULL || VALUE_TYPE(key) == VAL_STRING ||
+                                        (VALUE_TYPE(key) == VAL_NUMBER && is_integral_number(AS_NUMBER(key))));
+
+                    if (!is_valid_key) {
+                        runtime_error(gy, line, "Invalid type used as a hashtable key");
+                    } else {
+                        GraveyardValue ht_val = create_hashtable_value(gy);
+                        hashtable_set(gy, AS_HASHTABLE(ht_val), key, create_null_value());
+                        result = ht_val;
+                    }
+                    break;
+                }
+            }
+            break;
+        }
+
+        case ASTERISK: {
+            switch (VALUE_TYPE(right)) {
+                case VAL_STRING:    result = create_number_value(AS_STRING(right)->length); break;
+                case VAL_ARRAY:     result = create_number_value(AS_ARRAY(right)->count); break;
+                case VAL_HASHTABLE: result = create_number_value(AS_HASHTABLE(right)->count); break;
+                case VAL_NUMBER:    result = create_number_value(trunc(AS_NUMBER(right))); break;
+                case VAL_BOOL:      result = create_number_value(AS_BOOL(right) ? 1 : 0); break;
+                case VAL_NULL:      result = create_number_value(0); break;
+                default:
+                    runtime_error(gy, line, "This type does not have a length");
+                    break;
+            }
+            break;
+        }
+
+        case CARET: {
+            if (VALUE_TYPE(right) != VAL_HASHTABLE) {
+                runtime_error(gy, line, "The keys-of operator (^) can only be used on a hashtable");
+            } else {
+                GraveyardValue keys_array = create_array_value(gy);
+                GraveyardHashtable* ht = AS_HASHTABLE(right);
+                for (int i = 0; i < ht->capacity; i++) {
+                    if (ht->entries[i].is_in_use) {
+                        array_append(AS_ARRAY(keys_array), ht->entries[i].key);
+                    }
+                }
+                result = keys_array;
+            }
+            break;
+        }
+
+        case BACKTICK: {
+            if (VALUE_TYPE(right) != VAL_HASHTABLE) {
+                runtime_error(gy, line, "The values-of operator (`) can only be used on a hashtable");
+            } else {
+                GraveyardValue values_array = create_array_value(gy);
+                GraveyardHashtable* ht = AS_HASHTABLE(right);
+                for (int i = 0; i < ht->capacity; i++) {
+                    if (ht->entries[i].is_in_use) {
+                        array_append(AS_ARRAY(values_array), ht->entries[i].value);
+                    }
+                }
+                result = values_array;
+            }
+            break;
+        }
+
+        default:
+            runtime_error(gy, line, "Unknown unary operator");
+            break;
+    }
+
+    return result;
+}
+
+static void operand_to_text(GraveyardValue value, char* buffer, size_t buffer_size) {
+    if (VALUE_TYPE(value) == VAL_STRING) {
+        strncpy(buffer, AS_STRING(value)->chars, buffer_size - 1);
+        buffer[buffer_size - 1] = '\0';
+    } else {
+        value_to_string(value, buffer, buffer_size);
+    }
+}
+
+static GraveyardValue concat_into_scratch(Graveyard* gy, GraveyardValue left, GraveyardValue right) {
+    char left_text[1024];
+    char right_text[1024];
+    operand_to_text(left, left_text, sizeof(left_text));
+    operand_to_text(right, right_text, sizeof(right_text));
+
+    size_t left_length = strlen(left_text);
+    size_t right_length = strlen(right_text);
+    GraveyardString* string_obj = create_scratch_string(gy, left_length + right_length);
+    memcpy(string_obj->chars, left_text, left_length);
+    memcpy(string_obj->chars + left_length, right_text, right_length);
+    return OBJECT_VALUE(VAL_STRING, string_obj);
+}
+
+static GraveyardValue evaluate_binary_op(Graveyard* gy, GraveyardTokenType op_type, GraveyardValue left, GraveyardValue right, int line) {
+    GraveyardValue result = create_null_value();
+
+    if (op_type == REFERENCE) {
+        if (VALUE_TYPE(left) != VAL_HASHTABLE) {
+            runtime_error(gy, line, "The '#' operator can only be used on a hashtable");
+        } else {
+            GraveyardHashtable* ht = AS_HASHTABLE(left);
+            HashtableEntry* entry = hashtable_find_entry(ht->entries, ht->capacity, right);
+            if (entry->is_in_use) {
+                inc_ref(entry->value);
+                result = entry->value;
+            }
+        }
+    } else if (op_type == FILEOUT) {
+        if (VALUE_TYPE(left) != VAL_STRING) {
+            runtime_error(gy, line, "Content for file write operation must be a string");
+        } else if (VALUE_TYPE(right) != VAL_STRING) {
+            runtime_error(gy, line, "File path for write operation must be a string");
+        } else {
+            FILE* file = fopen(AS_STRING(right)->chars, "w");
+            if (!file) {
+                runtime_error(gy, line, "Cannot open or create file '%s' for writing", AS_STRING(right)->chars);
+            } else {
+                fprintf(file, "%s", AS_STRING(left)->chars);
+                fclose(file);
+            }
+        }
+    } else if (op_type == EQUALITY) {
+        result = create_bool_value(are_values_equal(left, right));
+    } else if (op_type == INEQUALITY) {
+        result = create_bool_value(!are_values_equal(left, right));
+    } else if (op_type == XOR) {
+        bool left_is_truthy = !is_value_falsy(left);
+        bool right_is_truthy = !is_value_falsy(right);
+        result = create_bool_value(left_is_truthy != right_is_truthy);
+    } else if (op_type == PLUS) {
+        if (VALUE_TYPE(left) == VAL_ARRAY) {
+            GraveyardValue new_array_val = create_array_value(gy);
+            for (size_t i = 0; i < AS_ARRAY(left)->count; i++) {
+                array_append(AS_ARRAY(new_array_val), AS_ARRAY(left)->values[i]);
+            }
+            array_append(AS_ARRAY(new_array_val), right);
+            result = new_array_val;
+        } else if (VALUE_TYPE(left) == VAL_NUMBER && VALUE_TYPE(right) == VAL_NUMBER) {
+            result = create_number_value(AS_NUMBER(left) + AS_NUMBER(right));
+        } else if (VALUE_TYPE(left) == VAL_STRING || VALUE_TYPE(right) == VAL_STRING) {
+            char left_str_temp[1024];
+            char right_str_temp[1024];
+            operand_to_text(left, left_str_temp, sizeof(left_str_temp));
+            operand_to_text(right, right_str_temp, sizeof(right_str_temp));
+
+            size_t total_len = strlen(left_str_temp) + strlen(right_str_temp);
+            char* result_buffer = malloc(total_len + 1);
+
+            if (!result_buffer) {
+                runtime_error(gy, line, "Memory allocation failed for string concatenation");
+            } else {
+                strcpy(result_buffer, left_str_temp);
+                strcat(result_buffer, right_str_temp);
+                
+                result = create_string_value(gy, result_buffer);
+                free(result_buffer);
+            }
+        } else {
+            runtime_error(gy, line, "Operands have incompatible types for '+' operation");
+        }
+    } else if (op_type == FORWARDSLASH && (VALUE_TYPE(left) == VAL_STRING || VALUE_TYPE(right) == VAL_STRING)) {
+        char left_str_temp[1024];
+        char right_str_temp[1024];
+        operand_to_text(left, left_str_temp, sizeof(left_str_temp));
+        operand_to_text(right, right_str_temp, sizeof(right_str_temp));
+
+        size_t left_len = strlen(left_str_temp);
+        while (left_len > 0 && (left_str_temp[left_len - 1] == '/' || left_str_temp[left_len - 1] == '\\')) {
+            left_str_temp[--left_len] = '\0';
+        }
+        
+        size_t right_offset = 0;
+        while (right_str_temp[right_offset] == '/' || right_str_temp[right_offset] == '\\') {
+            right_offset++;
+        }
+        
+        size_t total_len = strlen(left_str_temp) + strlen(right_str_temp + right_offset) + 1;
+        char* result_buffer = malloc(total_len + 1);
+
+        if (!result_buffer) {
+            runtime_error(gy, line, "Memory allocation failed for path joining");
+        } else {
+            snprintf(result_buffer, total_len + 1, "%s/%s", left_str_temp, right_str_temp + right_offset);
+            
+            result = create_string_value(gy, result_buffer);
+            free(result_buffer);
+        }
+    } else {
+        if (VALUE_TYPE(left) != VAL_NUMBER || VALUE_TYPE(right) != VAL_NUMBER) {
+            runtime_error(gy, line, "Operands must be numbers for this operation");
+        } else {
+            switch (op_type) {
+                case MINUS:          result = create_number_value(AS_NUMBER(left) - AS_NUMBER(right)); break;
+                case ASTERISK:       result = create_number_value(AS_NUMBER(left) * AS_NUMBER(right)); break;
+                case EXPONENTIATION: result = create_number_value(pow(AS_NUMBER(left), AS_NUMBER(right))); break;
+                case FORWARDSLASH:
+                    if (AS_NUMBER(right) == 0) { runtime_error(gy, line, "Division by zero"); }
+                    else { result = create_number_value(AS_NUMBER(left) / AS_NUMBER(right)); }
+                    break;
+                case MODULO:
+                    if (AS_NUMBER(right) == 0) { runtime_error(gy, line, "Division by zero in modulo operation"); }
+                    else { result = create_number_value(number_modulo(AS_NUMBER(left), AS_NUMBER(right))); }
+                    break;
+                case RIGHTANGLEBRACKET:      result = create_bool_value(AS_NUMBER(left) > AS_NUMBER(right)); break;
+                case LEFTANGLEBRACKET: result = create_bool_value(AS_NUMBER(left) < AS_NUMBER(right)); break;
+                case GREATERTHANEQUAL: result = create_bool_value(AS_NUMBER(left) >= AS_NUMBER(right)); break;
+                case LESSTHANEQUAL:    result = create_bool_value(AS_NUMBER(left) <= AS_NUMBER(right)); break;
+                default: break;
+            }
+        }
+    }
+
+    return result;
+}
+
+static BinarySpecialization select_binary_specialization(GraveyardTokenType op_type, GraveyardValue left, GraveyardValue right) {
+    if (VALUE_TYPE(left) == VAL_NUMBER && VALUE_TYPE(right) == VAL_NUMBER) {
+        switch (op_type) {
+            case PLUS:              return BINARY_NUMBER_ADD;
+            case MINUS:             return BINARY_NUMBER_SUBTRACT;
+            case ASTERISK:          return BINARY_NUMBER_MULTIPLY;
+            case FORWARDSLASH:      return BINARY_NUMBER_DIVIDE;
+            case MODULO:            return BINARY_NUMBER_MODULO;
+            case LEFTANGLEBRACKET:  return BINARY_NUMBER_LESS;
+            case RIGHTANGLEBRACKET: return BINARY_NUMBER_GREATER;
+            case LESSTHANEQUAL:     return BINARY_NUMBER_LESS_EQUAL;
+            case GREATERTHANEQUAL:  return BINARY_NUMBER_GREATER_EQUAL;
+            case EQUALITY:          return BINARY_NUMBER_EQUAL;
+            case INEQUALITY:        return BINARY_NUMBER_NOT_EQUAL;
+            default:                return BINARY_GENERIC;
+        }
+    }
+    if (op_type == PLUS && VALUE_TYPE(left) == VAL_STRING && VALUE_TYPE(right) == VAL_STRING) {
+        return BINARY_STRING_CONCAT;
+    }
+    if (op_type == REFERENCE && VALUE_TYPE(left) == VAL_HASHTABLE) {
+        return BINARY_HASHTABLE_REFERENCE;
+    }
+    return BINARY_GENERIC;
+}
+
+static GraveyardValue concat_strings(Graveyard* gy, GraveyardString* left, GraveyardString* right) {
+    size_t left_length = left->length < 1023 ? left->length : 1023;
+    size_t right_length = right->length < 1023 ? right->length : 1023;
+
+    GraveyardString* string_obj = slab_alloc(&gy->slabs, SLAB_STRING, sizeof(GraveyardString) + left_length + right_length + 1);
+    string_obj->chars = (char*)(string_obj + 1);
+    memcpy(string_obj->chars, left->chars, left_length);
+    memcpy(string_obj->chars + left_length, right->chars, right_length);
+    string_obj->chars[left_length + right_length] = '\0';
+    string_obj->length = left_length + right_length;
+    string_obj->ref_count = 1;
+    string_obj->is_scratch = false;
+
+    return OBJECT_VALUE(VAL_STRING, string_obj);
+}
+
+static GraveyardValue execute_binary_node(Graveyard* gy, AstNode* node, GraveyardValue left, GraveyardValue right) {
+    AstNodeBinaryOp* binary = &node->as.binary_op;
+
+    switch (binary->specialization) {
+        case BINARY_UNSPECIALIZED:
+            if (++binary->executions >= QUICKEN_THRESHOLD) {
+                binary->specialization = select_binary_specialization(binary->operator.type, left, right);
+                if (binary->specialization != BINARY_GENERIC) {
+                    gy->specialized_node_count++;
+                }
+            }
+            break;
+        case BINARY_GENERIC:
+            break;
+        case BINARY_STRING_CONCAT:
+            if (VALUE_TYPE(left) == VAL_STRING && VALUE_TYPE(right) == VAL_STRING) {
+                return concat_strings(gy, AS_STRING(left), AS_STRING(right));
+            }
+            goto deoptimize;
+        case BINARY_HASHTABLE_REFERENCE:
+            if (VALUE_TYPE(left) == VAL_HASHTABLE) {
+                GraveyardHashtable* ht = AS_HASHTABLE(left);
+                HashtableEntry* entry = hashtable_find_entry(ht->entries, ht->capacity, right);
+                if (!entry->is_in_use) return create_null_value();
+                inc_ref(entry->value);
+                return entry->value;
+            }
+            goto deoptimize;
+        default:
+            if (VALUE_TYPE(left) != VAL_NUMBER || VALUE_TYPE(right) != VAL_NUMBER) goto deoptimize;
+            switch (binary->specialization) {
+                case BINARY_NUMBER_ADD:           return create_number_value(AS_NUMBER(left) + AS_NUMBER(right));
+                case BINARY_NUMBER_SUBTRACT:      return create_number_value(AS_NUMBER(left) - AS_NUMBER(right));
+                case BINARY_NUMBER_MULTIPLY:      return create_number_value(AS_NUMBER(left) * AS_NUMBER(right));
+                case BINARY_NUMBER_DIVIDE:
+                    if (AS_NUMBER(right) == 0) break;
+                    return create_number_value(AS_NUMBER(left) / AS_NUMBER(right));
+                case BINARY_NUMBER_MODULO:
+                    if (AS_NUMBER(right) == 0) break;
+                    return create_number_value(number_modulo(AS_NUMBER(left), AS_NUMBER(right)));
+                case BINARY_NUMBER_LESS:          return create_bool_value(AS_NUMBER(left) < AS_NUMBER(right));
+                case BINARY_NUMBER_GREATER:       return create_bool_value(AS_NUMBER(left) > AS_NUMBER(right));
+                case BINARY_NUMBER_LESS_EQUAL:    return create_bool_value(AS_NUMBER(left) <= AS_NUMBER(right));
+                case BINARY_NUMBER_GREATER_EQUAL: return create_bool_value(AS_NUMBER(left) >= AS_NUMBER(right));
+                case BINARY_NUMBER_EQUAL:         return create_bool_value(AS_NUMBER(left) == AS_NUMBER(right));
+                case BINARY_NUMBER_NOT_EQUAL:     return create_bool_value(AS_NUMBER(left) != AS_NUMBER(right));
+                default:                          break;
+            }
+            break;
+    }
+
+    return evaluate_binary_op(gy, binary->operator.type, left, right, node->line);
+
+deoptimize:
+    binary->specialization = BINARY_GENERIC;
+    gy->deoptimized_node_count++;
+    return evaluate_binary_op(gy, binary->operator.type, left, right, node->line);
+}
+
+static GraveyardValue subscript_value(Graveyard* gy, GraveyardValue array_val, GraveyardValue index_val, int line) {
+    if (VALUE_TYPE(index_val) != VAL_NUMBER) {
+        runtime_error(gy, line, "Array index must be an integer");
+        return create_null_value();
+    }
+    
+    double raw_index = AS_NUMBER(index_val);
+    int64_t index;
+    if (raw_index < 0 || !number_to_int64(raw_index, &index)) {
+        runtime_error(gy, line, "Array index must be a non-negative integer");
+        return create_null_value();
+    }
+    
+    GraveyardArray* array = AS_ARRAY(array_val);
+
+    if (index >= (int64_t)array->count) {
+        runtime_error(gy, line, "Array index out of bounds (index %lld is beyond array of size %zu)", (long long)index, array->count);
+        return create_null_value();
+    }
+
+    GraveyardValue result = array->values[index];
+    inc_ref(result);
+    return result;
+}
+
+static int member_cache_slot(GraveyardInstance* instance, AstNode* node) {
+    MemberCache* cache = &node->as.member_access.cache;
+    if (cache->shape != instance->shape) {
+        cache->shape = instance->shape;
+        cache->slot = shape_find_slot(instance->shape, node->as.member_access.member.symbol);
+    }
+    return cache->slot;
+}
+
+static bool instance_method(GraveyardValue object, AstNode* node, GraveyardValue* out_method) {
+    if (VALUE_TYPE(object) != VAL_INSTANCE) return false;
+    GraveyardInstance* instance = AS_INSTANCE(object);
+    if (member_cache_slot(instance, node) >= 0) return false;
+    return monolith_get(&instance->type->methods, node->as.member_access.member.symbol, out_method);
+}
+
+static GraveyardValue member_access_value(Graveyard* gy, GraveyardValue object, AstNode* node) {
+    GraveyardValue result = create_null_value();
+    Symbol* member_name = node->as.member_access.member.symbol;
+    int line = node->line;
+
+    if (VALUE_TYPE(object) == VAL_INSTANCE) {
+        GraveyardInstance* instance = AS_INSTANCE(object);
+        int slot = member_cache_slot(instance, node);
+        GraveyardValue member_val;
+
+        if (slot >= 0) {
+            member_val = instance->fields[slot];
+            inc_ref(member_val);
+            result = member_val;
+        } 
+        else if (monolith_get(&instance->type->methods, member_name, &member_val)) {
+            GraveyardBoundMethod* bound = slab_alloc(&gy->slabs, SLAB_BOUND_METHOD, sizeof(GraveyardBoundMethod));
+            
+            bound->ref_count = 1;
+            bound->gc.color = GC_BLACK;
+            bound->gc.buffered = false;
+            gc_note_allocation(gy);
+            bound->receiver = object;
+            bound->function = member_val;
+            
+            inc_ref(bound->receiver);
+            inc_ref(bound->function);
+            
+            result = OBJECT_VALUE(VAL_BOUND_METHOD, bound);
+        } else {
+            runtime_error(gy, line, "Member '%s' not found on instance", member_name->chars);
+        }
+    } 
+    else if (VALUE_TYPE(object) == VAL_TYPE) {
+        GraveyardType* type = AS_TYPE(object);
+        GraveyardValue field_value;
+        if (monolith_get(&type->fields, member_name, &field_value)) {
+            inc_ref(field_value);
+            result = field_value;
+        } else {
+            runtime_error(gy, line, "Field '%s' not found or not yet defined in this type", member_name->chars);
+        }
+    } 
+    else {
+        runtime_error(gy, line, "Can only access members on an instance or type");
+    }
+
+    return result;
+}
+
+static GraveyardValue evaluate_borrowed(Graveyard* gy, AstNode* node, bool* owned) {
+    GraveyardValue value;
+    if (node->type == AST_IDENTIFIER &&
+        resolved_get(gy, &node->as.identifier.resolution, node->as.identifier.name.symbol, &value)) {
+        *owned = false;
+        return value;
+    }
+    if (node->type == AST_THIS_EXPRESSION &&
+        resolved_get(gy, &node->as.this_expression.resolution, gy->this_symbol, &value)) {
+        *owned = false;
+        return value;
+    }
+    *owned = true;
+    return execute_node(gy, node);
+}
+
+static inline void release_operand(Graveyard* gy, GraveyardValue value, bool owned) {
+    if (owned) dec_ref(gy, value);
+}
+
+static inline GraveyardValue own_operand(GraveyardValue value, bool owned) {
+    if (!owned) inc_ref(value);
+    return value;
+}
+
+static bool evaluation_is_pure(AstNode* node) {
+    return node->type == AST_IDENTIFIER || node->type == AST_LITERAL || node->type == AST_THIS_EXPRESSION;
+}
+
+static bool prepare_call(Graveyard* gy, AstNode* node, PendingCall* call) {
+    AstNode* callee_node = node->as.call_expression.callee;
+    GraveyardValue receiver = create_null_value();
+    GraveyardValue callee;
+
+    if (callee_node->type == AST_MEMBER_ACCESS) {
+        GraveyardValue object = execute_node(gy, callee_node->as.member_access.object);
+        if (instance_method(object, callee_node, &callee)) {
+            inc_ref(callee);
+            receiver = object;
+        } else {
+            callee = member_access_value(gy, object, callee_node);
+            dec_ref(gy, object);
+        }
+    } else {
+        callee = execute_node(gy, callee_node);
+    }
+
+    GraveyardFunction* function;
+    Environment* call_environment;
+
+    if (VALUE_TYPE(callee) == VAL_FUNCTION) {
+        function = AS_FUNCTION(callee);
+        call_environment = environment_acquire(gy, function->closure, function->body->as.block.layout);
+        if (VALUE_TYPE(receiver) != VAL_NULL) {
+            environment_define(gy, call_environment, gy->this_symbol, receiver);
+        }
+    } else if (VALUE_TYPE(callee) == VAL_BOUND_METHOD) {
+        GraveyardBoundMethod* bound = AS_BOUND_METHOD(callee);
+        function = AS_FUNCTION(bound->function);
+        
+        call_environment = environment_acquire(gy, function->closure, function->body->as.block.layout);
+        environment_define(gy, call_environment, gy->this_symbol, bound->receiver);
+    } else {
+        runtime_error(gy, node->line, "Can only call functions and methods");
+        dec_ref(gy, callee);
+        dec_ref(gy, receiver);
+        return false;
+    }
+
+    int arg_count = node->as.call_expression.arg_count;
+
+    if (arg_count != function->arity) {
+        runtime_error(gy, node->line, "Expected %d arguments but got %d", function->arity, arg_count);
+        environment_release(gy, call_environment);
+        dec_ref(gy, callee);
+        dec_ref(gy, receiver);
+        return false;
+    }
+    
+    for (int i = 0; i < function->arity; i++) {
+        bool arg_owned;
+        GraveyardValue arg_value = evaluate_borrowed(gy, node->as.call_expression.arguments[i], &arg_owned);
+        environment_define_parameter(gy, call_environment, function, i, arg_value);
+        release_operand(gy, arg_value, arg_owned);
+    }
+
+    call->function = function;
+    call->environment = call_environment;
+    call->callee = callee;
+    call->receiver = receiver;
+    return true;
+}
+
+static bool closure_captures(GraveyardFunction* function, Environment* environment) {
+    if (environment == NULL) return false;
+    for (Environment* env = function->closure; env != NULL; env = env->enclosing) {
+        if (env == environment) return true;
+    }
+    return false;
+}
+
+static bool jit_invoke(Graveyard* gy, GraveyardFunction* function, Environment* environment);
+
+static bool capture_memo_key(PendingCall* call, GraveyardValue* key) {
+    GraveyardFunction* function = call->function;
+    if (VALUE_TYPE(call->callee) != VAL_FUNCTION || VALUE_TYPE(call->receiver) != VAL_NULL) {
+        return false;
+    }
+    for (int i = 0; i < function->arity; i++) {
+        key[i] = environment_parameter(call->environment, function, i);
+        if (!memo_value_cacheable(key[i])) return false;
+    }
+    for (int i = 0; i < function->arity; i++) {
+        inc_ref(key[i]);
+    }
+    return true;
+}
+
+static void native_stack_init(Graveyard* gy) {
+    char marker;
+    size_t size = 1024 * 1024;
+#ifndef _WIN32
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_STACK, &limit) == 0) {
+        size = limit.rlim_cur == RLIM_INFINITY ? CALL_STACK_DEFAULT_SIZE : (size_t)limit.rlim_cur;
+    }
+#endif
+    size_t total = gy->stack_limit != 0 ? gy->stack_limit : size * CALL_STACK_LIMIT_FACTOR;
+    if (size > total) size = total;
+
+    gy->stack_base = (uintptr_t)&marker;
+    gy->stack_budget = size > 2 * CALL_STACK_RESERVE ? size - 2 * CALL_STACK_RESERVE : size / 2;
+    size_t segments = (total - size) / CALL_STACK_SEGMENT_SIZE;
+    gy->stack_segment_limit = segments < CALL_STACK_MAX_SEGMENTS ? (int)segments : CALL_STACK_MAX_SEGMENTS;
+    gy->vm_frame_limit = total / CALL_FRAME_STACK_COST;
+}
+
+static void stack_segments_release(Graveyard* gy, int first) {
+#ifdef GRAVEYARD_STACK_SEGMENTS
+    for (int i = first; i < CALL_STACK_MAX_SEGMENTS && gy->stack_segments[i] != NULL; i++) {
+        StackSegment* segment = gy->stack_segments[i];
+        if (!segment->dirty) break;
+        madvise(segment->memory, CALL_STACK_SEGMENT_SIZE, MADV_DONTNEED);
+        segment->dirty = false;
+    }
+#endif
+}
+
+#ifdef GRAVEYARD_STACK_SEGMENTS
+static void stack_segment_entry(unsigned int low, unsigned int high) {
+    StackSegment* segment = (StackSegment*)(((uintptr_t)high << 32) | low);
+    dec_ref(segment->gy, execute_block(segment->gy, segment->call->function->body, segment->call->environment));
+}
+
+static StackSegment* stack_segment_acquire(Graveyard* gy) {
+    StackSegment* segment = gy->stack_segments[gy->stack_segment_depth];
+    if (segment != NULL) return segment;
+
+    void* memory = mmap(NULL, CALL_STACK_SEGMENT_SIZE, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK, -1, 0);
+    if (memory == MAP_FAILED) return NULL;
+    segment = malloc(sizeof(StackSegment));
+    if (!segment) {
+        perror("stack_segment_acquire: malloc failed");
+        exit(1);
+    }
+    segment->memory = memory;
+    segment->dirty = false;
+    gy->stack_segments[gy->stack_segment_depth] = segment;
+    return segment;
+}
+
+static bool run_on_stack_segment(Graveyard* gy, PendingCall* call) {
+    if (gy->stack_segment_depth >= gy->stack_segment_limit) return false;
+    StackSegment* segment = stack_segment_acquire(gy);
+    if (segment == NULL) return false;
+
+    segment->gy = gy;
+    segment->call = call;
+    segment->dirty = true;
+    getcontext(&segment->context);
+    segment->context.uc_stack.ss_sp = segment->memory;
+    segment->context.uc_stack.ss_size = CALL_STACK_SEGMENT_SIZE;
+    segment->context.uc_link = &segment->caller;
+    uintptr_t address = (uintptr_t)segment;
+    makecontext(&segment->context, (void (*)(void))stack_segment_entry, 2,
+                (unsigned int)address, (unsigned int)(address >> 32));
+
+    uintptr_t saved_base = gy->stack_base;
+    size_t saved_budget = gy->stack_budget;
+    gy->stack_base = (uintptr_t)segment->memory + CALL_STACK_SEGMENT_SIZE;
+    gy->stack_budget = CALL_STACK_SEGMENT_SIZE - CALL_STACK_RESERVE;
+    gy->stack_segment_depth++;
+    swapcontext(&segment->caller, &segment->context);
+    gy->stack_segment_depth--;
+    stack_segments_release(gy, gy->stack_segment_depth + 1);
+    gy->stack_base = saved_base;
+    gy->stack_budget = saved_budget;
+    return true;
+}
+#endif
+
+static void run_call_body(Graveyard* gy, PendingCall* call) {
+    char marker;
+    if (gy->stack_base == 0 || gy->stack_base - (uintptr_t)&marker < gy->stack_budget) {
+        dec_ref(gy, execute_block(gy, call->function->body, call->environment));
+        return;
+    }
+#ifdef GRAVEYARD_STACK_SEGMENTS
+    if (run_on_stack_segment(gy, call)) return;
+#endif
+    runtime_error(gy, call->function->body->line, "Maximum recursion depth exceeded");
+}
+
+static GraveyardValue complete_call(Graveyard* gy, PendingCall* call) {
+    MemoCache* memo = call->function->memo;
+    GraveyardValue memo_key[MEMO_MAX_ARITY];
+    uint32_t memo_hash = 0;
+    if (memo != NULL && !capture_memo_key(call, memo_key)) {
+        memo = NULL;
+    }
+    if (memo != NULL) {
+        GraveyardValue cached;
+        memo_hash = memo_hash_key(memo_key, memo->arity);
+        if (memo_cache_lookup(memo, memo_hash, memo_key, &cached)) {
+            memo->declaration->as.function_declaration.memo_hits++;
+            for (int i = 0; i < memo->arity; i++) {
+                dec_ref(gy, memo_key[i]);
+            }
+            environment_release(gy, call->environment);
+            dec_ref(gy, call->callee);
+            dec_ref(gy, call->receiver);
+            return cached;
+        }
+        memo->declaration->as.function_declaration.memo_misses++;
+    }
+
+    Environment* previous_call_environment = gy->call_environment;
+
+    for (;;) {
+        gy->call_environment = call->environment;
+        if (!gy->jit_enabled || !jit_invoke(gy, call->function, call->environment)) {
+            run_call_body(gy, call);
+        }
+
+        environment_release(gy, call->environment);
+        dec_ref(gy, call->callee);
+        dec_ref(gy, call->receiver);
+
+        if (!gy->has_tail_call) break;
+        *call = gy->tail_call;
+        gy->has_tail_call = false;
+        gy->is_returning = false;
+    }
+    gy->call_environment = previous_call_environment;
+
+    GraveyardValue result = create_null_value();
+    if (gy->is_returning) {
+        result = gy->return_value;
+        gy->is_returning = false;
+        gy->return_value = create_null_value(); 
+    }
+
+    if (memo != NULL) {
+        if (gy->had_runtime_error || !memo_value_cacheable(result)) {
+            for (int i = 0; i < memo->arity; i++) {
+                dec_ref(gy, memo_key[i]);
+            }
+        } else {
+            memo_cache_store(gy, memo, memo_hash, memo_key, result);
+        }
+    }
+    return result;
+}
+
+bool execute(Graveyard *gy);
+bool optimize(Graveyard* gy);
+
+static GraveyardValue execute_unknown(Graveyard* gy, AstNode* node) {
+    return create_null_value();
+}
+
+static GraveyardValue execute_program(Graveyard* gy, AstNode* node) {
+    GraveyardValue last_value = create_null_value();
+    for (size_t i = 0; i < node->as.program.count; i++) {
+        dec_ref(gy, last_value);
+
+        last_value = execute_node(gy, node->as.program.statements[i]);
+        gc_safepoint(gy);
+        if (gy->had_runtime_error) {
+            break;
+        }
+    }
+    return last_value;
+}
+
+static GraveyardValue execute_print_statement(Graveyard* gy, AstNode* node) {
+    for (size_t i = 0; i < node->as.print_stmt.count; i++) {
+        bool owned;
+        GraveyardValue value = evaluate_borrowed(gy, node->as.print_stmt.expressions[i], &owned);
+        if (gy->had_runtime_error) {
+            release_operand(gy, value, owned);
+            return create_null_value();
+        }
+        print_value(gy, value);
+
+        release_operand(gy, value, owned);
+
+        if (i < node->as.print_stmt.count - 1) {
+            printf(" ");
+        }
+    }
+    if (!gy->had_runtime_error) {
+        printf("\n");
+    }
+    return create_null_value();
+}
+
+static GraveyardValue execute_scan_statement(Graveyard* gy, AstNode* node) {
+    GraveyardValue prompt = execute_node(gy, node->as.scan_statement.prompt);
+    print_value(gy, prompt);
+    fflush(stdout);
+    dec_ref(gy, prompt);
+
+    char input_buffer[1024];
+    if (fgets(input_buffer, sizeof(input_buffer), stdin)) {
+        input_buffer[strcspn(input_buffer, "\n")] = 0;
+
+        GraveyardValue input_val = create_string_value(gy, input_buffer);
+        environment_define(gy, gy->environment, node->as.scan_statement.variable.symbol, input_val);
+        dec_ref(gy, input_val);
+    }
+    return create_null_value();
+}
+
+static GraveyardValue execute_literal(Graveyard* gy, AstNode* node) {
+    switch (node->as.literal.value.type) {
+        case TYPE: {
+            Symbol* type_name = node->as.literal.value.symbol;
+
+            GraveyardValue type_val;
+            if (!environment_get(gy->environment, type_name, &type_val)) {
+                runtime_error(gy, node->line, "Type <%s> is not defined", type_name->chars);
+                return create_null_value();
+            }
+            if (VALUE_TYPE(type_val) != VAL_TYPE) {
+                runtime_error(gy, node->line, "<%s> is not a type", type_name->chars);
+                return create_null_value();
+            }
+
+            return create_instance_value(gy, type_val);
+        }
+        case STRING: {
+            GraveyardValue string_val = OBJECT_VALUE(VAL_STRING, node->as.literal.string);
+            inc_ref(string_val);
+            return string_val;
+        }
+        case NUMBER:
+            return create_number_value(node->as.literal.number);
+        case TRUEVALUE:
+            return create_bool_value(true);
+        case FALSEVALUE:
+            return create_bool_value(false);
+        case NULLVALUE:
+            return create_null_value();
+        default:
+            return create_null_value();
+    }
+
+    return create_null_value();
+}
+
+static GraveyardValue execute_array_literal(Graveyard* gy, AstNode* node) {
+    GraveyardValue array_val = node->allocates_scratch ? create_scratch_array(gy, node->as.array_literal.count) : create_array_value(gy);
+
+    for (size_t i = 0; i < node->as.array_literal.count; i++) {
+        GraveyardValue element_value = execute_node(gy, node->as.array_literal.elements[i]);
+        array_append(AS_ARRAY(array_val), element_value);
+
+        dec_ref(gy, element_value);
+    }
+
+    return array_val;
+}
+
+static GraveyardValue execute_subscript(Graveyard* gy, AstNode* node) {
+    bool array_owned = true;
+    GraveyardValue array_val = evaluation_is_pure(node->as.subscript.index)
+        ? evaluate_borrowed(gy, node->as.subscript.array, &array_owned)
+        : execute_node(gy, node->as.subscript.array);
+    if (VALUE_TYPE(array_val) != VAL_ARRAY) {
+        runtime_error(gy, node->line, "Only arrays are subscriptable");
+        release_operand(gy, array_val, array_owned);
+        return create_null_value();
+    }
+
+    bool index_owned;
+    GraveyardValue index_val = evaluate_borrowed(gy, node->as.subscript.index, &index_owned);
+    GraveyardValue result = subscript_value(gy, array_val, index_val, node->line);
+
+    release_operand(gy, array_val, array_owned);
+    release_operand(gy, index_val, index_owned);
+
+    return result;
+}
+
+static GraveyardValue execute_hashtable_literal(Graveyard* gy, AstNode* node) {
+    GraveyardValue ht_val = node->allocates_scratch ? create_scratch_hashtable(gy, node->as.hashtable_literal.count) : create_hashtable_value(gy);
+    GraveyardHashtable* ht = AS_HASHTABLE(ht_val);
+
+    for (size_t i = 0; i < node->as.hashtable_literal.count; i++) {
+        AstNodeKeyValuePair pair = node->as.hashtable_literal.pairs[i];
+        GraveyardValue key = execute_node(gy, pair.key);
+
+        bool is_valid_key = (VALUE_TYPE(key) == VAL_STRING || VALUE_TYPE(key) == VAL_NUMBER ||
+                            VALUE_TYPE(key) == VAL_BOOL || VALUE_TYPE(key) == VAL_NULL);
+        bool is_integer = (VALUE_TYPE(key) != VAL_NUMBER || is_integral_number(AS_NUMBER(key)));
+
+        if (!is_valid_key) {
+            runtime_error(gy, node->line, "Invalid type used as a hashtable key");
+            dec_ref(gy, ht_val);
+            dec_ref(gy, key);
+            return create_null_value();
+        }
+        if (!is_integer) {
+            runtime_error(gy, node->line, "Cannot use float as hashtable key");
+            dec_ref(gy, ht_val);
+            dec_ref(gy, key);
+            return create_null_value();
+        }
+
+        GraveyardValue value = execute_node(gy, pair.value);
+        hashtable_set(gy, ht, key, value);
+
+        dec_ref(gy, key);
+        dec_ref(gy, value);
+    }
+    return ht_val;
+}
+
+static GraveyardValue execute_identifier(Graveyard* gy, AstNode* node) {
+    GraveyardValue value;
+    if (resolved_get(gy, &node->as.identifier.resolution, node->as.identifier.name.symbol, &value)) {
+        inc_ref(value);
+        return value;
+    }
+
+    runtime_error(gy, node->line, "Undefined variable '%s'", node->as.identifier.name.lexeme);
+    return create_null_value();
+}
+
+static GraveyardValue execute_expression_statement(Graveyard* gy, AstNode* node) {
+    return execute_node(gy, node->as.expression_statement.expression);
+}
+
+static GraveyardValue execute_assignment(Graveyard* gy, AstNode* node) {
+    AstNode* target_node = node->as.assignment.left;
+    GraveyardValue value_to_assign = execute_node(gy, node->as.assignment.value);
+
+    if (target_node->type == AST_IDENTIFIER) {
+        resolved_assign(gy, &target_node->as.identifier.resolution, target_node->as.identifier.name.symbol, value_to_assign);
+        return value_to_assign;
+
+    } else if (target_node->type == AST_SUBSCRIPT) {
+        AstNode* array_node = target_node->as.subscript.array;
+        AstNode* index_node = target_node->as.subscript.index;
+
+        GraveyardValue array_val = execute_node(gy, array_node);
+        if (VALUE_TYPE(array_val) != VAL_ARRAY) {
+            runtime_error(gy, target_node->line, "Cannot assign to subscript '[]' of a non-array type");
+            dec_ref(gy, value_to_assign);
+            dec_ref(gy, array_val);
+            return create_null_value();
+        }
+
+        GraveyardValue index_val = execute_node(gy, index_node);
+        if (VALUE_TYPE(index_val) != VAL_NUMBER) {
+            runtime_error(gy, index_node->line, "Array index must be a number");
+            dec_ref(gy, value_to_assign);
+            dec_ref(gy, array_val);
+            dec_ref(gy, index_val);
+            return create_null_value();
+        }
+
+        double raw_index = AS_NUMBER(index_val);
+        int64_t index;
+        if (raw_index < 0 || !number_to_int64(raw_index, &index)) {
+            runtime_error(gy, index_node->line, "Array index must be a non-negative integer");
+            dec_ref(gy, value_to_assign);
+            dec_ref(gy, array_val);
+            dec_ref(gy, index_val);
+            return create_null_value();
+        }
+
+        GraveyardArray* array = AS_ARRAY(array_val);
+
+        if (index >= (int64_t)array->count) {
+            runtime_error(gy, target_node->line, "Array index out of bounds...");
+            dec_ref(gy, array_val);
+            dec_ref(gy, index_val);
+            dec_ref(gy, value_to_assign);
+            return create_null_value();
+        }
+
+        dec_ref(gy, array->values[index]);
+
+        inc_ref(value_to_assign);
+        array->values[index] = value_to_assign;
+
+        dec_ref(gy, array_val);
+        dec_ref(gy, index_val);
+
+        return value_to_assign;
+    } else if (target_node->type == AST_BINARY_OP && target_node->as.binary_op.operator.type == REFERENCE) {
+        AstNode* ht_node = target_node->as.binary_op.left;
+        AstNode* key_node = target_node->as.binary_op.right;
+
+        GraveyardValue ht_val = execute_node(gy, ht_node);
+        if (VALUE_TYPE(ht_val) != VAL_HASHTABLE) {
+            runtime_error(gy, ht_node->line, "Cannot assign to key of a non-hashtable type");
+            dec_ref(gy, value_to_assign);
+            dec_ref(gy, ht_val);
+            return create_null_value();
+        }
+
+        GraveyardValue key_val = execute_node(gy, key_node);
+
+        if (VALUE_TYPE(key_val) != VAL_STRING && VALUE_TYPE(key_val) != VAL_NUMBER &&
+            VALUE_TYPE(key_val) != VAL_BOOL && VALUE_TYPE(key_val) != VAL_NULL) {
+            runtime_error(gy, key_node->line, "Invalid type used as a hashtable key");
+            dec_ref(gy, value_to_assign);
+            dec_ref(gy, ht_val);
+            dec_ref(gy, key_val);
+            return create_null_value();
+        }
+        if (VALUE_TYPE(key_val) == VAL_NUMBER && !is_integral_number(AS_NUMBER(key_val))) {
+            runtime_error(gy, key_node->line, "Float cannot be used as a hashtable key");
+            dec_ref(gy, value_to_assign);
+            dec_ref(gy, ht_val);
+            dec_ref(gy, key_val);
+            return create_null_value();
+        }
+
+        hashtable_set(gy, AS_HASHTABLE(ht_val), key_val, value_to_assign);
+
+        dec_ref(gy, ht_val);
+        dec_ref(gy, key_val);
+
+        return value_to_assign;
+    } else if (target_node->type == AST_MEMBER_ACCESS) {
+        GraveyardValue object = execute_node(gy, target_node->as.member_access.object);
+        if (VALUE_TYPE(object) != VAL_INSTANCE) {
+            runtime_error(gy, target_node->line, "Can only assign to members of an instance");
+            dec_ref(gy, value_to_assign);
+            dec_ref(gy, object);
+            return create_null_value();
+        }
+
+        GraveyardInstance* instance = AS_INSTANCE(object);
+        MemberCache* cache = &target_node->as.member_access.cache;
+        if (cache->shape == instance->shape && cache->slot >= 0) {
+            inc_ref(value_to_assign);
+            dec_ref(gy, instance->fields[cache->slot]);
+            instance->fields[cache->slot] = value_to_assign;
+        } else {
+            instance_set_field(gy, instance, target_node->as.member_access.member.symbol, value_to_assign);
+        }
+        dec_ref(gy, object);
+        return value_to_assign;
+    } else if (target_node->type == AST_GLOBAL_ACCESS) {
+        Environment* global_env = get_global_environment(gy);
+
+        environment_define(gy, global_env, target_node->as.global_access.member_name.symbol, value_to_assign);
+        return value_to_assign;
+    } else if (target_node->type == AST_STATIC_ACCESS) {
+        Symbol* type_name = target_node->as.static_access.type_name.symbol;
+        Symbol* member_name = target_node->as.static_access.member_name.symbol;
+
+        GraveyardValue type_val;
+        if (!environment_get(gy->environment, type_name, &type_val) || VALUE_TYPE(type_val) != VAL_TYPE) {
+            runtime_error(gy, target_node->line, "Type <%s> is not defined", type_name->chars);
+            dec_ref(gy, value_to_assign);
+            return create_null_value();
+        }
+
+        monolith_set(gy, &AS_TYPE(type_val)->fields, member_name, value_to_assign);
+        return value_to_assign;
+    } else if (target_node->type == AST_NAMESPACE_ACCESS) {
+        Symbol* ns_name = target_node->as.namespace_access.namespace_name.symbol;
+        Symbol* member_name = target_node->as.namespace_access.member_name.symbol;
+        GraveyardValue ns_val;
+
+        if (!monolith_get(&gy->namespaces, ns_name, &ns_val)) {
+            runtime_error(gy, target_node->line, "Cannot assign to variable in undefined namespace '%s'", ns_name->chars);
+            dec_ref(gy, value_to_assign);
+            return create_null_value();
+        }
+
+        Environment* ns_env = AS_ENVIRONMENT(ns_val);
+
+        if (!environment_assign(gy, ns_env, member_name, value_to_assign)) {
+            runtime_error(gy, target_node->line, "Variable '%s' is not defined in namespace '%s'", member_name->chars, ns_name->chars);
+            dec_ref(gy, value_to_assign);
+            return create_null_value();
+        }
+
+        return value_to_assign;
+    }
+
+    runtime_error(gy, node->line, "Invalid assignment target.");
+    dec_ref(gy, value_to_assign);
+    return create_null_value();
+}
+
+static GraveyardValue execute_logical_op(Graveyard* gy, AstNode* node) {
+    bool left_owned;
+    GraveyardValue left = evaluate_borrowed(gy, node->as.logical_op.left, &left_owned);
+    GraveyardTokenType op_type = node->as.logical_op.operator.type;
+
+    if (op_type == AND) {
+        if (is_value_falsy(left)) {
+            return own_operand(left, left_owned);
+        }
+    } else if (op_type == OR) {
+        if (!is_value_falsy(left)) {
+            return own_operand(left, left_owned);
+        }
+    }
+
+    release_operand(gy, left, left_owned);
+    return execute_node(gy, node->as.logical_op.right);
+}
+
+static GraveyardValue execute_unary_op(Graveyard* gy, AstNode* node) {
+    bool right_owned;
+    GraveyardValue right = evaluate_borrowed(gy, node->as.unary_op.right, &right_owned);
+    GraveyardValue result = evaluate_unary_op(gy, node->as.unary_op.operator.type, right, node->line);
+
+    release_operand(gy, right, right_owned);
+
+    return result;
+}
+
+static GraveyardValue execute_binary_op(Graveyard* gy, AstNode* node) {
+    GraveyardTokenType op_type = node->as.binary_op.operator.type;
+
+    if (op_type == DOUBLEQUESTION) {
+        GraveyardValue left = execute_node(gy, node->as.binary_op.left);
+        if (VALUE_TYPE(left) != VAL_NULL) {
+            return left;
+        }
+        return execute_node(gy, node->as.binary_op.right);
+    }
+
+    bool left_owned = true;
+    GraveyardValue left = evaluation_is_pure(node->as.binary_op.right)
+        ? evaluate_borrowed(gy, node->as.binary_op.left, &left_owned)
+        : execute_node(gy, node->as.binary_op.left);
+    bool right_owned;
+    GraveyardValue right = evaluate_borrowed(gy, node->as.binary_op.right, &right_owned);
+    GraveyardValue result;
+    if (node->allocates_scratch && VALUE_TYPE(left) != VAL_ARRAY &&
+        (VALUE_TYPE(left) == VAL_STRING || VALUE_TYPE(right) == VAL_STRING)) {
+        result = concat_into_scratch(gy, left, right);
+    } else {
+        result = execute_binary_node(gy, node, left, right);
+    }
+
+    release_operand(gy, left, left_owned);
+    release_operand(gy, right, right_owned);
+
+    return result;
+}
+
+static GraveyardValue execute_formatted_string(Graveyard* gy, AstNode* node) {
+    size_t capacity = 128;
+    size_t length = 0;
+    char* result_string = malloc(capacity);
+    if (!result_string) {
+        perror("Formatted string buffer malloc failed");
+        return create_null_value();
+    }
+    result_string[0] = '\0';
+
+    for (size_t i = 0; i < node->as.formatted_string.count; i++) {
+        FmtStringPart part = node->as.formatted_string.parts[i];
+        char part_buffer[256]; 
+        const char* part_text = part_buffer;
+
+        if (part.type == FMT_PART_LITERAL) {
+            part_text = part.as.literal.lexeme;
+        } else {
+            bool owned;
+            GraveyardValue value = evaluate_borrowed(gy, part.as.expression, &owned);
+            value_to_string(value, part_buffer, sizeof(part_buffer));
+            release_operand(gy, value, owned);
+        }
+
+        size_t part_len = strlen(part_text);
+        if (length + part_len + 1 > capacity) {
+            capacity = (length + part_len) * 2;
+            char* new_result = realloc(result_string, capacity);
+            if (!new_result) {
+                perror("Formatted string buffer realloc failed");
+                free(result_string);
+                return create_null_value();
+            }
+            result_string = new_result;
+        }
+        memcpy(result_string + length, part_text, part_len + 1);
+        length += part_len;
+    }
+
+    GraveyardValue final_value;
+    if (node->allocates_scratch) {
+        GraveyardString* string_obj = create_scratch_string(gy, length);
+        memcpy(string_obj->chars, result_string, length);
+        final_value = OBJECT_VALUE(VAL_STRING, string_obj);
+    } else {
+        final_value = create_string_value(gy, result_string);
+    }
+    free(result_string);
+    return final_value;
+}
+
+static GraveyardValue execute_function_declaration(Graveyard* gy, AstNode* node) {
+    GraveyardValue function = create_function_value(gy, node);
+    environment_define(gy, gy->environment, node->as.function_declaration.name.symbol, function);
+    return create_null_value();
+}
+
+static GraveyardValue execute_block_statement(Graveyard* gy, AstNode* node) {
+    Environment* block_env = environment_acquire(gy, gy->environment, node->as.block.layout);
+    GraveyardValue result = execute_block(gy, node, block_env);
+
+    environment_release(gy, block_env);
+
+    return result;
+}
+
+static GraveyardValue execute_return_statement(Graveyard* gy, AstNode* node) {
+    AstNode* value_node = node->as.return_statement.value;
+    GraveyardValue value = create_null_value();
+    if (value_node != NULL && value_node->type == AST_CALL_EXPRESSION && value_node->as.call_expression.is_tail_call) {
+        PendingCall call;
+        if (prepare_call(gy, value_node, &call)) {
+            if (call.function->memo != NULL || closure_captures(call.function, gy->call_environment)) {
+                value = complete_call(gy, &call);
+            } else {
+                gy->tail_call = call;
+                gy->has_tail_call = true;
+            }
+        }
+    } else if (value_node != NULL) {
+        value = execute_node(gy, value_node);
+    }
+    gy->is_returning = true;
+
+    dec_ref(gy, gy->return_value);
+    gy->return_value = value;
+
+    inc_ref(value);
+    return value;
+}
+
+static GraveyardValue execute_call_expression(Graveyard* gy, AstNode* node) {
+    PendingCall call;
+    if (!prepare_call(gy, node, &call)) {
+        return create_null_value();
+    }
+    return complete_call(gy, &call);
+}
+
+static GraveyardValue execute_if_statement(Graveyard* gy, AstNode* node) {
+    bool condition_owned;
+    GraveyardValue condition_val = evaluate_borrowed(gy, node->as.if_statement.condition, &condition_owned);
+    bool is_truthy = !is_value_falsy(condition_val);
+
+    release_operand(gy, condition_val, condition_owned);
+
+    if (is_truthy) {
+        Environment* block_env = environment_acquire(gy, gy->environment, node->as.if_statement.then_branch->as.block.layout);
+        dec_ref(gy, execute_block(gy, node->as.if_statement.then_branch, block_env));
+        environment_release(gy, block_env);
+
+        return create_null_value();
+    }
+
+    for (size_t i = 0; i < node->as.if_statement.else_if_count; i++) {
+        AstNodeElseIfClause* clause = &node->as.if_statement.else_if_clauses[i];
+
+        bool else_if_owned;
+        GraveyardValue else_if_condition = evaluate_borrowed(gy, clause->condition, &else_if_owned);
+        bool else_if_is_truthy = !is_value_falsy(else_if_condition);
+
+        release_operand(gy, else_if_condition, else_if_owned);
+
+        if (else_if_is_truthy) {
+            Environment* block_env = environment_acquire(gy, gy->environment, clause->body->as.block.layout);
+            dec_ref(gy, execute_block(gy, clause->body, block_env));
+            environment_release(gy, block_env);
+
+            return create_null_value();
+        }
+    }
+
+    if (node->as.if_statement.else_branch != NULL) {
+        Environment* block_env = environment_acquire(gy, gy->environment, node->as.if_statement.else_branch->as.block.layout);
+        dec_ref(gy, execute_block(gy, node->as.if_statement.else_branch, block_env));
+        environment_release(gy, block_env);
+    }
+
+    return create_null_value();
+}
+
+static GraveyardValue execute_ternary_expression(Graveyard* gy, AstNode* node) {
+    bool condition_owned;
+    GraveyardValue condition = evaluate_borrowed(gy, node->as.ternary_expression.condition, &condition_owned);
+    bool is_falsy = is_value_falsy(condition);
+
+    release_operand(gy, condition, condition_owned);
+
+    if (!is_falsy) {
+        return execute_node(gy, node->as.ternary_expression.then_expr);
+    } else {
+        return execute_node(gy, node->as.ternary_expression.else_expr);
+    }
+
+    return create_null_value();
+}
+
+static GraveyardValue execute_assert_statement(Graveyard* gy, AstNode* node) {
+    bool condition_owned;
+    GraveyardValue condition = evaluate_borrowed(gy, node->as.assert_statement.condition, &condition_owned);
+    if (is_value_falsy(condition)) {
+        runtime_error(gy, node->line, "Assertion failed");
+    }
+    release_operand(gy, condition, condition_owned);
+    return create_null_value();
+}
+
+static GraveyardValue execute_while_statement(Graveyard* gy, AstNode* node) {
+    while (true) {
+        bool condition_owned;
+        GraveyardValue condition = evaluate_borrowed(gy, node->as.while_statement.condition, &condition_owned);
+        bool is_falsy = is_value_falsy(condition);
+
+        release_operand(gy, condition, condition_owned);
+
+        if (is_falsy) {
+            break;
+        }
+
+        Environment* block_env = environment_acquire(gy, gy->environment, node->as.while_statement.body->as.block.layout);
+        dec_ref(gy, execute_block(gy, node->as.while_statement.body, block_env));
+        environment_release(gy, block_env);
+
+        gy->encountered_continue = false;
+
+        if (gy->is_returning || gy->encountered_break) {
+            break;
+        }
+    }
+    gy->encountered_break = false;
+    gy->encountered_continue = false;
+    return create_null_value();
+}
+
+static GraveyardValue execute_break_statement(Graveyard* gy, AstNode* node) {
+    gy->encountered_break = true;
+    return create_null_value();
+}
+
+static GraveyardValue execute_continue_statement(Graveyard* gy, AstNode* node) {
+    gy->encountered_continue = true;
+    return create_null_value();
+}
+
+static bool execute_for_iteration(Graveyard* gy, AstNode* node, GraveyardValue element) {
+    Environment* loop_env = environment_acquire(gy, gy->environment, node->as.for_statement.body->as.block.layout);
+    environment_define(gy, loop_env, node->as.for_statement.iterator.symbol, element);
+    dec_ref(gy, execute_block(gy, node->as.for_statement.body, loop_env));
+    environment_release(gy, loop_env);
+    gy->encountered_continue = false;
+    return !gy->is_returning && !gy->encountered_break;
+}
+
+static GraveyardValue execute_for_statement(Graveyard* gy, AstNode* node) {
+    size_t range_count = node->as.for_statement.range_count;
+    AstNode** range_exprs = node->as.for_statement.range_expressions;
+
+    if (range_count == 1) {
+        GraveyardValue collection = execute_node(gy, range_exprs[0]);
+
+        if (VALUE_TYPE(collection) == VAL_ARRAY) {
+            GraveyardArray* array = AS_ARRAY(collection);
+            for (size_t i = 0; i < array->count; i++) {
+                if (!execute_for_iteration(gy, node, array->values[i])) break;
+            }
+        } else if (VALUE_TYPE(collection) == VAL_HASHTABLE) {
+            GraveyardHashtable* ht = AS_HASHTABLE(collection);
+            for (int i = 0; i < ht->capacity; i++) {
+                if (!ht->entries[i].is_in_use) continue;
+                if (!execute_for_iteration(gy, node, ht->entries[i].key)) break;
+            }
+        } else if (VALUE_TYPE(collection) == VAL_NUMBER) {
+            double stop_val = AS_NUMBER(collection);
+            int64_t stop_int;
+            if (number_to_int64(ceil(stop_val), &stop_int)) {
+                for (int64_t i = 0; i < stop_int; i++) {
+                    if (!execute_for_iteration(gy, node, create_number_value((double)i))) break;
+                }
+            } else {
+                for (double i = 0; i < stop_val; i += 1) {
+                    if (!execute_for_iteration(gy, node, create_number_value(i))) break;
+                }
+            }
+        } else {
+            runtime_error(gy, node->line, "Invalid type for single-argument for loop");
+        }
+
+        dec_ref(gy, collection);
+
+    } else {
+        GraveyardValue start_gv = execute_node(gy, range_exprs[0]);
+        if (VALUE_TYPE(start_gv) != VAL_NUMBER) {
+            runtime_error(gy, range_exprs[0]->line, "For loop range arguments must be numbers");
+            dec_ref(gy, start_gv);
+            return create_null_value();
+        }
+
+        GraveyardValue stop_gv = execute_node(gy, range_exprs[1]);
+        if (VALUE_TYPE(stop_gv) != VAL_NUMBER) {
+            runtime_error(gy, range_exprs[1]->line, "For loop range arguments must be numbers");
+            dec_ref(gy, start_gv);
+            dec_ref(gy, stop_gv);
+            return create_null_value();
+        }
+
+        GraveyardValue step_gv = create_number_value(1.0);
+        if (range_count == 3) {
+            dec_ref(gy, step_gv);
+            step_gv = execute_node(gy, range_exprs[2]);
+            if (VALUE_TYPE(step_gv) != VAL_NUMBER) {
+                runtime_error(gy, range_exprs[2]->line, "For loop step argument must be a number");
+                dec_ref(gy, start_gv);
+                dec_ref(gy, stop_gv);
+                dec_ref(gy, step_gv);
+                return create_null_value();
+            }
+        }
+
+        double start_val = AS_NUMBER(start_gv);
+        double stop_val = AS_NUMBER(stop_gv);
+        double step_val = AS_NUMBER(step_gv);
+        int64_t start_int, stop_int, step_int;
+
+        if (step_val == 0) {
+            runtime_error(gy, node->line, "For loop step cannot be zero");
+        } else if (number_to_int64(start_val, &start_int) && number_to_int64(step_val, &step_int) &&
+                   number_to_int64(step_int > 0 ? ceil(stop_val) : floor(stop_val), &stop_int)) {
+            for (int64_t i = start_int; (step_int > 0) ? (i < stop_int) : (i > stop_int); i += step_int) {
+                if (!execute_for_iteration(gy, node, create_number_value((double)i))) break;
+            }
+        } else {
+            for (double i = start_val; (step_val > 0) ? (i < stop_val) : (i > stop_val); i += step_val) {
+                if (!execute_for_iteration(gy, node, create_number_value(i))) break;
+            }
+        }
+
+        dec_ref(gy, start_gv);
+        dec_ref(gy, stop_gv);
+        dec_ref(gy, step_gv);
+    }
+
+    gy->encountered_break = false;
+    gy->encountered_continue = false;
+    return create_null_value();
+}
+
+static GraveyardValue execute_raise_statement(Graveyard* gy, AstNode* node) {
+    GraveyardValue error_val = execute_node(gy, node->as.raise_statement.error_expr);
+    char error_buffer[1024];
+    value_to_string(error_val, error_buffer, sizeof(error_buffer));
+
+    runtime_error(gy, node->line, "%s", error_buffer);
+
+    dec_ref(gy, error_val);
+    return create_null_value();
+}
+
+static GraveyardValue execute_time_expression(Graveyard* gy, AstNode* node) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    double epoch_time_precise = (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+    return create_number_value(epoch_time_precise);
+}
+
+static GraveyardValue execute_namespace_declaration(Graveyard* gy, AstNode* node) {
+    Symbol* name = node->as.namespace_declaration.name.symbol;
+    GraveyardValue ns_val;
+    Environment* ns_env;
+
+    if (monolith_get(&gy->namespaces, name, &ns_val)) {
+        ns_env = AS_ENVIRONMENT(ns_val);
+    } else {
+        Environment* global_env = get_global_environment(gy);
+        ns_env = environment_new(gy, global_env);
+
+        monolith_set(gy, &gy->namespaces, name, OBJECT_VALUE(VAL_ENVIRONMENT, ns_env));
+    }
+
+    dec_ref(gy, execute_block(gy, node->as.namespace_declaration.body, ns_env));
+    return create_null_value();
+}
+
+static GraveyardValue execute_namespace_access(Graveyard* gy, AstNode* node) {
+    Symbol* ns_name = node->as.namespace_access.namespace_name.symbol;
+    Symbol* member_name = node->as.namespace_access.member_name.symbol;
+    GraveyardValue ns_val;
+
+    if (!monolith_get(&gy->namespaces, ns_name, &ns_val)) {
+        runtime_error(gy, node->line, "Namespace '%s' is not defined", ns_name->chars);
+        return create_null_value();
+    }
+
+    Environment* ns_env = AS_ENVIRONMENT(ns_val);
+    GraveyardValue member_val;
+
+    if (!environment_get(ns_env, member_name, &member_val)) {
+        runtime_error(gy, node->line, "Member '%s' not found in namespace '%s'", member_name->chars, ns_name->chars);
+        return create_null_value();
+    }
+
+    inc_ref(member_val);
+
+    return member_val;
+}
+
+static GraveyardValue execute_fileread_statement(Graveyard* gy, AstNode* node) {
+    GraveyardValue path_val = execute_node(gy, node->as.fileread_statement.path_expr);
+    if (VALUE_TYPE(path_val) != VAL_STRING) {
+        runtime_error(gy, node->line, "File path for read operation must be a string");
+        return create_null_value();
+    }
+
+    FILE* file = fopen(AS_STRING(path_val)->chars, "rb");
+    if (!file) {
+        runtime_error(gy, node->line, "Cannot open file '%s'", AS_STRING(path_val)->chars);
+        return create_null_value();
+    }
+
+    char* buffer = load(file, NULL);
+    fclose(file);
+    if (!buffer) {
+        runtime_error(gy, node->line, "Failed to read file '%s'", AS_STRING(path_val)->chars);
+        return create_null_value();
+    }
+
+    GraveyardValue file_contents = create_string_value(gy, buffer);
+    free(buffer);
+
+    environment_define(gy, gy->environment, node->as.fileread_statement.variable.symbol, file_contents);
+
+    return file_contents;
+}
+
+static GraveyardValue execute_type_declaration(Graveyard* gy, AstNode* node) {
+    Environment* type_definition_env = gy->environment;
+    Symbol* type_name = node->as.type_declaration.name.symbol;
+
+    GraveyardValue name_val = create_string_value(gy, type_name->chars);
+    GraveyardValue type_val = create_type_value(name_val);
+
+    environment_define(gy, gy->environment, type_name, type_val);
+
+    GraveyardType* type = AS_TYPE(type_val);
+    AstNode* body_node = node->as.type_declaration.body;
+
+    for (size_t i = 0; i < body_node->as.block.count; i++) {
+        AstNode* stmt = body_node->as.block.statements[i];
+
+        if (stmt->type == AST_EXPRESSION_STATEMENT && stmt->as.expression_statement.expression->type == AST_ASSIGNMENT) {
+            AstNode* assignment = stmt->as.expression_statement.expression;
+            AstNode* target = assignment->as.assignment.left;
+
+            if (target->type == AST_IDENTIFIER) {
+                Symbol* field_name = target->as.identifier.name.symbol;
+
+                Environment* initializer_env = environment_new(gy, gy->environment);
+
+                inc_ref(type_val);  
+                monolith_set(gy, &initializer_env->values, gy->this_symbol, type_val);
+
+                Environment* old_env = gy->environment;
+                gy->environment = initializer_env;
+                GraveyardValue value = execute_node(gy, assignment->as.assignment.value);
+                gy->environment = old_env;
+
+                environment_free(gy, initializer_env);
+
+                monolith_set(gy, &type->fields, field_name, value);
+                dec_ref(gy, value);
+            }
+        }   
+        else if (stmt->type == AST_FUNCTION_DECLARATION) {
+            GraveyardValue function = create_function_value(gy, stmt);
+            AS_FUNCTION(function)->closure = type_definition_env;
+            monolith_set(gy, &type->methods, stmt->as.function_declaration.name.symbol, function);
+            dec_ref(gy, function);
+        }
+    }
+
+    return type_val;
+}
+
+static GraveyardValue execute_this_expression(Graveyard* gy, AstNode* node) {
+    GraveyardValue this_val;
+    if (!resolved_get(gy, &node->as.this_expression.resolution, gy->this_symbol, &this_val)) {
+        runtime_error(gy, node->line, "Cannot use '.' outside of a type's method");
+        return create_null_value();
+    }
+    inc_ref(this_val);
+    return this_val;
+}
+
+static GraveyardValue execute_member_access(Graveyard* gy, AstNode* node) {
+    bool object_owned;
+    GraveyardValue object = evaluate_borrowed(gy, node->as.member_access.object, &object_owned);
+    GraveyardValue result = member_access_value(gy, object, node);
+
+    release_operand(gy, object, object_owned);
+
+    return result;
+}
+
+static GraveyardValue execute_execute_expression(Graveyard* gy, AstNode* node) {
+    GraveyardValue command_val = execute_node(gy, node->as.execute_expression.command_expr);
+    if (VALUE_TYPE(command_val) != VAL_STRING) {
+        runtime_error(gy, node->line, "Command for execute operation must be a string");
+        return create_null_value();
+    }
+
+    char full_command[2048];
+    snprintf(full_command, sizeof(full_command), "%s 2>&1", AS_STRING(command_val)->chars);
+
+    #ifdef _WIN32
+        FILE* pipe = _popen(full_command, "r");
+    #else
+        FILE* pipe = popen(full_command, "r");
+    #endif
+
+    if (!pipe) {
+        runtime_error(gy, node->line, "Failed to execute command");
+        return create_null_value();
+    }
+
+    char buffer[128];
+    size_t output_capacity = 256;
+    size_t output_len = 0;
+    char* output_str = malloc(output_capacity);
+    output_str[0] = '\0';
+
+    while (fgets(buffer, sizeof(buffer), pipe) != NULL) {
+        size_t buffer_len = strlen(buffer);
+        if (output_len + buffer_len + 1 > output_capacity) {
+            output_capacity *= 2;
+            output_str = realloc(output_str, output_capacity);
+        }
+        strcat(output_str, buffer);
+        output_len += buffer_len;
+    }
+
+    int exit_code;
+    #ifdef _WIN32
+        exit_code = _pclose(pipe);
+    #else
+        int status = pclose(pipe);
+        exit_code = WEXITSTATUS(status);
+    #endif
+
+    GraveyardValue result_ht = create_hashtable_value(gy);
+    hashtable_set(gy, AS_HASHTABLE(result_ht), create_string_value(gy, "stdout"), create_string_value(gy, output_str));
+    hashtable_set(gy, AS_HASHTABLE(result_ht), create_string_value(gy, "stderr"), create_string_value(gy, ""));
+    hashtable_set(gy, AS_HASHTABLE(result_ht), create_string_value(gy, "exit_code"), create_number_value(exit_code));
+
+    free(output_str);
+
+    return result_ht;
+}
+
+static GraveyardValue execute_cat_constant_expression(Graveyard* gy, AstNode* node) {
+    return create_number_value(65458655);
+}
+
+static GraveyardValue execute_wait_statement(Graveyard* gy, AstNode* node) {
+    GraveyardValue duration_val = execute_node(gy, node->as.wait_statement.duration_expr);
+    if (VALUE_TYPE(duration_val) != VAL_NUMBER) {
+        runtime_error(gy, node->line, "Duration for wait operation must be a number");
+        return create_null_value();
+    }
+
+    long milliseconds = (long)AS_NUMBER(duration_val);
+    if (milliseconds < 0) {
+        milliseconds = 0;
+    }
+
+    #ifdef _WIN32
+        Sleep(milliseconds);
+    #else
+        usleep(milliseconds * 1000);
+    #endif
+
+    return create_null_value();
+}
+
+static GraveyardValue execute_random_expression(Graveyard* gy, AstNode* node) {
+    double random_val = (double)rand() / (double)RAND_MAX;
+    return create_number_value(random_val);
 }
 
-static HashtableEntry* hashtable_find_entry(HashtableEntry* entries, int capacity, GraveyardValue key) {
-    uint32_t index = hash_graveyard_value(key) % capacity;
-    for (;;) {
-        HashtableEntry* entry = &entries[index];
-        if (!entry->is_in_use || are_values_equal(entry->key, key)) {
-            return entry;
-        }
-        index = (index + 1) % capacity;
+static GraveyardValue execute_global_access(Graveyard* gy, AstNode* node) {
+    Symbol* member_name = node->as.global_access.member_name.symbol;
+    Environment* global_env = get_global_environment(gy);
+    GraveyardValue member_val;
+
+    if (!environment_get(global_env, member_name, &member_val)) {
+        runtime_error(gy, node->line, "Global variable '%s' not found", member_name->chars);
+        return create_null_value();
     }
+
+    inc_ref(member_val);
+    return member_val;
 }
 
-static void hashtable_resize(GraveyardHashtable* ht, int new_capacity) {
-    HashtableEntry* new_entries = malloc(new_capacity * sizeof(HashtableEntry));
-    if (!new_entries) {
-        perror("hashtable_resize: malloc failed");
-        exit(1);
-    }
-    for (int i = 0; i < new_capacity; i++) {
-        new_entries[i].is_in_use = false;
-        new_entries[i].key.type = VAL_NULL;
+static GraveyardValue execute_static_access(Graveyard* gy, AstNode* node) {
+    Symbol* type_name = node->as.static_access.type_name.symbol;
+    Symbol* member_name = node->as.static_access.member_name.symbol;
+
+    GraveyardValue type_val;
+    if (!environment_get(gy->environment, type_name, &type_val) || VALUE_TYPE(type_val) != VAL_TYPE) {
+        runtime_error(gy, node->line, "Type <%s> is not defined", type_name->chars);
+        return create_null_value();
     }
+    GraveyardType* type = AS_TYPE(type_val);
+    GraveyardValue member_val;
 
-    ht->count = 0;
-    for (int i = 0; i < ht->capacity; i++) {
-        HashtableEntry* entry = &ht->entries[i];
-        if (!entry->is_in_use) continue;
+    if (monolith_get(&type->methods, member_name, &member_val)) {
+        inc_ref(member_val);
+        return member_val;
+    }
 
-        HashtableEntry* dest = hashtable_find_entry(new_entries, new_capacity, entry->key);
-        dest->key = entry->key;
-        dest->value = entry->value;
-        
-        dest->is_in_use = true;
-        ht->count++;
+    if (monolith_get(&type->fields, member_name, &member_val)) {
+        inc_ref(member_val);
+        return member_val;
     }
 
-    free(ht->entries);
-    ht->entries = new_entries;
-    ht->capacity = new_capacity;
+    runtime_error(gy, node->line, "Static member '%s' not found on type <%s>", member_name->chars, type_name->chars);
+    return create_null_value();
 }
 
-static void hashtable_set(GraveyardHashtable* ht, GraveyardValue key, GraveyardValue value) {
-    if (ht->count + 1 > ht->capacity * 0.75) {
-        int new_capacity = ht->capacity < 8 ? 8 : ht->capacity * 2;
-        hashtable_resize(ht, new_capacity);
-    }
+static GraveyardValue execute_uid_expression(Graveyard* gy, AstNode* node) {
+    GraveyardValue length_val = execute_node(gy, node->as.uid_expression.length_expr);
+    GraveyardValue result = create_null_value();
 
-    HashtableEntry* entry = hashtable_find_entry(ht->entries, ht->capacity, key);
-    
-    bool is_new_key = !entry->is_in_use;
-    if (is_new_key) {
-        entry->is_in_use = true;
-        ht->count++;
-        inc_ref(key);
-        entry->key = key;
-        inc_ref(value);
+    if (VALUE_TYPE(length_val) != VAL_NUMBER) {
+        runtime_error(gy, node->line, "Length for UID operation must be a number");
     } else {
-        dec_ref(entry->value);
-        inc_ref(value);
+        int length = (int)AS_NUMBER(length_val);
+        if (length <= 0) {
+            runtime_error(gy, node->line, "UID length must be a positive number");
+        } else {
+            char* uid_str = generate_random_hex_string(length);
+            if (!uid_str) {
+                runtime_error(gy, node->line, "Failed to generate random UID");
+            } else {
+                result = create_string_value(gy, uid_str);
+                free(uid_str);
+            }
+        }
     }
-    
-    entry->value = value;
+
+    dec_ref(gy, length_val);
+
+    return result;
 }
 
-static MonolithEntry* find_entry(MonolithEntry* entries, int capacity, const char* key) {
-    uint32_t index = hash_string(key, strlen(key)) % capacity;
-    for (;;) {
-        MonolithEntry* entry = &entries[index];
-        if (entry->key == NULL || strcmp(entry->key, key) == 0) {
-            return entry;
+static GraveyardValue execute_slice_expression(Graveyard* gy, AstNode* node) {
+    GraveyardValue collection = execute_node(gy, node->as.slice_expression.collection);
+    GraveyardValue result = create_null_value();
+
+    if (VALUE_TYPE(collection) == VAL_ARRAY) {
+        GraveyardArray* arr = AS_ARRAY(collection);
+        long start, stop, step;
+
+        if (!calculate_slice_bounds(arr->count, node->as.slice_expression.start_expr,
+                                    node->as.slice_expression.stop_expr, node->as.slice_expression.step_expr,
+                                    &start, &stop, &step, gy)) {
+            runtime_error(gy, node->line, "Slice step cannot be zero");
+        } else {
+            GraveyardValue result_array = create_array_value(gy);
+            if (step > 0 && start < stop) {
+                for (long i = start; i < stop; i += step) {
+                    if (i < 0 || i >= arr->count) continue;
+                    array_append(AS_ARRAY(result_array), arr->values[i]);
+                }
+            } else if (step < 0 && start > stop) {
+                for (long i = start; i > stop; i += step) {
+                    if (i < 0 || i >= arr->count) continue;
+                    array_append(AS_ARRAY(result_array), arr->values[i]);
+                }
+            }
+            result = result_array;
         }
-        index = (index + 1) % capacity;
+    } else if (VALUE_TYPE(collection) == VAL_STRING) {
+        GraveyardString* str = AS_STRING(collection);
+        long start, stop, step;
+
+        if (!calculate_slice_bounds(str->length, node->as.slice_expression.start_expr,
+                                    node->as.slice_expression.stop_expr, node->as.slice_expression.step_expr,
+                                    &start, &stop, &step, gy)) {
+            runtime_error(gy, node->line, "Slice step cannot be zero");
+        } else {
+            char* new_chars = malloc(str->length + 1);
+            if (!new_chars) {
+                runtime_error(gy, node->line, "Memory allocation failed for string slice");
+            } else {
+                size_t new_len = 0;
+                if (step > 0 && start < stop) {
+                    for (long i = start; i < stop; i += step) {
+                        if (i < 0 || i >= str->length) continue;
+                        new_chars[new_len++] = str->chars[i];
+                    }
+                } else if (step < 0 && start > stop) {
+                    for (long i = start; i > stop; i += step) {
+                        if (i < 0 || i >= str->length) continue;
+                        new_chars[new_len++] = str->chars[i];
+                    }
+                }
+                new_chars[new_len] = '\0';
+
+                result = create_string_value(gy, new_chars);
+                free(new_chars);
+            }
+        }
+    } else {
+        runtime_error(gy, node->line, "Slicing can only be applied to arrays and strings");
     }
+
+    dec_ref(gy, collection);
+
+    return result;
 }
 
-static GraveyardValue create_null_value() {
-    GraveyardValue val;
-    val.type = VAL_NULL;
-    val.as.number = 0;
-    return val;
+static GraveyardValue execute_argv_expression(Graveyard* gy, AstNode* node) {
+    inc_ref(gy->arguments);
+    return gy->arguments;
 }
 
-static GraveyardValue create_string_value(const char* chars) {
-    GraveyardValue val;
-    val.type = VAL_STRING;
+static GraveyardValue execute_eval_expression(Graveyard* gy, AstNode* node) {
+    GraveyardValue code_val = execute_node(gy, node->as.eval_expression.code_expr);
+    if (VALUE_TYPE(code_val) != VAL_STRING) {
+        runtime_error(gy, node->line, "Argument for eval operation must be a string");
+        return create_null_value();
+    }
 
-    size_t length = strlen(chars);
-    GraveyardString* string_obj = malloc(sizeof(GraveyardString));
-    string_obj->chars = malloc(length + 1);
-    memcpy(string_obj->chars, chars, length);
-    string_obj->chars[length] = '\0';
-    string_obj->length = length;
-    string_obj->ref_count = 1;
+    char* saved_source = gy->source_code;
+    AstNode* saved_ast_root = gy->ast_root;
+    AstArena saved_ast_arena = gy->ast_arena;
+    Environment* saved_env = gy->environment;
 
-    val.as.string = string_obj;
-    return val;
-}
+    gy->source_code = strdup(AS_STRING(code_val)->chars);
+    gy->ast_root = NULL;
+    ast_arena_init(&gy->ast_arena);
 
-static GraveyardValue create_function_value(Graveyard* gy, AstNode* node) {
-    GraveyardValue val;
-    val.type = VAL_FUNCTION;
-    GraveyardFunction* func = malloc(sizeof(GraveyardFunction));
+    gy->environment = environment_new(gy, saved_env);
 
-    func->ref_count = 1;
-    func->arity = node->as.function_declaration.param_count;
-    func->body = node->as.function_declaration.body;
-    func->params = node->as.function_declaration.params;
-    
-    func->closure = gy->environment;
+    GraveyardValue result = create_null_value();
+    if (parse(gy) && optimize(gy) && resolve(gy) && execute(gy)) {
+        result = gy->last_executed_value;
+    } else {
+        gy->had_runtime_error = false;
+        runtime_error(gy, node->line, "Failed to evaluate string");
+    }
+
+    free(gy->source_code);
+    ast_arena_free(gy, &gy->ast_arena);
+    environment_free(gy, gy->environment);
 
-    func->name = create_string_value(node->as.function_declaration.name.lexeme);
+    gy->source_code = saved_source;
+    gy->ast_root = saved_ast_root;
+    gy->ast_arena = saved_ast_arena;
+    gy->environment = saved_env;
 
-    val.as.function = func;
-    return val;
+    return result;
 }
 
-static GraveyardValue execute_node(Graveyard* gy, AstNode* node);
+static GraveyardValue execute_exists_expression(Graveyard* gy, AstNode* node) {
+    GraveyardValue path_val = execute_node(gy, node->as.exists_expression.path_expr);
+    if (VALUE_TYPE(path_val) != VAL_STRING) {
+        runtime_error(gy, node->line, "Path for exists check must be a string");
+        return create_null_value();
+    }
 
-static bool calculate_slice_bounds(long length, AstNode* start_expr, AstNode* stop_expr, AstNode* step_expr, long* out_start, long* out_stop, long* out_step, Graveyard* gy) {
+    struct stat buffer;
+    bool exists = (stat(AS_STRING(path_val)->chars, &buffer) == 0);
 
-    *out_step = 1;
-    if (step_expr) {
-        GraveyardValue step_val = execute_node(gy, step_expr);
-        if (step_val.type != VAL_NUMBER) {
-            dec_ref(step_val);
-            return false; 
-        }
-        *out_step = (long)step_val.as.number;
-        dec_ref(step_val);
+    return create_bool_value(exists);
+}
+
+static GraveyardValue execute_listdir_expression(Graveyard* gy, AstNode* node) {
+    GraveyardValue path_val = execute_node(gy, node->as.listdir_expression.path_expr);
+    if (VALUE_TYPE(path_val) != VAL_STRING) {
+        runtime_error(gy, node->line, "Path for list directory must be a string");
+        return create_null_value();
     }
+    const char* path = AS_STRING(path_val)->chars;
 
-    if (*out_step == 0) {
-        return false;
+    GraveyardValue result_array = create_array_value(gy);
+
+#ifdef _WIN32
+    char search_path[1024];
+    snprintf(search_path, sizeof(search_path), "%s\\*", path);
+    WIN32_FIND_DATA find_data;
+    HANDLE find_handle = FindFirstFile(search_path, &find_data);
+
+    if (find_handle == INVALID_HANDLE_VALUE) {
+        runtime_error(gy, node->line, "Cannot open directory '%s'", path);
+        return create_null_value();
     }
 
-    *out_start = (*out_step > 0) ? 0 : length - 1;
-    if (start_expr) {
-        GraveyardValue start_val = execute_node(gy, start_expr);
-        if (start_val.type == VAL_NUMBER) {
-            *out_start = (long)start_val.as.number;
-            if (*out_start < 0) *out_start += length;
+    do {
+        if (strcmp(find_data.cFileName, ".") != 0 && strcmp(find_data.cFileName, "..") != 0) {
+            array_append(AS_ARRAY(result_array), create_string_value(gy, find_data.cFileName));
         }
-        dec_ref(start_val);
+    } while (FindNextFile(find_handle, &find_data) != 0);
+
+    FindClose(find_handle);
+#else
+    DIR* dir = opendir(path);
+    if (!dir) {
+        runtime_error(gy, node->line, "Cannot open directory '%s'", path);
+        return create_null_value();
     }
 
-    *out_stop = (*out_step > 0) ? length : -1;
-    if (stop_expr) {
-        GraveyardValue stop_val = execute_node(gy, stop_expr);
-        if (stop_val.type == VAL_NUMBER) {
-            *out_stop = (long)stop_val.as.number;
-            if (*out_stop < 0) *out_stop += length;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0) {
+            array_append(AS_ARRAY(result_array), create_string_value(gy, entry->d_name));
         }
-        dec_ref(stop_val);
     }
+    closedir(dir);
+#endif
 
-    if (*out_start < 0) *out_start = 0;
-    if (*out_start > length) *out_start = length;
-    if (*out_stop > length) *out_stop = length;
-    
-    return true;
+    return result_array;
 }
 
-static GraveyardValue execute_block(Graveyard* gy, AstNode* block_node, Environment* environment) {
-    Environment* previous = gy->environment;
-    gy->environment = environment;
-    GraveyardValue last_val = create_null_value();
+static GraveyardValue execute_try_except_statement(Graveyard* gy, AstNode* node) {
+    dec_ref(gy, execute_node(gy, node->as.try_except_statement.try_block));
 
-    for (size_t i = 0; i < block_node->as.block.count; i++) {
-        last_val = execute_node(gy, block_node->as.block.statements[i]);
-        if (gy->is_returning || gy->encountered_break || gy->encountered_continue) {
-            break;
+    bool error_occurred = gy->had_runtime_error;
+    if (error_occurred) {
+        gy->had_runtime_error = false;
+
+        if (node->as.try_except_statement.except_clause) {
+            AstNodeExceptClause* clause = node->as.try_except_statement.except_clause;
+
+            GraveyardValue error_obj = create_hashtable_value(gy);
+
+            GraveyardValue key_msg = create_string_value(gy, "message");
+            GraveyardValue val_msg = create_string_value(gy, gy->error_message);
+            hashtable_set(gy, AS_HASHTABLE(error_obj), key_msg, val_msg);
+            dec_ref(gy, key_msg);
+            dec_ref(gy, val_msg);
+
+            GraveyardValue key_line = create_string_value(gy, "line");
+            GraveyardValue val_line = create_number_value(gy->error_line);
+            hashtable_set(gy, AS_HASHTABLE(error_obj), key_line, val_line);
+            dec_ref(gy, key_line);
+            dec_ref(gy, val_line);
+
+            Environment* except_env = environment_acquire(gy, gy->environment, clause->body->as.block.layout);
+            environment_define(gy, except_env, clause->error_variable.symbol, error_obj);
+
+            dec_ref(gy, error_obj);
+
+            dec_ref(gy, execute_block(gy, clause->body, except_env));
+
+            environment_release(gy, except_env);
         }
     }
 
-    gy->environment = previous;
-    return last_val;
+    if (node->as.try_except_statement.finally_block) {
+        dec_ref(gy, execute_node(gy, node->as.try_except_statement.finally_block));
+    }
+
+    return create_null_value();
 }
 
-static void monolith_resize(Monolith* monolith, int new_capacity) {
-    MonolithEntry* new_entries = malloc(new_capacity * sizeof(MonolithEntry));
-    if (!new_entries) {
-        perror("monolith_resize: malloc failed");
-        exit(1); 
-    }
-    for (int i = 0; i < new_capacity; i++) {
-        new_entries[i].key = NULL;
+static GraveyardValue execute_var_declaration(Graveyard* gy, AstNode* node) {
+    Symbol* name = node->as.var_declaration.name.symbol;
+    GraveyardValue value = create_null_value();
+
+    if (node->as.var_declaration.initializer != NULL) {
+        dec_ref(gy, value);
+        value = execute_node(gy, node->as.var_declaration.initializer);
     }
 
-    for (int i = 0; i < monolith->capacity; i++) {
-        MonolithEntry* entry = &monolith->entries[i];
-        if (entry->key == NULL) continue;
+    resolved_define(gy, &node->as.var_declaration.resolution, name, value);
+    dec_ref(gy, value);
 
-        MonolithEntry* dest = find_entry(new_entries, new_capacity, entry->key);
-        dest->key = entry->key;
-        dest->value = entry->value;
+    return create_null_value();
+}
+
+static const NodeHandler node_handlers[] = {
+    [AST_UNKNOWN]                 = execute_unknown,
+    [AST_PROGRAM]                 = execute_program,
+    [AST_PRINT_STATEMENT]         = execute_print_statement,
+    [AST_SCAN_STATEMENT]          = execute_scan_statement,
+    [AST_LITERAL]                 = execute_literal,
+    [AST_ARRAY_LITERAL]           = execute_array_literal,
+    [AST_SUBSCRIPT]               = execute_subscript,
+    [AST_HASHTABLE_LITERAL]       = execute_hashtable_literal,
+    [AST_IDENTIFIER]              = execute_identifier,
+    [AST_EXPRESSION_STATEMENT]    = execute_expression_statement,
+    [AST_ASSIGNMENT]              = execute_assignment,
+    [AST_LOGICAL_OP]              = execute_logical_op,
+    [AST_UNARY_OP]                = execute_unary_op,
+    [AST_BINARY_OP]               = execute_binary_op,
+    [AST_FORMATTED_STRING]        = execute_formatted_string,
+    [AST_FUNCTION_DECLARATION]    = execute_function_declaration,
+    [AST_BLOCK]                   = execute_block_statement,
+    [AST_RETURN_STATEMENT]        = execute_return_statement,
+    [AST_CALL_EXPRESSION]         = execute_call_expression,
+    [AST_IF_STATEMENT]            = execute_if_statement,
+    [AST_TERNARY_EXPRESSION]      = execute_ternary_expression,
+    [AST_ASSERT_STATEMENT]        = execute_assert_statement,
+    [AST_WHILE_STATEMENT]         = execute_while_statement,
+    [AST_BREAK_STATEMENT]         = execute_break_statement,
+    [AST_CONTINUE_STATEMENT]      = execute_continue_statement,
+    [AST_FOR_STATEMENT]           = execute_for_statement,
+    [AST_RAISE_STATEMENT]         = execute_raise_statement,
+    [AST_TIME_EXPRESSION]         = execute_time_expression,
+    [AST_NAMESPACE_DECLARATION]   = execute_namespace_declaration,
+    [AST_NAMESPACE_ACCESS]        = execute_namespace_access,
+    [AST_FILEREAD_STATEMENT]      = execute_fileread_statement,
+    [AST_TYPE_DECLARATION]        = execute_type_declaration,
+    [AST_THIS_EXPRESSION]         = execute_this_expression,
+    [AST_MEMBER_ACCESS]           = execute_member_access,
+    [AST_EXECUTE_EXPRESSION]      = execute_execute_expression,
+    [AST_CAT_CONSTANT_EXPRESSION] = execute_cat_constant_expression,
+    [AST_WAIT_STATEMENT]          = execute_wait_statement,
+    [AST_RANDOM_EXPRESSION]       = execute_random_expression,
+    [AST_GLOBAL_ACCESS]           = execute_global_access,
+    [AST_STATIC_ACCESS]           = execute_static_access,
+    [AST_UID_EXPRESSION]          = execute_uid_expression,
+    [AST_SLICE_EXPRESSION]        = execute_slice_expression,
+    [AST_ARGV_EXPRESSION]         = execute_argv_expression,
+    [AST_EVAL_EXPRESSION]         = execute_eval_expression,
+    [AST_EXISTS_EXPRESSION]       = execute_exists_expression,
+    [AST_LISTDIR_EXPRESSION]      = execute_listdir_expression,
+    [AST_TRY_EXCEPT_STATEMENT]    = execute_try_except_statement,
+    [AST_VAR_DECLARATION]         = execute_var_declaration,
+};
+
+static GraveyardValue execute_scratch_statement(Graveyard* gy, AstNode* node) {
+    ScratchMark mark = scratch_mark(&gy->scratch);
+    GraveyardValue result = node_handlers[node->type](gy, node);
+    scratch_release(&gy->scratch, mark);
+    return result;
+}
+
+static void bind_node_handlers(AstNode** slot, void* context) {
+    AstNode* node = *slot;
+    if (node == NULL) return;
+    node->handler = node->releases_scratch ? execute_scratch_statement : node_handlers[node->type];
+    ast_visit_children(node, bind_node_handlers, context);
+}
+
+bool execute(Graveyard *gy) {
+    if (!gy || !gy->ast_root) {
+        fprintf(stderr, "Execution error: Nothing to execute (no AST).\n");
+        return false;
     }
+    
+    bool owns_stack_base = gy->stack_base == 0;
+    if (owns_stack_base) native_stack_init(gy);
 
-    free(monolith->entries);
-    monolith->entries = new_entries;
-    monolith->capacity = new_capacity;
+    gy->had_runtime_error = false;
+    gy->last_executed_value = execute_node(gy, gy->ast_root);
+
+    if (owns_stack_base) {
+        stack_segments_release(gy, 0);
+        gy->stack_base = 0;
+    }
+    return !gy->had_runtime_error; 
 }
 
-bool monolith_set(Monolith* monolith, const char* key, GraveyardValue value) {
-    if (monolith->count + 1 > monolith->capacity * 0.75) {
-        int new_capacity = monolith->capacity < 8 ? 8 : monolith->capacity * 2;
-        monolith_resize(monolith, new_capacity);
+//OPTIMIZE------------------------------------------------------------------------
+
+typedef struct {
+    Graveyard* gy;
+    int level;
+} Optimizer;
+
+static bool literal_value(AstNode* node, GraveyardValue* out_value) {
+    if (node == NULL || node->type != AST_LITERAL) return false;
+
+    switch (node->as.literal.value.type) {
+        case NUMBER:     *out_value = create_number_value(node->as.literal.number); return true;
+        case STRING:     *out_value = OBJECT_VALUE(VAL_STRING, node->as.literal.string); return true;
+        case TRUEVALUE:  *out_value = create_bool_value(true); return true;
+        case FALSEVALUE: *out_value = create_bool_value(false); return true;
+        case NULLVALUE:  *out_value = create_null_value(); return true;
+        default:         return false;
     }
+}
 
-    MonolithEntry* entry = find_entry(monolith->entries, monolith->capacity, key);
-    bool is_new_key = entry->key == NULL;
+static bool literal_truthiness(AstNode* node, bool* out_truthy) {
+    GraveyardValue value;
+    if (!literal_value(node, &value)) return false;
+    *out_truthy = !is_value_falsy(value);
+    return true;
+}
 
-    if (!is_new_key) {
-        dec_ref(entry->value);
+static bool is_foldable_value(GraveyardValue value) {
+    switch (VALUE_TYPE(value)) {
+        case VAL_NUMBER:
+        case VAL_BOOL:
+        case VAL_NULL:
+            return true;
+        case VAL_STRING:
+            return strlen(AS_STRING(value)->chars) == AS_STRING(value)->length;
+        default:
+            return false;
     }
-    
-    inc_ref(value);
-    entry->value = value;
+}
 
-    if (is_new_key) {
-        monolith->count++;
-        entry->key = strdup(key);
-        if (entry->key == NULL) {
-            perror("monolith_set: strdup failed");
+static bool is_foldable_unary(GraveyardTokenType op_type) {
+    switch (op_type) {
+        case MINUS:
+        case NOT:
+        case TYPEOF:
+        case CASTBOOLEAN:
+        case CASTINTEGER:
+        case CASTFLOAT:
+        case CASTSTRING:
+        case ASTERISK:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool is_foldable_binary(GraveyardTokenType op_type) {
+    switch (op_type) {
+        case EQUALITY:
+        case INEQUALITY:
+        case XOR:
+        case PLUS:
+        case MINUS:
+        case ASTERISK:
+        case FORWARDSLASH:
+        case EXPONENTIATION:
+        case MODULO:
+        case RIGHTANGLEBRACKET:
+        case LEFTANGLEBRACKET:
+        case GREATERTHANEQUAL:
+        case LESSTHANEQUAL:
+            return true;
+        default:
             return false;
+    }
+}
+
+static AstNode* create_literal_node(Optimizer* optimizer, GraveyardValue value, int line) {
+    AstNode* node = ast_arena_alloc(&optimizer->gy->ast_arena, sizeof(AstNode));
+    node->type = AST_LITERAL;
+    node->line = line;
+
+    AstToken* token = &node->as.literal.value;
+    token->line = line;
+    switch (VALUE_TYPE(value)) {
+        case VAL_NUMBER: {
+            char lexeme[32];
+            snprintf(lexeme, sizeof(lexeme), "%.17g", AS_NUMBER(value));
+            token->type = NUMBER;
+            token->lexeme = intern_cstring(&optimizer->gy->symbols, lexeme)->chars;
+            node->as.literal.number = AS_NUMBER(value);
+            break;
         }
+        case VAL_STRING:
+            token->type = STRING;
+            token->lexeme = intern_symbol(&optimizer->gy->symbols, AS_STRING(value)->chars, (int)AS_STRING(value)->length)->chars;
+            inc_ref(value);
+            node->as.literal.string = AS_STRING(value);
+            ast_arena_own(&optimizer->gy->ast_arena, node);
+            break;
+        case VAL_BOOL:
+            token->type = AS_BOOL(value) ? TRUEVALUE : FALSEVALUE;
+            token->lexeme = AS_BOOL(value) ? "$" : "%";
+            break;
+        default:
+            token->type = NULLVALUE;
+            token->lexeme = "|";
+            break;
     }
-    
-    return true;
+    return node;
 }
 
-bool monolith_get(Monolith* monolith, const char* key, GraveyardValue* out_value) {
-    if (monolith->count == 0) return false;
+static AstNode* create_empty_block(Optimizer* optimizer, int line) {
+    AstNode* node = ast_arena_alloc(&optimizer->gy->ast_arena, sizeof(AstNode));
+    node->type = AST_BLOCK;
+    node->line = line;
+    ast_arena_own(&optimizer->gy->ast_arena, node);
+    return node;
+}
 
-    MonolithEntry* entry = find_entry(monolith->entries, monolith->capacity, key);
-    if (entry->key == NULL) {
-        return false;
+static void fold_result(Optimizer* optimizer, AstNode** slot, GraveyardValue result) {
+    Graveyard* gy = optimizer->gy;
+    if (gy->had_runtime_error) {
+        gy->had_runtime_error = false;
+        return;
     }
-
-    *out_value = entry->value;
-    return true;
+    if (is_foldable_value(result)) {
+        *slot = create_literal_node(optimizer, result, (*slot)->line);
+    }
+    dec_ref(gy, result);
 }
 
-static GraveyardValue create_type_value(GraveyardValue name) {
-    GraveyardValue val;
-    val.type = VAL_TYPE;
-    GraveyardType* type = malloc(sizeof(GraveyardType));
-    type->ref_count = 1;
-    type->name = name;
-    monolith_init(&type->fields);
-    monolith_init(&type->methods);
-    val.as.type = type;
-    return val;
+static void replace_with_child(AstNode** slot, AstNode** child) {
+    *slot = *child;
 }
 
-static GraveyardValue create_instance_value(GraveyardValue type_value) {
-    GraveyardValue val;
-    val.type = VAL_INSTANCE;
-    GraveyardInstance* instance = malloc(sizeof(GraveyardInstance));
-    instance->ref_count = 1;
-    instance->type = type_value.as.type;
-    
-    inc_ref(type_value);
-
-    monolith_init(&instance->fields);
-    val.as.instance = instance;
-    return val;
-}
+static void prune_if_statement(Optimizer* optimizer, AstNode* node) {
+    AstNodeIfStatement* stmt = &node->as.if_statement;
+    bool truthy;
 
-Environment* environment_new(Environment* enclosing) {
-    Environment* env = malloc(sizeof(Environment));
-    env->enclosing = enclosing;
-    monolith_init(&env->values);
-    return env;
+    size_t kept = 0;
+    for (size_t i = 0; i < stmt->else_if_count; i++) {
+        AstNodeElseIfClause clause = stmt->else_if_clauses[i];
+        if (!literal_truthiness(clause.condition, &truthy)) {
+            stmt->else_if_clauses[kept++] = clause;
+            continue;
+        }
+        if (!truthy) continue;
+        stmt->else_branch = clause.body;
+        break;
+    }
+    stmt->else_if_count = kept;
+
+    while (literal_truthiness(stmt->condition, &truthy)) {
+        if (truthy) {
+            stmt->else_if_count = 0;
+            stmt->else_branch = NULL;
+            return;
+        }
+
+        if (stmt->else_if_count > 0) {
+            stmt->condition = stmt->else_if_clauses[0].condition;
+            stmt->then_branch = stmt->else_if_clauses[0].body;
+            memmove(stmt->else_if_clauses, stmt->else_if_clauses + 1, (stmt->else_if_count - 1) * sizeof(AstNodeElseIfClause));
+            stmt->else_if_count--;
+        } else if (stmt->else_branch != NULL) {
+            stmt->condition = create_literal_node(optimizer, create_bool_value(true), node->line);
+            stmt->then_branch = stmt->else_branch;
+            stmt->else_branch = NULL;
+            return;
+        } else {
+            stmt->condition = create_literal_node(optimizer, create_bool_value(false), node->line);
+            stmt->then_branch = create_empty_block(optimizer, node->line);
+            return;
+        }
+    }
 }
 
-void environment_define(Environment* env, const char* name, GraveyardValue value) {
-    monolith_set(&env->values, name, value);
-}
+static void optimize_node(AstNode** slot, void* context) {
+    Optimizer* optimizer = (Optimizer*)context;
+    AstNode* node = *slot;
+    if (node == NULL) return;
 
-bool environment_assign(Environment* env, const char* name, GraveyardValue value) {
-    MonolithEntry* entry = find_entry(env->values.entries, env->values.capacity, name);
-    if (entry->key != NULL) {
-        monolith_set(&env->values, name, value);
-        return true;
-    }
+    ast_visit_children(node, optimize_node, optimizer);
 
-    if (env->enclosing != NULL) {
-        return environment_assign(env->enclosing, name, value);
-    }
+    GraveyardValue left;
+    GraveyardValue right;
+    bool truthy;
 
-    return false;
-}
+    switch (node->type) {
+        case AST_UNARY_OP: {
+            GraveyardTokenType op_type = node->as.unary_op.operator.type;
+            if (is_foldable_unary(op_type) && literal_value(node->as.unary_op.right, &right)) {
+                fold_result(optimizer, slot, evaluate_unary_op(optimizer->gy, op_type, right, node->line));
+            }
+            return;
+        }
 
-bool environment_get(Environment* env, const char* name, GraveyardValue* out_value) {
-    if (monolith_get(&env->values, name, out_value)) {
-        return true;
-    }
+        case AST_BINARY_OP: {
+            GraveyardTokenType op_type = node->as.binary_op.operator.type;
+            if (op_type == DOUBLEQUESTION) {
+                if (optimizer->level >= 2 && literal_value(node->as.binary_op.left, &left)) {
+                    replace_with_child(slot, VALUE_TYPE(left) != VAL_NULL ? &node->as.binary_op.left : &node->as.binary_op.right);
+                }
+                return;
+            }
+            if (is_foldable_binary(op_type) && literal_value(node->as.binary_op.left, &left) && literal_value(node->as.binary_op.right, &right)) {
+                fold_result(optimizer, slot, evaluate_binary_op(optimizer->gy, op_type, left, right, node->line));
+            }
+            return;
+        }
 
-    if (env->enclosing != NULL) {
-        return environment_get(env->enclosing, name, out_value);
-    }
+        case AST_LOGICAL_OP: {
+            GraveyardTokenType op_type = node->as.logical_op.operator.type;
+            if (optimizer->level < 2 || (op_type != AND && op_type != OR)) return;
+            if (!literal_truthiness(node->as.logical_op.left, &truthy)) return;
+            bool keep_left = op_type == AND ? !truthy : truthy;
+            replace_with_child(slot, keep_left ? &node->as.logical_op.left : &node->as.logical_op.right);
+            return;
+        }
 
-    return false;
-}
+        case AST_TERNARY_EXPRESSION:
+            if (optimizer->level >= 2 && literal_truthiness(node->as.ternary_expression.condition, &truthy)) {
+                replace_with_child(slot, truthy ? &node->as.ternary_expression.then_expr : &node->as.ternary_expression.else_expr);
+            }
+            return;
 
-static GraveyardValue create_bool_value(bool value) {
-    GraveyardValue val;
-    val.type = VAL_BOOL;
-    val.as.boolean = value;
-    return val;
-}
+        case AST_IF_STATEMENT:
+            if (optimizer->level >= 2) {
+                prune_if_statement(optimizer, node);
+            }
+            return;
 
-static GraveyardValue create_number_value(double value) {
-    GraveyardValue val;
-    val.type = VAL_NUMBER;
-    val.as.number = value;
-    return val;
+        default:
+            return;
+    }
 }
 
-static GraveyardValue create_array_value() {
-    GraveyardValue val;
-    val.type = VAL_ARRAY;
-
-    GraveyardArray* array_obj = malloc(sizeof(GraveyardArray));
-    array_obj->capacity = 8;
-    array_obj->count = 0;
-    array_obj->values = malloc(array_obj->capacity * sizeof(GraveyardValue));
-    array_obj->ref_count = 1;
+bool optimize(Graveyard* gy) {
+    if (gy->optimize_level <= 0 || gy->ast_root == NULL) return true;
 
-    val.as.array = array_obj;
-    return val;
+    Optimizer optimizer = { gy, gy->optimize_level };
+    optimize_node(&gy->ast_root, &optimizer);
+    return true;
 }
 
-static void value_to_string(GraveyardValue value, char* buffer, size_t buffer_size) {
-    if (!buffer || buffer_size == 0) return;
+//VM----------------------------------------------------------------------------
 
-    switch (value.type) {
-        case VAL_NULL:
-            strncpy(buffer, "null", buffer_size - 1);
-            break;
-        case VAL_BOOL:
-            strncpy(buffer, value.as.boolean ? "true" : "false", buffer_size - 1);
-            break;
-        case VAL_NUMBER:
-            snprintf(buffer, buffer_size, "%g", value.as.number);
-            break;
-        case VAL_STRING:
-            snprintf(buffer, buffer_size, "\"%s\"", value.as.string->chars);
-            break;
-        case VAL_FUNCTION:
-            snprintf(buffer, buffer_size, "%s", value.as.function->name.as.string->chars);
-            break;
+typedef enum {
+    OP_CONSTANT,
+    OP_NULL,
+    OP_POP,
+    OP_GET_VARIABLE,
+    OP_SET_VARIABLE,
+    OP_DEFINE_VARIABLE,
+    OP_DEFINE_FUNCTION,
+    OP_BINARY,
+    OP_UNARY,
+    OP_JUMP,
+    OP_JUMP_IF_FALSE,
+    OP_JUMP_IF_FALSY_OR_POP,
+    OP_JUMP_IF_TRUTHY_OR_POP,
+    OP_JUMP_IF_NOT_NULL_OR_POP,
+    OP_PUSH_SCOPE,
+    OP_POP_SCOPE,
+    OP_ARRAY,
+    OP_CHECK_SUBSCRIPT,
+    OP_SUBSCRIPT,
+    OP_GET_MEMBER,
+    OP_GET_METHOD,
+    OP_CHECK_CALL,
+    OP_CHECK_INVOKE,
+    OP_CALL,
+    OP_INVOKE,
+    OP_TAIL_CALL,
+    OP_TAIL_INVOKE,
+    OP_RETURN,
+    OP_PRINT,
+    OP_PRINT_END,
+    OP_FOR_EACH_PREPARE,
+    OP_FOR_EACH_NEXT,
+    OP_FOR_RANGE_CHECK,
+    OP_FOR_RANGE_PREPARE,
+    OP_FOR_RANGE_NEXT,
+    OP_EVAL_NODE,
+    OP_EVAL_STATEMENT,
+    OP_CHECK_BREAK,
+    OP_CHECK_CONTINUE,
+    OP_CHECK_RETURN,
+    OP_CHECK_ERROR,
+    OP_HALT
+} OpCode;
+
+struct Chunk {
+    uint8_t* code;
+    int* lines;
+    size_t count;
+    size_t capacity;
+    GraveyardValue* constants;
+    size_t constant_count;
+    size_t constant_capacity;
+    AstNode** nodes;
+    size_t node_count;
+    size_t node_capacity;
+    bool is_compiled;
+};
 
-        case VAL_ARRAY: {
-            size_t capacity = 128;
-            char* result = malloc(capacity);
-            if (!result) { buffer[0] = '\0'; return; }
-            strcpy(result, "[");
-            size_t len = 1;
+typedef struct LoopContext {
+    struct LoopContext* enclosing;
+    int outer_depth;
+    size_t* break_patches;
+    size_t break_count;
+    size_t break_capacity;
+    size_t* continue_patches;
+    size_t continue_count;
+    size_t continue_capacity;
+} LoopContext;
 
-            GraveyardArray* arr = value.as.array;
-            for (size_t i = 0; i < arr->count; i++) {
-                char element_str[256];
-                value_to_string(arr->values[i], element_str, sizeof(element_str));
-                
-                size_t part_len = strlen(element_str);
-                size_t comma_len = (i < arr->count - 1) ? 2 : 0;
+typedef struct {
+    Chunk* chunk;
+    LoopContext* loop;
+    int scope_depth;
+    bool in_function;
+    bool failed;
+} Compiler;
 
-                if (len + part_len + comma_len + 2 > capacity) {
-                    capacity = (len + part_len + comma_len + 2) * 2;
-                    char* temp = realloc(result, capacity);
-                    if (!temp) { free(result); buffer[0] = '\0'; return; }
-                    result = temp;
-                }
-                
-                strcat(result, element_str);
-                len += part_len;
-                if (comma_len > 0) {
-                    strcat(result, ", ");
-                    len += comma_len;
-                }
-            }
-            strcat(result, "]");
-            strncpy(buffer, result, buffer_size - 1);
-            free(result);
-            break;
-        }
-        case VAL_HASHTABLE: {
-            size_t capacity = 128;
-            char* result = malloc(capacity);
-            if (!result) { buffer[0] = '\0'; return; }
-            strcpy(result, "{");
-            size_t len = 1;
+typedef struct {
+    bool has_break;
+    bool has_continue;
+    bool has_return;
+} FlowScan;
 
-            GraveyardHashtable* ht = value.as.hashtable;
-            int printed = 0;
-            for (int i = 0; i < ht->capacity; i++) {
-                if (ht->entries[i].is_in_use) {
-                    char key_str[256], val_str[256];
-                    value_to_string(ht->entries[i].key, key_str, sizeof(key_str));
-                    value_to_string(ht->entries[i].value, val_str, sizeof(val_str));
+typedef struct {
+    Chunk* chunk;
+    uint8_t* ip;
+    size_t stack_base;
+    Environment* saved_environment;
+    Environment* call_environment;
+    GraveyardValue callee;
+    GraveyardValue receiver;
+} CallFrame;
 
-                    size_t part_len = strlen(key_str) + strlen(val_str) + 2;
-                    size_t comma_len = (printed > 0) ? 2 : 0;
+typedef struct {
+    GraveyardValue* stack;
+    size_t stack_count;
+    size_t stack_capacity;
+    CallFrame* frames;
+    size_t frame_count;
+    size_t frame_capacity;
+} Vm;
+
+static Chunk* chunk_new() {
+    Chunk* chunk = malloc(sizeof(Chunk));
+    if (!chunk) {
+        perror("chunk_new: malloc failed");
+        exit(1);
+    }
+    chunk->code = NULL;
+    chunk->lines = NULL;
+    chunk->count = 0;
+    chunk->capacity = 0;
+    chunk->constants = NULL;
+    chunk->constant_count = 0;
+    chunk->constant_capacity = 0;
+    chunk->nodes = NULL;
+    chunk->node_count = 0;
+    chunk->node_capacity = 0;
+    chunk->is_compiled = true;
+    return chunk;
+}
 
-                    if (len + part_len + comma_len + 2 > capacity) {
-                        capacity = (len + part_len + comma_len + 2) * 2;
-                        char* temp = realloc(result, capacity);
-                        if (!temp) { free(result); buffer[0] = '\0'; return; }
-                        result = temp;
-                    }
+static void chunk_free(Graveyard* gy, Chunk* chunk) {
+    if (!chunk) return;
+    for (size_t i = 0; i < chunk->constant_count; i++) {
+        dec_ref(gy, chunk->constants[i]);
+    }
+    free(chunk->code);
+    free(chunk->lines);
+    free(chunk->constants);
+    free(chunk->nodes);
+    free(chunk);
+}
 
-                    if (comma_len > 0) strcat(result, ", ");
-                    strcat(result, key_str);
-                    strcat(result, ": ");
-                    strcat(result, val_str);
-                    len += part_len + comma_len;
-                    printed++;
-                }
-            }
-            strcat(result, "}");
-            strncpy(buffer, result, buffer_size - 1);
-            free(result);
-            break;
+static void chunk_write(Chunk* chunk, uint8_t byte, int line) {
+    if (chunk->count >= chunk->capacity) {
+        size_t new_capacity = chunk->capacity < 64 ? 64 : chunk->capacity * 2;
+        uint8_t* new_code = realloc(chunk->code, new_capacity);
+        int* new_lines = realloc(chunk->lines, new_capacity * sizeof(int));
+        if (!new_code || !new_lines) {
+            perror("chunk_write: realloc failed");
+            exit(1);
         }
-        default:
-            strncpy(buffer, "(unknown)", buffer_size - 1);
-            break;
+        chunk->code = new_code;
+        chunk->lines = new_lines;
+        chunk->capacity = new_capacity;
     }
-    buffer[buffer_size - 1] = '\0';
+    chunk->code[chunk->count] = byte;
+    chunk->lines[chunk->count] = line;
+    chunk->count++;
 }
 
-static bool is_value_falsy(GraveyardValue value) {
-    switch (value.type) {
-        case VAL_NULL:   return true;
-        case VAL_BOOL:   return !value.as.boolean;
-        case VAL_NUMBER: return value.as.number == 0;
-        case VAL_ARRAY:  return value.as.array->count == 0;
-        default:         return false;
+static void chunk_write_u32(Chunk* chunk, uint32_t value, int line) {
+    uint8_t bytes[4];
+    memcpy(bytes, &value, sizeof(bytes));
+    for (int i = 0; i < 4; i++) {
+        chunk_write(chunk, bytes[i], line);
     }
 }
 
-static void array_append(GraveyardArray* array, GraveyardValue value) {
-    if (array->count >= array->capacity) {
-        size_t new_capacity = (array->capacity == 0) ? 8 : array->capacity * 2;
-        GraveyardValue* temp = realloc(array->values, new_capacity * sizeof(GraveyardValue));
+static uint32_t chunk_add_constant(Chunk* chunk, GraveyardValue value) {
+    if (chunk->constant_count >= chunk->constant_capacity) {
+        size_t new_capacity = chunk->constant_capacity < 8 ? 8 : chunk->constant_capacity * 2;
+        GraveyardValue* temp = realloc(chunk->constants, new_capacity * sizeof(GraveyardValue));
         if (!temp) {
-            perror("array_append: realloc failed");
+            perror("chunk_add_constant: realloc failed");
             exit(1);
         }
-        array->values = temp;
-        array->capacity = new_capacity;
+        chunk->constants = temp;
+        chunk->constant_capacity = new_capacity;
     }
-    
-    inc_ref(value);
-    array->values[array->count++] = value;
+    chunk->constants[chunk->constant_count] = value;
+    return (uint32_t)chunk->constant_count++;
 }
 
-void monolith_print(Monolith* monolith, int indent);
-
-void print_value(GraveyardValue value) {
-    switch (value.type) {
-        case VAL_BOOL:
-            printf(value.as.boolean ? "$" : "%%");
-            break;
-        case VAL_NULL:
-            printf("|");
-            break;
-        case VAL_NUMBER: {
-            double num = value.as.number;
-            if (fmod(num, 1.0) == 0) {
-                printf("%.0f", num);
-            } else {
-                char buffer[64];
-                snprintf(buffer, sizeof(buffer), "%.15f", num);
-                char* end = buffer + strlen(buffer) - 1;
-                while (end > buffer && *end == '0') { *end = '\0'; end--; }
-                if (end > buffer && *end == '.') { *end = '\0'; }
-                printf("%s", buffer);
-            }
-            break;
+static uint32_t chunk_add_node(Chunk* chunk, AstNode* node) {
+    if (chunk->node_count >= chunk->node_capacity) {
+        size_t new_capacity = chunk->node_capacity < 8 ? 8 : chunk->node_capacity * 2;
+        AstNode** temp = realloc(chunk->nodes, new_capacity * sizeof(AstNode*));
+        if (!temp) {
+            perror("chunk_add_node: realloc failed");
+            exit(1);
         }
-        case VAL_STRING:
-            printf("%s", value.as.string->chars);
-            break;
-        case VAL_ARRAY:
-            printf("[");
-            for (size_t i = 0; i < value.as.array->count; i++) {
-                print_value(value.as.array->values[i]);
-                if (i < value.as.array->count - 1) {
-                    printf(", ");
-                }
-            }
-            printf("]");
-            break;
-        case VAL_HASHTABLE:
-            printf("{");
-            int printed = 0;
-            for (int i = 0; i < value.as.hashtable->capacity; i++) {
-                HashtableEntry* entry = &value.as.hashtable->entries[i];
-                if (entry->is_in_use) {
-                    if (printed > 0) printf(", ");
-                    print_value(entry->key);
-                    printf(": ");
-                    print_value(entry->value);
-                    printed++;
-                }
-            }
-            printf("}");
-            break;
-        case VAL_TYPE:
-            printf("<type: %s>", value.as.type->name.as.string->chars);
-            break;
-        case VAL_INSTANCE:
-            printf("<instance of %s> {\n", value.as.instance->type->name.as.string->chars);
-            monolith_print(&value.as.instance->fields, 2);
-            printf("  }");
-            break;
-        case VAL_FUNCTION:
-            printf("<function: %s>", value.as.function->name.as.string->chars);
-            break;
-        case VAL_BOUND_METHOD:
-            printf("<method: %s bound to instance>", value.as.bound_method->function.as.function->name.as.string->chars);
-            break;
-        case VAL_ENVIRONMENT:
-            printf("<namespace>");
-            break;
+        chunk->nodes = temp;
+        chunk->node_capacity = new_capacity;
     }
+    chunk->nodes[chunk->node_count] = node;
+    return (uint32_t)chunk->node_count++;
 }
 
-void monolith_print(Monolith* monolith, int indent) {
-    char indent_str[32] = "";
-    for (int i = 0; i < indent; i++) {
-        strcat(indent_str, "  ");
-    }
+static void emit_op(Compiler* compiler, OpCode op, int line) {
+    chunk_write(compiler->chunk, (uint8_t)op, line);
+}
 
-    if (monolith->count == 0) {
-        printf("%s(empty)\n", indent_str);
-        return;
-    }
+static void emit_op_u32(Compiler* compiler, OpCode op, uint32_t operand, int line) {
+    chunk_write(compiler->chunk, (uint8_t)op, line);
+    chunk_write_u32(compiler->chunk, operand, line);
+}
 
-    for (int i = 0; i < monolith->capacity; i++) {
-        MonolithEntry* entry = &monolith->entries[i];
-        if (entry->key != NULL) {
-            printf("%s%s = ", indent_str, entry->key);
-            print_value(entry->value);
-            printf("\n");
-        }
-    }
+static void emit_op_node(Compiler* compiler, OpCode op, AstNode* node) {
+    emit_op_u32(compiler, op, chunk_add_node(compiler->chunk, node), node->line);
+}
+
+static void emit_constant(Compiler* compiler, GraveyardValue value, int line) {
+    emit_op_u32(compiler, OP_CONSTANT, chunk_add_constant(compiler->chunk, value), line);
+}
+
+static size_t emit_jump_operand(Compiler* compiler, int line) {
+    size_t offset = compiler->chunk->count;
+    chunk_write_u32(compiler->chunk, 0, line);
+    return offset;
+}
+
+static size_t emit_jump(Compiler* compiler, OpCode op, int line) {
+    emit_op(compiler, op, line);
+    return emit_jump_operand(compiler, line);
+}
+
+static void patch_jump_to(Compiler* compiler, size_t operand_offset, size_t target) {
+    uint32_t value = (uint32_t)target;
+    memcpy(&compiler->chunk->code[operand_offset], &value, sizeof(value));
 }
 
-void print_environment_recursive(Environment* env, int depth) {
-    if (env == NULL) return;
+static void patch_jump(Compiler* compiler, size_t operand_offset) {
+    patch_jump_to(compiler, operand_offset, compiler->chunk->count);
+}
 
-    printf("\n--- Scope Level %d ", depth);
-    if (depth == 0) {
-        printf("(Global) ---\n");
-    } else {
-        printf("---\n");
+static void emit_scope_pops(Compiler* compiler, int count, int line) {
+    for (int i = 0; i < count; i++) {
+        emit_op(compiler, OP_POP_SCOPE, line);
     }
-    
-    monolith_print(&env->values, 1);
-    
-    print_environment_recursive(env->enclosing, depth + 1);
 }
 
-void graveyard_debug_print(Graveyard* gy) {
-    printf("========================================\n");
-    printf("        GRAVEYARD DEBUG DUMP\n");
-    printf("========================================\n");
-    
-    printf("\n--- Defined Namespaces ---\n");
-    monolith_print(&gy->namespaces, 1);
-    
-    Environment* global_env = get_global_environment(gy);
-    printf("\n--- Defined Types ---\n");
-    bool has_types = false;
-    for (int i = 0; i < global_env->values.capacity; i++) {
-        MonolithEntry* entry = &global_env->values.entries[i];
-        if (entry->key != NULL && entry->value.type == VAL_TYPE) {
-            printf("  %s\n", entry->key);
-            has_types = true;
+static void loop_add_patch(size_t** patches, size_t* count, size_t* capacity, size_t offset) {
+    if (*count >= *capacity) {
+        *capacity = *capacity < 4 ? 4 : *capacity * 2;
+        size_t* temp = realloc(*patches, *capacity * sizeof(size_t));
+        if (!temp) {
+            perror("loop_add_patch: realloc failed");
+            exit(1);
         }
+        *patches = temp;
     }
-    if (!has_types) printf("  (none)\n");
-
-    printf("\n--- Final Environment Chain ---\n");
-    print_environment_recursive(gy->environment, 0);
-    
-    printf("\n========================================\n");
+    (*patches)[(*count)++] = offset;
 }
 
-void graveyard_free(Graveyard *gy) {
-    if (!gy) return;
-    // printf("DEBUG: Starting final cleanup...\n"); // <-- ADD THIS
-    free(gy->source_code);
-    free(gy->tokens);
-    free_ast(gy->ast_root);
-    
-    dec_ref(gy->arguments);
-    dec_ref(gy->last_executed_value);
-    dec_ref(gy->return_value);
+static void scan_flow(AstNode** slot, void* context) {
+    AstNode* node = *slot;
+    FlowScan* scan = (FlowScan*)context;
+    if (node == NULL) return;
 
-    Environment* env = gy->environment;
-    while (env != NULL) {
-        Environment* next = env->enclosing;
-        monolith_free(&env->values);
-        free(env);
-        env = next;
-    }
-    
-    for (int i = 0; i < gy->namespaces.capacity; i++) {
-        MonolithEntry* entry = &gy->namespaces.entries[i];
-        if (entry->key != NULL) {
-            Environment* ns_env = entry->value.as.environment;
-            monolith_free(&ns_env->values);
-            free(ns_env);
+    switch (node->type) {
+        case AST_BREAK_STATEMENT:
+            scan->has_break = true;
+            return;
+        case AST_CONTINUE_STATEMENT:
+            scan->has_continue = true;
+            return;
+        case AST_FUNCTION_DECLARATION:
+        case AST_TYPE_DECLARATION:
+            return;
+        case AST_WHILE_STATEMENT:
+        case AST_FOR_STATEMENT: {
+            FlowScan inner = { false, false, false };
+            ast_visit_children(node, scan_flow, &inner);
+            scan->has_return = scan->has_return || inner.has_return;
+            return;
         }
+        case AST_RETURN_STATEMENT:
+            scan->has_return = true;
+            break;
+        default:
+            break;
     }
-    monolith_free(&gy->namespaces);
-    // printf("DEBUG: Cleanup complete. Freeing main struct.\n"); // <-- ADD THIS
-    free(gy);
+    ast_visit_children(node, scan_flow, context);
 }
 
-Graveyard *graveyard_init(const char *mode, const char *filename) {
-    Graveyard *gy = malloc(sizeof(Graveyard));
-    if (!gy) {
-        perror("graveyard_init: malloc failed");
-        return NULL;
+static void compile_statement(Compiler* compiler, AstNode* node);
+
+static void compile_block_statements(Compiler* compiler, AstNode* block) {
+    for (size_t i = 0; i < block->as.block.count && !compiler->failed; i++) {
+        compile_statement(compiler, block->as.block.statements[i]);
     }
-    gy->mode = mode;
-    gy->filename = filename;
-    gy->source_code = NULL;
-    gy->tokens = NULL;
-    gy->token_count = 0;
-    gy->ast_root = NULL;
-    gy->last_executed_value = create_null_value();
-    gy->environment = malloc(sizeof(Environment));
-    gy->environment->enclosing = NULL;
-    monolith_init(&gy->environment->values);
-    monolith_init(&gy->namespaces);
-    gy->is_returning = false;
-    gy->return_value = create_null_value();
-    gy->encountered_break = false;
-    gy->encountered_continue = false;
-    gy->had_runtime_error = false;
-    struct timespec ts;
-    timespec_get(&ts, TIME_UTC);
-    srand((unsigned int)ts.tv_sec ^ (unsigned int)ts.tv_nsec);
-    return gy;
 }
 
-bool execute(Graveyard *gy);
+static void compile_scoped_block(Compiler* compiler, AstNode* block) {
+    emit_op_node(compiler, OP_PUSH_SCOPE, block);
+    compiler->scope_depth++;
+    compile_block_statements(compiler, block);
+    compiler->scope_depth--;
+    emit_op(compiler, OP_POP_SCOPE, block->line);
+}
+
+static void clear_scratch_allocation(AstNode** slot, void* context) {
+    AstNode* node = *slot;
+    if (node == NULL) return;
+    node->allocates_scratch = false;
+    ast_visit_children(node, clear_scratch_allocation, context);
+}
 
-static GraveyardValue execute_node(Graveyard* gy, AstNode* node) {
+static void compile_expression(Compiler* compiler, AstNode* node) {
     switch (node->type) {
-        case AST_PROGRAM: {
-            GraveyardValue last_value = create_null_value();
-            for (size_t i = 0; i < node->as.program.count; i++) {
-                dec_ref(last_value);
-                
-                last_value = execute_node(gy, node->as.program.statements[i]);
-                if (gy->had_runtime_error) {
-                    break;
+        case AST_LITERAL: {
+            switch (node->as.literal.value.type) {
+                case STRING: {
+                    GraveyardValue string_val = OBJECT_VALUE(VAL_STRING, node->as.literal.string);
+                    inc_ref(string_val);
+                    emit_constant(compiler, string_val, node->line);
+                    return;
                 }
+                case NUMBER:
+                    emit_constant(compiler, create_number_value(node->as.literal.number), node->line);
+                    return;
+                case TRUEVALUE:
+                    emit_constant(compiler, create_bool_value(true), node->line);
+                    return;
+                case FALSEVALUE:
+                    emit_constant(compiler, create_bool_value(false), node->line);
+                    return;
+                case NULLVALUE:
+                    emit_op(compiler, OP_NULL, node->line);
+                    return;
+                default:
+                    break;
             }
-            return last_value;
+            break;
         }
 
-        case AST_PRINT_STATEMENT: {
-            for (size_t i = 0; i < node->as.print_stmt.count; i++) {
-                GraveyardValue value = execute_node(gy, node->as.print_stmt.expressions[i]);
-                if (gy->had_runtime_error) {
-                    dec_ref(value);
-                    return create_null_value();
-                }
-                print_value(value);
-                
-                dec_ref(value);
+        case AST_IDENTIFIER:
+            emit_op_node(compiler, OP_GET_VARIABLE, node);
+            return;
 
-                if (i < node->as.print_stmt.count - 1) {
-                    printf(" ");
-                }
-            }
-            if (!gy->had_runtime_error) {
-                printf("\n");
+        case AST_ASSIGNMENT: {
+            AstNode* target_node = node->as.assignment.left;
+            if (target_node->type != AST_IDENTIFIER) break;
+            compile_expression(compiler, node->as.assignment.value);
+            emit_op_node(compiler, OP_SET_VARIABLE, target_node);
+            return;
+        }
+
+        case AST_BINARY_OP: {
+            GraveyardTokenType op_type = node->as.binary_op.operator.type;
+            compile_expression(compiler, node->as.binary_op.left);
+            if (op_type == DOUBLEQUESTION) {
+                size_t end_jump = emit_jump(compiler, OP_JUMP_IF_NOT_NULL_OR_POP, node->line);
+                compile_expression(compiler, node->as.binary_op.right);
+                patch_jump(compiler, end_jump);
+                return;
             }
-            return create_null_value();
+            compile_expression(compiler, node->as.binary_op.right);
+            emit_op_node(compiler, OP_BINARY, node);
+            return;
         }
 
-        case AST_SCAN_STATEMENT: {
-            GraveyardValue prompt = execute_node(gy, node->as.scan_statement.prompt);
-            print_value(prompt);
-            fflush(stdout);
-            dec_ref(prompt);
+        case AST_UNARY_OP:
+            compile_expression(compiler, node->as.unary_op.right);
+            emit_op_u32(compiler, OP_UNARY, (uint32_t)node->as.unary_op.operator.type, node->line);
+            return;
 
-            char input_buffer[1024];
-            if (fgets(input_buffer, sizeof(input_buffer), stdin)) {
-                input_buffer[strcspn(input_buffer, "\n")] = 0;
+        case AST_LOGICAL_OP: {
+            GraveyardTokenType op_type = node->as.logical_op.operator.type;
+            if (op_type != AND && op_type != OR) break;
+            compile_expression(compiler, node->as.logical_op.left);
+            size_t end_jump = emit_jump(compiler, op_type == AND ? OP_JUMP_IF_FALSY_OR_POP : OP_JUMP_IF_TRUTHY_OR_POP, node->line);
+            compile_expression(compiler, node->as.logical_op.right);
+            patch_jump(compiler, end_jump);
+            return;
+        }
 
-                GraveyardValue input_val = create_string_value(input_buffer);
-                const char* var_name = node->as.scan_statement.variable.lexeme;
+        case AST_TERNARY_EXPRESSION: {
+            compile_expression(compiler, node->as.ternary_expression.condition);
+            size_t else_jump = emit_jump(compiler, OP_JUMP_IF_FALSE, node->line);
+            compile_expression(compiler, node->as.ternary_expression.then_expr);
+            size_t end_jump = emit_jump(compiler, OP_JUMP, node->line);
+            patch_jump(compiler, else_jump);
+            compile_expression(compiler, node->as.ternary_expression.else_expr);
+            patch_jump(compiler, end_jump);
+            return;
+        }
 
-                environment_define(gy->environment, var_name, input_val);
-                dec_ref(input_val);
+        case AST_ARRAY_LITERAL:
+            for (size_t i = 0; i < node->as.array_literal.count; i++) {
+                compile_expression(compiler, node->as.array_literal.elements[i]);
             }
-            return create_null_value();
+            emit_op_u32(compiler, OP_ARRAY, (uint32_t)node->as.array_literal.count, node->line);
+            return;
+
+        case AST_SUBSCRIPT: {
+            compile_expression(compiler, node->as.subscript.array);
+            size_t end_jump = emit_jump(compiler, OP_CHECK_SUBSCRIPT, node->line);
+            compile_expression(compiler, node->as.subscript.index);
+            emit_op(compiler, OP_SUBSCRIPT, node->line);
+            patch_jump(compiler, end_jump);
+            return;
         }
 
-        case AST_LITERAL: {
-            Token literal_token = node->as.literal.value;
-            switch (literal_token.type) {
-                case TYPE: {
-                    char type_name_buffer[MAX_LEXEME_LEN];
-                    const char* lexeme = literal_token.lexeme;
-                    size_t len = strlen(lexeme);
-
-                    if (len > 2) {
-                        size_t type_name_len = len - 2;
-                        strncpy(type_name_buffer, lexeme + 1, type_name_len);
-                        type_name_buffer[type_name_len] = '\0';
-                    } else {
-                        type_name_buffer[0] = '\0';
-                    }
+        case AST_MEMBER_ACCESS:
+            compile_expression(compiler, node->as.member_access.object);
+            emit_op_node(compiler, OP_GET_MEMBER, node);
+            return;
 
-                    GraveyardValue type_val;
-                    if (!environment_get(gy->environment, type_name_buffer, &type_val)) {
-                        runtime_error(gy, node->line, "Type <%s> is not defined", type_name_buffer);
-                        return create_null_value();
-                    }
-                    if (type_val.type != VAL_TYPE) {
-                        runtime_error(gy, node->line, "<%s> is not a type", type_name_buffer);
-                        return create_null_value();
-                    }
-                    
-                    GraveyardValue instance_val = create_instance_value(type_val);
-                    
-                    GraveyardType* type = type_val.as.type;
-                    GraveyardInstance* instance = instance_val.as.instance;
-                    for (int i = 0; i < type->fields.capacity; i++) {
-                        MonolithEntry* entry = &type->fields.entries[i];
-                        if (entry->key != NULL) {
-                            monolith_set(&instance->fields, entry->key, entry->value);
-                        }
-                    }
-                    
-                    return instance_val;
-                }
-                case STRING:
-                    return create_string_value(literal_token.lexeme);
-                case NUMBER:
-                    return create_number_value(strtod(literal_token.lexeme, NULL));
-                case TRUEVALUE:
-                    return create_bool_value(true);
-                case FALSEVALUE:
-                    return create_bool_value(false);
-                case NULLVALUE:
-                    return create_null_value();
-                default:
-                    return create_null_value();
+        case AST_CALL_EXPRESSION: {
+            uint32_t arg_count = (uint32_t)node->as.call_expression.arg_count;
+            AstNode* callee = node->as.call_expression.callee;
+            bool is_invoke = callee->type == AST_MEMBER_ACCESS;
+            bool is_tail = node->as.call_expression.is_tail_call && compiler->in_function;
+            if (is_invoke) {
+                compile_expression(compiler, callee->as.member_access.object);
+                emit_op_node(compiler, OP_GET_METHOD, callee);
+            } else {
+                compile_expression(compiler, callee);
+            }
+            emit_op_u32(compiler, is_invoke ? OP_CHECK_INVOKE : OP_CHECK_CALL, arg_count, node->line);
+            size_t end_jump = emit_jump_operand(compiler, node->line);
+            for (size_t i = 0; i < arg_count; i++) {
+                compile_expression(compiler, node->as.call_expression.arguments[i]);
             }
+            if (is_tail) {
+                emit_op_u32(compiler, is_invoke ? OP_TAIL_INVOKE : OP_TAIL_CALL, arg_count, node->line);
+            } else {
+                emit_op_u32(compiler, is_invoke ? OP_INVOKE : OP_CALL, arg_count, node->line);
+            }
+            patch_jump(compiler, end_jump);
+            return;
         }
 
-        case AST_ARRAY_LITERAL: {
-            GraveyardValue array_val = create_array_value();
+        default:
+            break;
+    }
 
-            for (size_t i = 0; i < node->as.array_literal.count; i++) {
-                GraveyardValue element_value = execute_node(gy, node->as.array_literal.elements[i]);
-                array_append(array_val.as.array, element_value);
-                
-                dec_ref(element_value);
+    clear_scratch_allocation(&node, NULL);
+    emit_op_node(compiler, OP_EVAL_NODE, node);
+}
+
+static void compile_loop_end(Compiler* compiler, LoopContext* loop, size_t continue_target, size_t break_target) {
+    for (size_t i = 0; i < loop->continue_count; i++) {
+        patch_jump_to(compiler, loop->continue_patches[i], continue_target);
+    }
+    for (size_t i = 0; i < loop->break_count; i++) {
+        patch_jump_to(compiler, loop->break_patches[i], break_target);
+    }
+    free(loop->continue_patches);
+    free(loop->break_patches);
+    compiler->loop = loop->enclosing;
+}
+
+static void compile_loop_body(Compiler* compiler, LoopContext* loop, AstNode* body) {
+    loop->enclosing = compiler->loop;
+    loop->outer_depth = compiler->scope_depth;
+    loop->break_patches = NULL;
+    loop->break_count = 0;
+    loop->break_capacity = 0;
+    loop->continue_patches = NULL;
+    loop->continue_count = 0;
+    loop->continue_capacity = 0;
+    compiler->loop = loop;
+
+    compiler->scope_depth++;
+    compile_block_statements(compiler, body);
+    compiler->scope_depth--;
+}
+
+static void compile_fallback_statement(Compiler* compiler, AstNode* node) {
+    FlowScan scan = { false, false, false };
+    scan_flow(&node, &scan);
+
+    emit_op_node(compiler, OP_EVAL_STATEMENT, node);
+
+    if (scan.has_return) {
+        if (!compiler->in_function) {
+            compiler->failed = true;
+            return;
+        }
+        emit_op(compiler, OP_CHECK_RETURN, node->line);
+    }
+    if (scan.has_break || scan.has_continue) {
+        LoopContext* loop = compiler->loop;
+        if (loop == NULL) {
+            compiler->failed = true;
+            return;
+        }
+        if (scan.has_break) {
+            emit_op_u32(compiler, OP_CHECK_BREAK, (uint32_t)(compiler->scope_depth - loop->outer_depth), node->line);
+            loop_add_patch(&loop->break_patches, &loop->break_count, &loop->break_capacity, emit_jump_operand(compiler, node->line));
+        }
+        if (scan.has_continue) {
+            emit_op_u32(compiler, OP_CHECK_CONTINUE, (uint32_t)(compiler->scope_depth - loop->outer_depth - 1), node->line);
+            loop_add_patch(&loop->continue_patches, &loop->continue_count, &loop->continue_capacity, emit_jump_operand(compiler, node->line));
+        }
+    }
+}
+
+static void compile_statement(Compiler* compiler, AstNode* node) {
+    switch (node->type) {
+        case AST_EXPRESSION_STATEMENT:
+            compile_expression(compiler, node->as.expression_statement.expression);
+            emit_op(compiler, OP_POP, node->line);
+            return;
+
+        case AST_PRINT_STATEMENT: {
+            size_t count = node->as.print_stmt.count;
+            size_t* end_jumps = malloc((count > 0 ? count : 1) * sizeof(size_t));
+            if (!end_jumps) {
+                perror("compile_statement: malloc failed");
+                exit(1);
             }
-            
-            return array_val;
+            for (size_t i = 0; i < count; i++) {
+                compile_expression(compiler, node->as.print_stmt.expressions[i]);
+                emit_op_u32(compiler, OP_PRINT, i == count - 1 ? 1 : 0, node->line);
+                end_jumps[i] = emit_jump_operand(compiler, node->line);
+            }
+            emit_op(compiler, OP_PRINT_END, node->line);
+            for (size_t i = 0; i < count; i++) {
+                patch_jump(compiler, end_jumps[i]);
+            }
+            free(end_jumps);
+            return;
         }
 
-        case AST_SUBSCRIPT: {
-            GraveyardValue array_val = execute_node(gy, node->as.subscript.array);
-            if (array_val.type != VAL_ARRAY) {
-                runtime_error(gy, node->line, "Only arrays are subscriptable");
-                dec_ref(array_val);
-                return create_null_value();
+        case AST_VAR_DECLARATION:
+            if (node->as.var_declaration.initializer != NULL) {
+                compile_expression(compiler, node->as.var_declaration.initializer);
+            } else {
+                emit_op(compiler, OP_NULL, node->line);
             }
+            emit_op_node(compiler, OP_DEFINE_VARIABLE, node);
+            return;
 
-            GraveyardValue index_val = execute_node(gy, node->as.subscript.index);
-            if (index_val.type != VAL_NUMBER) {
-                runtime_error(gy, node->line, "Array index must be an integer");
-                dec_ref(array_val);
-                dec_ref(index_val);
-                return create_null_value();
+        case AST_FUNCTION_DECLARATION:
+            emit_op_node(compiler, OP_DEFINE_FUNCTION, node);
+            return;
+
+        case AST_IF_STATEMENT: {
+            size_t clause_count = node->as.if_statement.else_if_count + 1;
+            size_t* end_jumps = malloc(clause_count * sizeof(size_t));
+            if (!end_jumps) {
+                perror("compile_statement: malloc failed");
+                exit(1);
             }
-            
-            double raw_index = index_val.as.number;
-            if (raw_index < 0 || fmod(raw_index, 1.0) != 0) {
-                runtime_error(gy, node->line, "Array index must be a non-negative integer");
-                dec_ref(array_val);
-                dec_ref(index_val);
-                return create_null_value();
+
+            compile_expression(compiler, node->as.if_statement.condition);
+            size_t next_jump = emit_jump(compiler, OP_JUMP_IF_FALSE, node->line);
+            compile_scoped_block(compiler, node->as.if_statement.then_branch);
+            end_jumps[0] = emit_jump(compiler, OP_JUMP, node->line);
+
+            for (size_t i = 0; i < node->as.if_statement.else_if_count; i++) {
+                AstNodeElseIfClause* clause = &node->as.if_statement.else_if_clauses[i];
+                patch_jump(compiler, next_jump);
+                compile_expression(compiler, clause->condition);
+                next_jump = emit_jump(compiler, OP_JUMP_IF_FALSE, node->line);
+                compile_scoped_block(compiler, clause->body);
+                end_jumps[i + 1] = emit_jump(compiler, OP_JUMP, node->line);
             }
-            
-            int index = (int)raw_index;
-            GraveyardArray* array = array_val.as.array;
 
-            if (index >= array->count) {
-                runtime_error(gy, node->line, "Array index out of bounds (index %d is beyond array of size %zu)", index, array->count);
-                dec_ref(array_val);
-                dec_ref(index_val);
-                return create_null_value();
+            patch_jump(compiler, next_jump);
+            if (node->as.if_statement.else_branch != NULL) {
+                compile_scoped_block(compiler, node->as.if_statement.else_branch);
+            }
+            for (size_t i = 0; i < clause_count; i++) {
+                patch_jump(compiler, end_jumps[i]);
             }
+            free(end_jumps);
+            return;
+        }
+
+        case AST_WHILE_STATEMENT: {
+            LoopContext loop;
+            size_t loop_start = compiler->chunk->count;
+            compile_expression(compiler, node->as.while_statement.condition);
+            size_t exit_jump = emit_jump(compiler, OP_JUMP_IF_FALSE, node->line);
+            emit_op_u32(compiler, OP_PUSH_SCOPE, chunk_add_node(compiler->chunk, node->as.while_statement.body), node->line);
+            compile_loop_body(compiler, &loop, node->as.while_statement.body);
+            size_t continue_target = compiler->chunk->count;
+            emit_op(compiler, OP_POP_SCOPE, node->line);
+            emit_op_u32(compiler, OP_JUMP, (uint32_t)loop_start, node->line);
+            patch_jump(compiler, exit_jump);
+            compile_loop_end(compiler, &loop, continue_target, compiler->chunk->count);
+            return;
+        }
 
-            GraveyardValue result = array->values[index];
-            inc_ref(result);
+        case AST_FOR_STATEMENT: {
+            LoopContext loop;
+            size_t range_count = node->as.for_statement.range_count;
+            AstNode** range_exprs = node->as.for_statement.range_expressions;
 
-            dec_ref(array_val);
-            dec_ref(index_val);
+            if (range_count == 1) {
+                compile_expression(compiler, range_exprs[0]);
+                emit_op(compiler, OP_FOR_EACH_PREPARE, node->line);
+                size_t loop_start = compiler->chunk->count;
+                emit_op_u32(compiler, OP_FOR_EACH_NEXT, chunk_add_node(compiler->chunk, node), node->line);
+                size_t exit_jump = emit_jump_operand(compiler, node->line);
+                compile_loop_body(compiler, &loop, node->as.for_statement.body);
+                size_t continue_target = compiler->chunk->count;
+                emit_op(compiler, OP_POP_SCOPE, node->line);
+                emit_op_u32(compiler, OP_JUMP, (uint32_t)loop_start, node->line);
+                size_t break_target = compiler->chunk->count;
+                patch_jump(compiler, exit_jump);
+                emit_op(compiler, OP_POP, node->line);
+                emit_op(compiler, OP_POP, node->line);
+                compile_loop_end(compiler, &loop, continue_target, break_target);
+                return;
+            }
 
-            return result;
+            size_t fail_jumps[3];
+            for (size_t i = 0; i < range_count; i++) {
+                compile_expression(compiler, range_exprs[i]);
+                emit_op_u32(compiler, OP_FOR_RANGE_CHECK, (uint32_t)(i + 1), range_exprs[i]->line);
+                fail_jumps[i] = emit_jump_operand(compiler, range_exprs[i]->line);
+            }
+            if (range_count == 2) {
+                emit_constant(compiler, create_number_value(1.0), node->line);
+            }
+            size_t prepare_jump = emit_jump(compiler, OP_FOR_RANGE_PREPARE, node->line);
+            size_t loop_start = compiler->chunk->count;
+            emit_op_u32(compiler, OP_FOR_RANGE_NEXT, chunk_add_node(compiler->chunk, node), node->line);
+            size_t exit_jump = emit_jump_operand(compiler, node->line);
+            compile_loop_body(compiler, &loop, node->as.for_statement.body);
+            size_t continue_target = compiler->chunk->count;
+            emit_op(compiler, OP_POP_SCOPE, node->line);
+            emit_op_u32(compiler, OP_JUMP, (uint32_t)loop_start, node->line);
+            size_t break_target = compiler->chunk->count;
+            patch_jump(compiler, exit_jump);
+            emit_op(compiler, OP_POP, node->line);
+            emit_op(compiler, OP_POP, node->line);
+            emit_op(compiler, OP_POP, node->line);
+            for (size_t i = 0; i < range_count; i++) {
+                patch_jump(compiler, fail_jumps[i]);
+            }
+            patch_jump(compiler, prepare_jump);
+            compile_loop_end(compiler, &loop, continue_target, break_target);
+            return;
         }
 
-        case AST_HASHTABLE_LITERAL: {
-            GraveyardValue ht_val = create_hashtable_value();
-            GraveyardHashtable* ht = ht_val.as.hashtable;
+        case AST_BREAK_STATEMENT: {
+            LoopContext* loop = compiler->loop;
+            if (loop == NULL) {
+                compiler->failed = true;
+                return;
+            }
+            emit_scope_pops(compiler, compiler->scope_depth - loop->outer_depth, node->line);
+            emit_op(compiler, OP_JUMP, node->line);
+            loop_add_patch(&loop->break_patches, &loop->break_count, &loop->break_capacity, emit_jump_operand(compiler, node->line));
+            return;
+        }
 
-            for (size_t i = 0; i < node->as.hashtable_literal.count; i++) {
-                AstNodeKeyValuePair pair = node->as.hashtable_literal.pairs[i];
-                GraveyardValue key = execute_node(gy, pair.key);
-
-                bool is_valid_key = (key.type == VAL_STRING || key.type == VAL_NUMBER ||
-                                    key.type == VAL_BOOL || key.type == VAL_NULL);
-                bool is_integer = (key.type != VAL_NUMBER || fmod(key.as.number, 1.0) == 0);
-
-                if (!is_valid_key) {
-                    runtime_error(gy, node->line, "Invalid type used as a hashtable key");
-                    dec_ref(ht_val);
-                    dec_ref(key);
-                    return create_null_value();
-                }
-                if (!is_integer) {
-                    runtime_error(gy, node->line, "Cannot use float as hashtable key");
-                    dec_ref(ht_val);
-                    dec_ref(key);
-                    return create_null_value();
-                }
+        case AST_CONTINUE_STATEMENT: {
+            LoopContext* loop = compiler->loop;
+            if (loop == NULL) {
+                compiler->failed = true;
+                return;
+            }
+            emit_scope_pops(compiler, compiler->scope_depth - loop->outer_depth - 1, node->line);
+            emit_op(compiler, OP_JUMP, node->line);
+            loop_add_patch(&loop->continue_patches, &loop->continue_count, &loop->continue_capacity, emit_jump_operand(compiler, node->line));
+            return;
+        }
 
-                GraveyardValue value = execute_node(gy, pair.value);
-                hashtable_set(ht, key, value);
-                
-                dec_ref(key);
-                dec_ref(value);
+        case AST_RETURN_STATEMENT:
+            if (!compiler->in_function) {
+                compiler->failed = true;
+                return;
             }
-            return ht_val;
+            if (node->as.return_statement.value) {
+                compile_expression(compiler, node->as.return_statement.value);
+            } else {
+                emit_op(compiler, OP_NULL, node->line);
+            }
+            emit_op(compiler, OP_RETURN, node->line);
+            return;
+
+        default:
+            compile_fallback_statement(compiler, node);
+            return;
+    }
+}
+
+static void compiler_init(Compiler* compiler, Chunk* chunk, bool in_function) {
+    compiler->chunk = chunk;
+    compiler->loop = NULL;
+    compiler->scope_depth = 0;
+    compiler->in_function = in_function;
+    compiler->failed = false;
+}
+
+static Chunk* compile_program(AstNode* program) {
+    Chunk* chunk = chunk_new();
+    Compiler compiler;
+    compiler_init(&compiler, chunk, false);
+
+    for (size_t i = 0; i < program->as.program.count && !compiler.failed; i++) {
+        AstNode* statement = program->as.program.statements[i];
+        compile_statement(&compiler, statement);
+        emit_op(&compiler, OP_CHECK_ERROR, statement->line);
+    }
+    emit_op(&compiler, OP_HALT, 0);
+
+    chunk->is_compiled = !compiler.failed;
+    return chunk;
+}
+
+static Chunk* function_chunk(AstNode* body) {
+    if (body->as.block.chunk != NULL) {
+        return body->as.block.chunk;
+    }
+
+    Chunk* chunk = chunk_new();
+    Compiler compiler;
+    compiler_init(&compiler, chunk, true);
+
+    compile_block_statements(&compiler, body);
+    emit_op(&compiler, OP_NULL, body->line);
+    emit_op(&compiler, OP_RETURN, body->line);
+
+    chunk->is_compiled = !compiler.failed;
+    body->as.block.chunk = chunk;
+    return chunk;
+}
+
+static void vm_push(Vm* vm, GraveyardValue value) {
+    if (vm->stack_count >= vm->stack_capacity) {
+        size_t new_capacity = vm->stack_capacity < 256 ? 256 : vm->stack_capacity * 2;
+        GraveyardValue* temp = realloc(vm->stack, new_capacity * sizeof(GraveyardValue));
+        if (!temp) {
+            perror("vm_push: realloc failed");
+            exit(1);
         }
+        vm->stack = temp;
+        vm->stack_capacity = new_capacity;
+    }
+    vm->stack[vm->stack_count++] = value;
+}
 
-        case AST_IDENTIFIER: {
-            GraveyardValue value;
-            if (environment_get(gy->environment, node->as.identifier.name.lexeme, &value)) {
-                inc_ref(value);
-                return value;
-            }
+static GraveyardValue vm_pop(Vm* vm) {
+    return vm->stack[--vm->stack_count];
+}
 
-            runtime_error(gy, node->line, "Undefined variable '%s'", node->as.identifier.name.lexeme);
-            return create_null_value();
+static CallFrame* vm_push_frame(Vm* vm) {
+    if (vm->frame_count >= vm->frame_capacity) {
+        size_t new_capacity = vm->frame_capacity < 64 ? 64 : vm->frame_capacity * 2;
+        CallFrame* temp = realloc(vm->frames, new_capacity * sizeof(CallFrame));
+        if (!temp) {
+            perror("vm_push_frame: realloc failed");
+            exit(1);
         }
+        vm->frames = temp;
+        vm->frame_capacity = new_capacity;
+    }
+    return &vm->frames[vm->frame_count++];
+}
 
-        case AST_EXPRESSION_STATEMENT: {
-            return execute_node(gy, node->as.expression_statement.expression);
-        }
-        
-        case AST_ASSIGNMENT: {
-            AstNode* target_node = node->as.assignment.left;
-            GraveyardValue value_to_assign = execute_node(gy, node->as.assignment.value);
+static void vm_pop_scope(Graveyard* gy) {
+    Environment* env = gy->environment;
+    gy->environment = env->enclosing;
+    environment_release(gy, env);
+}
 
-            if (target_node->type == AST_IDENTIFIER) {
-                const char* name = target_node->as.identifier.name.lexeme;
-                
-                if (!environment_assign(gy->environment, name, value_to_assign)) {
-                    environment_define(gy->environment, name, value_to_assign);
-                }
-                return value_to_assign;
-
-            } else if (target_node->type == AST_SUBSCRIPT) {
-                AstNode* array_node = target_node->as.subscript.array;
-                AstNode* index_node = target_node->as.subscript.index;
-
-                GraveyardValue array_val = execute_node(gy, array_node);
-                if (array_val.type != VAL_ARRAY) {
-                    runtime_error(gy, target_node->line, "Cannot assign to subscript '[]' of a non-array type");
-                    dec_ref(value_to_assign);
-                    dec_ref(array_val);
-                    return create_null_value();
-                }
+static GraveyardFunction* callable_function(GraveyardValue callee) {
+    if (VALUE_TYPE(callee) == VAL_FUNCTION) return AS_FUNCTION(callee);
+    if (VALUE_TYPE(callee) == VAL_BOUND_METHOD) return AS_FUNCTION(AS_BOUND_METHOD(callee)->function);
+    return NULL;
+}
 
-                GraveyardValue index_val = execute_node(gy, index_node);
-                if (index_val.type != VAL_NUMBER) {
-                    runtime_error(gy, index_node->line, "Array index must be a number");
-                    dec_ref(value_to_assign);
-                    dec_ref(array_val);
-                    dec_ref(index_val);
-                    return create_null_value();
-                }
+static uint32_t read_u32(uint8_t* ip) {
+    uint32_t value;
+    memcpy(&value, ip, sizeof(value));
+    return value;
+}
 
-                double raw_index = index_val.as.number;
-                if (raw_index < 0 || fmod(raw_index, 1.0) != 0) {
-                    runtime_error(gy, index_node->line, "Array index must be a non-negative integer");
-                    dec_ref(value_to_assign);
-                    dec_ref(array_val);
-                    dec_ref(index_val);
-                    return create_null_value();
-                }
-                
-                int index = (int)raw_index;
-                GraveyardArray* array = array_val.as.array;
-
-                if (index >= array->count) {
-                    runtime_error(gy, target_node->line, "Array index out of bounds...");
-                    dec_ref(array_val);
-                    dec_ref(index_val);
-                    dec_ref(value_to_assign);
-                    return create_null_value();
-                }
+#if defined(__GNUC__) && !defined(GRAVEYARD_NO_COMPUTED_GOTO)
+#define VM_COMPUTED_GOTO
+#endif
 
-                dec_ref(array->values[index]);
+static void vm_run(Graveyard* gy, Chunk* program_chunk) {
+    Vm vm = { NULL, 0, 0, NULL, 0, 0 };
+
+    CallFrame* frame = vm_push_frame(&vm);
+    frame->chunk = program_chunk;
+    frame->ip = program_chunk->code;
+    frame->stack_base = 0;
+    frame->saved_environment = gy->environment;
+    frame->call_environment = NULL;
+    frame->callee = create_null_value();
+    frame->receiver = create_null_value();
+
+    Chunk* chunk = frame->chunk;
+    uint8_t* ip = frame->ip;
+    GraveyardValue result;
+
+#define READ_OPERAND() (ip += 4, read_u32(ip - 4))
+#define CURRENT_LINE() (chunk->lines[(ip - chunk->code) - 1])
+
+#ifdef VM_COMPUTED_GOTO
+    static void* dispatch_table[] = {
+        [OP_CONSTANT]                = &&target_OP_CONSTANT,
+        [OP_NULL]                    = &&target_OP_NULL,
+        [OP_POP]                     = &&target_OP_POP,
+        [OP_GET_VARIABLE]            = &&target_OP_GET_VARIABLE,
+        [OP_SET_VARIABLE]            = &&target_OP_SET_VARIABLE,
+        [OP_DEFINE_VARIABLE]         = &&target_OP_DEFINE_VARIABLE,
+        [OP_DEFINE_FUNCTION]         = &&target_OP_DEFINE_FUNCTION,
+        [OP_BINARY]                  = &&target_OP_BINARY,
+        [OP_UNARY]                   = &&target_OP_UNARY,
+        [OP_JUMP]                    = &&target_OP_JUMP,
+        [OP_JUMP_IF_FALSE]           = &&target_OP_JUMP_IF_FALSE,
+        [OP_JUMP_IF_FALSY_OR_POP]    = &&target_OP_JUMP_IF_FALSY_OR_POP,
+        [OP_JUMP_IF_TRUTHY_OR_POP]   = &&target_OP_JUMP_IF_TRUTHY_OR_POP,
+        [OP_JUMP_IF_NOT_NULL_OR_POP] = &&target_OP_JUMP_IF_NOT_NULL_OR_POP,
+        [OP_PUSH_SCOPE]              = &&target_OP_PUSH_SCOPE,
+        [OP_POP_SCOPE]               = &&target_OP_POP_SCOPE,
+        [OP_ARRAY]                   = &&target_OP_ARRAY,
+        [OP_CHECK_SUBSCRIPT]         = &&target_OP_CHECK_SUBSCRIPT,
+        [OP_SUBSCRIPT]               = &&target_OP_SUBSCRIPT,
+        [OP_GET_MEMBER]              = &&target_OP_GET_MEMBER,
+        [OP_GET_METHOD]              = &&target_OP_GET_METHOD,
+        [OP_CHECK_CALL]              = &&target_OP_CHECK_CALL,
+        [OP_CHECK_INVOKE]            = &&target_OP_CHECK_INVOKE,
+        [OP_CALL]                    = &&target_OP_CALL,
+        [OP_INVOKE]                  = &&target_OP_INVOKE,
+        [OP_TAIL_CALL]               = &&target_OP_TAIL_CALL,
+        [OP_TAIL_INVOKE]             = &&target_OP_TAIL_INVOKE,
+        [OP_RETURN]                  = &&target_OP_RETURN,
+        [OP_PRINT]                   = &&target_OP_PRINT,
+        [OP_PRINT_END]               = &&target_OP_PRINT_END,
+        [OP_FOR_EACH_PREPARE]        = &&target_OP_FOR_EACH_PREPARE,
+        [OP_FOR_EACH_NEXT]           = &&target_OP_FOR_EACH_NEXT,
+        [OP_FOR_RANGE_CHECK]         = &&target_OP_FOR_RANGE_CHECK,
+        [OP_FOR_RANGE_PREPARE]       = &&target_OP_FOR_RANGE_PREPARE,
+        [OP_FOR_RANGE_NEXT]          = &&target_OP_FOR_RANGE_NEXT,
+        [OP_EVAL_NODE]               = &&target_OP_EVAL_NODE,
+        [OP_EVAL_STATEMENT]          = &&target_OP_EVAL_STATEMENT,
+        [OP_CHECK_BREAK]             = &&target_OP_CHECK_BREAK,
+        [OP_CHECK_CONTINUE]          = &&target_OP_CHECK_CONTINUE,
+        [OP_CHECK_RETURN]            = &&target_OP_CHECK_RETURN,
+        [OP_CHECK_ERROR]             = &&target_OP_CHECK_ERROR,
+        [OP_HALT]                    = &&target_OP_HALT,
+    };
+#define VM_CASE(op) case op: target_##op
+#define DISPATCH() goto *dispatch_table[*ip++]
+#else
+#define VM_CASE(op) case op
+#define DISPATCH() break
+#endif
 
-                inc_ref(value_to_assign);
-                array->values[index] = value_to_assign;
+    for (;;) {
+#ifdef VM_COMPUTED_GOTO
+        DISPATCH();
+#endif
+        switch ((OpCode)*ip++) {
+            VM_CASE(OP_CONSTANT): {
+                GraveyardValue constant = chunk->constants[READ_OPERAND()];
+                inc_ref(constant);
+                vm_push(&vm, constant);
+                DISPATCH();
+            }
+
+            VM_CASE(OP_NULL):
+                vm_push(&vm, create_null_value());
+                DISPATCH();
+
+            VM_CASE(OP_POP):
+                dec_ref(gy, vm_pop(&vm));
+                gc_safepoint(gy);
+                DISPATCH();
+
+            VM_CASE(OP_GET_VARIABLE): {
+                AstNode* node = chunk->nodes[READ_OPERAND()];
+                GraveyardValue value;
+                if (resolved_get(gy, &node->as.identifier.resolution, node->as.identifier.name.symbol, &value)) {
+                    inc_ref(value);
+                    vm_push(&vm, value);
+                } else {
+                    runtime_error(gy, node->line, "Undefined variable '%s'", node->as.identifier.name.lexeme);
+                    vm_push(&vm, create_null_value());
+                }
+                DISPATCH();
+            }
 
-                dec_ref(array_val);
-                dec_ref(index_val);
+            VM_CASE(OP_SET_VARIABLE): {
+                AstNode* node = chunk->nodes[READ_OPERAND()];
+                Symbol* name = node->as.identifier.name.symbol;
+                GraveyardValue value = vm.stack[vm.stack_count - 1];
+                resolved_assign(gy, &node->as.identifier.resolution, name, value);
+                DISPATCH();
+            }
 
-                return value_to_assign;
-            } else if (target_node->type == AST_BINARY_OP && target_node->as.binary_op.operator.type == REFERENCE) {
-                AstNode* ht_node = target_node->as.binary_op.left;
-                AstNode* key_node = target_node->as.binary_op.right;
+            VM_CASE(OP_DEFINE_VARIABLE): {
+                AstNode* node = chunk->nodes[READ_OPERAND()];
+                GraveyardValue value = vm_pop(&vm);
+                resolved_define(gy, &node->as.var_declaration.resolution, node->as.var_declaration.name.symbol, value);
+                dec_ref(gy, value);
+                DISPATCH();
+            }
 
-                GraveyardValue ht_val = execute_node(gy, ht_node);
-                if (ht_val.type != VAL_HASHTABLE) {
-                    runtime_error(gy, ht_node->line, "Cannot assign to key of a non-hashtable type");
-                    dec_ref(value_to_assign);
-                    dec_ref(ht_val);
-                    return create_null_value();
-                }
+            VM_CASE(OP_DEFINE_FUNCTION): {
+                AstNode* node = chunk->nodes[READ_OPERAND()];
+                GraveyardValue function = create_function_value(gy, node);
+                environment_define(gy, gy->environment, node->as.function_declaration.name.symbol, function);
+                dec_ref(gy, function);
+                DISPATCH();
+            }
 
-                GraveyardValue key_val = execute_node(gy, key_node);
+            VM_CASE(OP_BINARY): {
+                AstNode* node = chunk->nodes[READ_OPERAND()];
+                GraveyardValue right = vm_pop(&vm);
+                GraveyardValue left = vm_pop(&vm);
+                result = execute_binary_node(gy, node, left, right);
+                dec_ref(gy, left);
+                dec_ref(gy, right);
+                vm_push(&vm, result);
+                DISPATCH();
+            }
 
-                if (key_val.type != VAL_STRING && key_val.type != VAL_NUMBER &&
-                    key_val.type != VAL_BOOL && key_val.type != VAL_NULL) {
-                    runtime_error(gy, key_node->line, "Invalid type used as a hashtable key");
-                    dec_ref(value_to_assign);
-                    dec_ref(ht_val);
-                    dec_ref(key_val);
-                    return create_null_value();
-                }
-                if (key_val.type == VAL_NUMBER && fmod(key_val.as.number, 1.0) != 0) {
-                    runtime_error(gy, key_node->line, "Float cannot be used as a hashtable key");
-                    dec_ref(value_to_assign);
-                    dec_ref(ht_val);
-                    dec_ref(key_val);
-                    return create_null_value();
-                }
+            VM_CASE(OP_UNARY): {
+                GraveyardTokenType op_type = (GraveyardTokenType)READ_OPERAND();
+                GraveyardValue right = vm_pop(&vm);
+                result = evaluate_unary_op(gy, op_type, right, CURRENT_LINE());
+                dec_ref(gy, right);
+                vm_push(&vm, result);
+                DISPATCH();
+            }
 
-                hashtable_set(ht_val.as.hashtable, key_val, value_to_assign);
+            VM_CASE(OP_JUMP):
+                ip = chunk->code + read_u32(ip);
+                DISPATCH();
 
-                dec_ref(ht_val);
-                dec_ref(key_val);
+            VM_CASE(OP_JUMP_IF_FALSE): {
+                uint32_t target = READ_OPERAND();
+                GraveyardValue condition = vm_pop(&vm);
+                bool is_falsy = is_value_falsy(condition);
+                dec_ref(gy, condition);
+                if (is_falsy) ip = chunk->code + target;
+                DISPATCH();
+            }
 
-                return value_to_assign;
-            } else if (target_node->type == AST_MEMBER_ACCESS) {
-                GraveyardValue object = execute_node(gy, target_node->as.member_access.object);
-                if (object.type != VAL_INSTANCE) {
-                    runtime_error(gy, target_node->line, "Can only assign to members of an instance");
-                    dec_ref(value_to_assign);
-                    dec_ref(object);
-                    return create_null_value();
-                }
-                
-                monolith_set(&object.as.instance->fields, target_node->as.member_access.member.lexeme, value_to_assign);
-                dec_ref(object);
-                return value_to_assign;
-            } else if (target_node->type == AST_GLOBAL_ACCESS) {
-                const char* member_name = target_node->as.global_access.member_name.lexeme;
-                Environment* global_env = get_global_environment(gy);
-                
-                environment_define(global_env, member_name, value_to_assign);
-                return value_to_assign;
-            } else if (target_node->type == AST_STATIC_ACCESS) {
-                char* name_str = target_node->as.static_access.type_name.lexeme;
-                name_str[strlen(name_str) - 1] = '\0';
-                const char* type_name = name_str + 1;
-                const char* member_name = target_node->as.static_access.member_name.lexeme;
-
-                GraveyardValue type_val;
-                if (!environment_get(gy->environment, type_name, &type_val) || type_val.type != VAL_TYPE) {
-                    runtime_error(gy, target_node->line, "Type <%s> is not defined", type_name);
-                    dec_ref(value_to_assign);
-                    return create_null_value();
+            VM_CASE(OP_JUMP_IF_FALSY_OR_POP): {
+                uint32_t target = READ_OPERAND();
+                if (is_value_falsy(vm.stack[vm.stack_count - 1])) {
+                    ip = chunk->code + target;
+                } else {
+                    dec_ref(gy, vm_pop(&vm));
                 }
+                DISPATCH();
+            }
 
-                monolith_set(&type_val.as.type->fields, member_name, value_to_assign);
-                return value_to_assign;
-            } else if (target_node->type == AST_NAMESPACE_ACCESS) {
-                const char* ns_name = target_node->as.namespace_access.namespace_name.lexeme;
-                const char* member_name = target_node->as.namespace_access.member_name.lexeme;
-                GraveyardValue ns_val;
-
-                if (!monolith_get(&gy->namespaces, ns_name, &ns_val)) {
-                    runtime_error(gy, target_node->line, "Cannot assign to variable in undefined namespace '%s'", ns_name);
-                    dec_ref(value_to_assign);
-                    return create_null_value();
+            VM_CASE(OP_JUMP_IF_TRUTHY_OR_POP): {
+                uint32_t target = READ_OPERAND();
+                if (!is_value_falsy(vm.stack[vm.stack_count - 1])) {
+                    ip = chunk->code + target;
+                } else {
+                    dec_ref(gy, vm_pop(&vm));
                 }
+                DISPATCH();
+            }
 
-                Environment* ns_env = ns_val.as.environment;
-
-                if (!environment_assign(ns_env, member_name, value_to_assign)) {
-                    runtime_error(gy, target_node->line, "Variable '%s' is not defined in namespace '%s'", member_name, ns_name);
-                    dec_ref(value_to_assign);
-                    return create_null_value();
+            VM_CASE(OP_JUMP_IF_NOT_NULL_OR_POP): {
+                uint32_t target = READ_OPERAND();
+                if (VALUE_TYPE(vm.stack[vm.stack_count - 1]) != VAL_NULL) {
+                    ip = chunk->code + target;
+                } else {
+                    vm_pop(&vm);
                 }
-                
-                return value_to_assign;
+                DISPATCH();
             }
 
-            runtime_error(gy, node->line, "Invalid assignment target.");
-            dec_ref(value_to_assign);
-            return create_null_value();
-        }
-        
-        case AST_LOGICAL_OP: {
-            GraveyardValue left = execute_node(gy, node->as.logical_op.left);
-            GraveyardTokenType op_type = node->as.logical_op.operator.type;
+            VM_CASE(OP_PUSH_SCOPE): {
+                AstNode* block = chunk->nodes[READ_OPERAND()];
+                gy->environment = environment_acquire(gy, gy->environment, block->as.block.layout);
+                DISPATCH();
+            }
 
-            if (op_type == AND) {
-                if (is_value_falsy(left)) {
-                    return left;
+            VM_CASE(OP_POP_SCOPE):
+                vm_pop_scope(gy);
+                DISPATCH();
+
+            VM_CASE(OP_ARRAY): {
+                uint32_t count = READ_OPERAND();
+                GraveyardValue array_val = create_array_value(gy);
+                GraveyardValue* elements = &vm.stack[vm.stack_count - count];
+                for (uint32_t i = 0; i < count; i++) {
+                    array_append(AS_ARRAY(array_val), elements[i]);
+                    dec_ref(gy, elements[i]);
                 }
-            } else if (op_type == OR) {
-                if (!is_value_falsy(left)) {
-                    return left;
+                vm.stack_count -= count;
+                vm_push(&vm, array_val);
+                DISPATCH();
+            }
+
+            VM_CASE(OP_CHECK_SUBSCRIPT): {
+                uint32_t target = READ_OPERAND();
+                if (VALUE_TYPE(vm.stack[vm.stack_count - 1]) != VAL_ARRAY) {
+                    runtime_error(gy, CURRENT_LINE(), "Only arrays are subscriptable");
+                    dec_ref(gy, vm_pop(&vm));
+                    vm_push(&vm, create_null_value());
+                    ip = chunk->code + target;
                 }
+                DISPATCH();
             }
 
-            dec_ref(left);
-            return execute_node(gy, node->as.logical_op.right);
-        }
+            VM_CASE(OP_SUBSCRIPT): {
+                GraveyardValue index_val = vm_pop(&vm);
+                GraveyardValue array_val = vm_pop(&vm);
+                result = subscript_value(gy, array_val, index_val, CURRENT_LINE());
+                dec_ref(gy, array_val);
+                dec_ref(gy, index_val);
+                vm_push(&vm, result);
+                DISPATCH();
+            }
 
-        case AST_UNARY_OP: {
-            GraveyardValue right = execute_node(gy, node->as.unary_op.right);
-            GraveyardValue result = create_null_value();
+            VM_CASE(OP_GET_MEMBER): {
+                AstNode* node = chunk->nodes[READ_OPERAND()];
+                GraveyardValue object = vm_pop(&vm);
+                result = member_access_value(gy, object, node);
+                dec_ref(gy, object);
+                vm_push(&vm, result);
+                DISPATCH();
+            }
 
-            switch (node->as.unary_op.operator.type) {
-                case MINUS:
-                    if (right.type != VAL_NUMBER) {
-                        runtime_error(gy, node->line, "Operand for negation must be a number");
-                    } else {
-                        result = create_number_value(-right.as.number);
-                    }
+            VM_CASE(OP_GET_METHOD): {
+                AstNode* node = chunk->nodes[READ_OPERAND()];
+                GraveyardValue object = vm.stack[vm.stack_count - 1];
+                if (instance_method(object, node, &result)) {
+                    inc_ref(result);
+                } else {
+                    result = member_access_value(gy, object, node);
+                    dec_ref(gy, object);
+                    vm.stack[vm.stack_count - 1] = create_null_value();
+                }
+                vm_push(&vm, result);
+                DISPATCH();
+            }
+
+            VM_CASE(OP_CHECK_CALL):
+            VM_CASE(OP_CHECK_INVOKE): {
+                bool is_invoke = ip[-1] == OP_CHECK_INVOKE;
+                uint32_t arg_count = READ_OPERAND();
+                uint32_t target = READ_OPERAND();
+                GraveyardFunction* function = callable_function(vm.stack[vm.stack_count - 1]);
+                if (function == NULL) {
+                    runtime_error(gy, CURRENT_LINE(), "Can only call functions and methods");
+                } else if ((int)arg_count != function->arity) {
+                    runtime_error(gy, CURRENT_LINE(), "Expected %d arguments but got %d", function->arity, (int)arg_count);
+                } else {
                     break;
+                }
+                dec_ref(gy, vm_pop(&vm));
+                if (is_invoke) {
+                    dec_ref(gy, vm_pop(&vm));
+                }
+                vm_push(&vm, create_null_value());
+                ip = chunk->code + target;
+                DISPATCH();
+            }
+
+            VM_CASE(OP_CALL):
+            VM_CASE(OP_INVOKE):
+            VM_CASE(OP_TAIL_CALL):
+            VM_CASE(OP_TAIL_INVOKE): {
+                OpCode op = (OpCode)ip[-1];
+                bool is_invoke = op == OP_INVOKE || op == OP_TAIL_INVOKE;
+                uint32_t arg_count = READ_OPERAND();
+                GraveyardValue callee = vm.stack[vm.stack_count - arg_count - 1];
+                GraveyardValue receiver = is_invoke ? vm.stack[vm.stack_count - arg_count - 2] : create_null_value();
+                GraveyardFunction* function = callable_function(callee);
+                GraveyardValue* args = &vm.stack[vm.stack_count - arg_count];
+
+                Environment* call_environment = environment_acquire(gy, function->closure, function->body->as.block.layout);
+                if (VALUE_TYPE(callee) == VAL_BOUND_METHOD) {
+                    environment_define(gy, call_environment, gy->this_symbol, AS_BOUND_METHOD(callee)->receiver);
+                } else if (VALUE_TYPE(receiver) != VAL_NULL) {
+                    environment_define(gy, call_environment, gy->this_symbol, receiver);
+                }
+                for (uint32_t i = 0; i < arg_count; i++) {
+                    environment_define_parameter(gy, call_environment, function, i, args[i]);
+                    dec_ref(gy, args[i]);
+                }
+                vm.stack_count -= arg_count + (is_invoke ? 2 : 1);
 
-                case NOT:
-                    result = create_bool_value(is_value_falsy(right));
-                    break;
+                if (gy->jit_enabled && function->memo == NULL && jit_invoke(gy, function, call_environment)) {
+                    environment_release(gy, call_environment);
 
-                case TYPEOF: {
-                    switch (right.type) {
-                        case VAL_BOOL:         result = create_string_value("boolean"); break;
-                        case VAL_NULL:         result = create_string_value("null"); break;
-                        case VAL_STRING:       result = create_string_value("string"); break;
-                        case VAL_ARRAY:        result = create_string_value("array"); break;
-                        case VAL_HASHTABLE:    result = create_string_value("hashtable"); break;
-                        case VAL_FUNCTION:
-                        case VAL_BOUND_METHOD: result = create_string_value("function"); break;
-                        case VAL_TYPE:         result = create_string_value("type"); break;
-                        case VAL_INSTANCE:     result = create_string_value(right.as.instance->type->name.as.string->chars); break;
-                        case VAL_NUMBER:
-                            if (fmod(right.as.number, 1.0) == 0) {
-                                result = create_string_value("integer");
-                            } else {
-                                result = create_string_value("float");
-                            }
-                            break;
-                        default:
-                            result = create_string_value("unknown"); break;
+                    result = create_null_value();
+                    if (gy->is_returning) {
+                        result = gy->return_value;
+                        gy->is_returning = false;
+                        gy->return_value = create_null_value();
                     }
-                    break;
+                    dec_ref(gy, callee);
+                    dec_ref(gy, receiver);
+                    vm_push(&vm, result);
+                    DISPATCH();
                 }
 
-                case CASTBOOLEAN: {
-                    result = create_bool_value(!is_value_falsy(right));
+                Chunk* body_chunk = function_chunk(function->body);
+                if (!body_chunk->is_compiled || function->memo != NULL) {
+                    PendingCall call = { function, call_environment, callee, receiver };
+                    vm_push(&vm, complete_call(gy, &call));
                     break;
                 }
 
-                case CASTINTEGER: {
-                    switch (right.type) {
-                        case VAL_NUMBER: result = create_number_value((int)right.as.number); break;
-                        case VAL_BOOL:   result = create_number_value(right.as.boolean ? 1 : 0); break;
-                        case VAL_NULL:   result = create_number_value(0); break;
-                        case VAL_STRING: {
-                            char* end;
-                            long val = strtol(right.as.string->chars, &end, 10);
-                            if (*end != '\0') {
-                                runtime_error(gy, node->line, "Cannot cast non-numeric string to integer");
-                            } else {
-                                result = create_number_value(val);
-                            }
-                            break;
-                        }
-                        default:
-                            runtime_error(gy, node->line, "Cannot cast this type to integer");
-                            break;
-                    }
-                    break;
+                bool is_tail = (op == OP_TAIL_CALL || op == OP_TAIL_INVOKE) && !closure_captures(function, frame->call_environment);
+                if (!is_tail && vm.frame_count >= gy->vm_frame_limit) {
+                    runtime_error(gy, CURRENT_LINE(), "Maximum recursion depth exceeded");
+                    environment_release(gy, call_environment);
+                    dec_ref(gy, callee);
+                    dec_ref(gy, receiver);
+                    vm_push(&vm, create_null_value());
+                    DISPATCH();
                 }
-
-                case CASTFLOAT: {
-                    switch (right.type) {
-                        case VAL_NUMBER: result = create_number_value((double)right.as.number); break;
-                        case VAL_BOOL:   result = create_number_value(right.as.boolean ? 1.0 : 0.0); break;
-                        case VAL_NULL:   result = create_number_value(0.0); break;
-                        case VAL_STRING: {
-                            char* end;
-                            double val = strtod(right.as.string->chars, &end);
-                            if (*end != '\0') {
-                                runtime_error(gy, node->line, "Cannot cast non-numeric string to float");
-                            } else {
-                                result = create_number_value(val);
-                            }
-                            break;
-                        }
-                        default:
-                            runtime_error(gy, node->line, "Cannot cast this type to float");
-                            break;
+                if (is_tail) {
+                    while (vm.stack_count > frame->stack_base) {
+                        dec_ref(gy, vm_pop(&vm));
                     }
-                    break;
+                    while (gy->environment != frame->call_environment) {
+                        vm_pop_scope(gy);
+                    }
+                    environment_release(gy, frame->call_environment);
+                    dec_ref(gy, frame->callee);
+                    dec_ref(gy, frame->receiver);
+                } else {
+                    frame->ip = ip;
+                    frame = vm_push_frame(&vm);
+                    frame->stack_base = vm.stack_count;
+                    frame->saved_environment = gy->environment;
                 }
-                
-                case CASTSTRING: {
-                    char buffer[1024];
-                    value_to_string(right, buffer, sizeof(buffer));
-                    result = create_string_value(buffer);
-                    break;
+                frame->chunk = body_chunk;
+                frame->ip = body_chunk->code;
+                frame->call_environment = call_environment;
+                frame->callee = callee;
+                frame->receiver = receiver;
+
+                gy->environment = call_environment;
+                chunk = body_chunk;
+                ip = frame->ip;
+                DISPATCH();
+            }
+
+            VM_CASE(OP_CHECK_RETURN):
+                if (!gy->is_returning) break;
+                if (gy->has_tail_call) {
+                    PendingCall call = gy->tail_call;
+                    gy->has_tail_call = false;
+                    gy->is_returning = false;
+                    vm_push(&vm, complete_call(gy, &call));
+                } else {
+                    vm_push(&vm, gy->return_value);
+                    gy->is_returning = false;
+                    gy->return_value = create_null_value();
                 }
+                goto return_from_frame;
 
-                case CASTARRAY: {
-                    switch (right.type) {
-                        case VAL_ARRAY:       inc_ref(right); result = right; break;
-                        case VAL_NULL:        result = create_array_value(); break;
-                        case VAL_HASHTABLE: {
-                            GraveyardValue arr_val = create_array_value();
-                            GraveyardHashtable* ht = right.as.hashtable;
-                            for (int i = 0; i < ht->capacity; i++) {
-                                if (ht->entries[i].is_in_use) {
-                                    array_append(arr_val.as.array, ht->entries[i].value);
-                                }
-                            }
-                            result = arr_val;
-                            break;
-                        }
-                        case VAL_STRING: {
-                            GraveyardValue arr_val = create_array_value();
-                            GraveyardString* str = right.as.string;
-                            for (size_t i = 0; i < str->length; i++) {
-                                char char_buf[2] = { str->chars[i], '\0' };
-                                array_append(arr_val.as.array, create_string_value(char_buf));
-                            }
-                            result = arr_val;
-                            break;
-                        }
-                        default: {
-                            GraveyardValue arr_val = create_array_value();
-                            array_append(arr_val.as.array, right);
-                            result = arr_val;
-                            break;
-                        }
-                    }
-                    break;
+            VM_CASE(OP_RETURN):
+            return_from_frame: {
+                result = vm_pop(&vm);
+                while (gy->environment != frame->call_environment) {
+                    vm_pop_scope(gy);
                 }
+                environment_release(gy, frame->call_environment);
+                gy->environment = frame->saved_environment;
 
-                case CASTHASHTABLE: {
-                    switch (right.type) {
-                        case VAL_HASHTABLE:
-                            inc_ref(right);
-                            result = right;
-                            break;
-                        case VAL_NULL:
-                            result = create_hashtable_value();
-                            break;
-                        case VAL_ARRAY: {
-                            GraveyardValue ht_val = create_hashtable_value();
-                            GraveyardArray* arr = right.as.array;
-                            bool cast_error = false;
-
-                            for (size_t i = 0; i < arr->count; i++) {
-                                GraveyardValue key = arr->values[i];
-                                
-                                bool is_valid_key = (key.type == VAL_BOOL || key.type == VAL_NULL || key.type == VAL_STRING ||
-                                                    (key.type == VAL_NUMBER && fmod(key.as.number, 1.0) == 0));
-
-                                if (!is_valid_key) {
-                                    runtime_error(gy, node->line, "Array contains an invalid type for a hashtable key");
-                                    cast_error = true;
-                                    break;
-                                }
-
-                                if (hashtable_find_entry(ht_val.as.hashtable->entries, ht_val.as.hashtable->capacity, key)->is_in_use) {
-                                    runtime_error(gy, node->line, "Duplicate key found when casting array to hashtable");
-                                    cast_error = true;
-                                    break;
-                                }
-                                hashtable_set(ht_val.as.hashtable, key, create_null_value());
-                            }
-
-                            if (cast_error) {
-                                dec_ref(ht_val);
-                            } else {
-                                result = ht_val;
-                            }
-                            break;
-                        }
-                        default: {
-                            GraveyardValue key = right;
-                            bool is_valid_key = (key.type == VAL_BOOL || key.type == VAL_NULL || key.type == VAL_STRING ||
-                                                (key.type == VAL_NUMBER && fmod(key.as.number, 1.0) == 0));
-
-                            if (!is_valid_key) {
-                                runtime_error(gy, node->line, "Invalid type used as a hashtable key");
-                            } else {
-                                GraveyardValue ht_val = create_hashtable_value();
-                                hashtable_set(ht_val.as.hashtable, key, create_null_value());
-                                result = ht_val;
-                            }
-                            break;
-                        }
-                    }
-                    break;
+                while (vm.stack_count > frame->stack_base) {
+                    dec_ref(gy, vm_pop(&vm));
                 }
+                dec_ref(gy, frame->callee);
+                dec_ref(gy, frame->receiver);
 
-                case ASTERISK: {
-                    switch (right.type) {
-                        case VAL_STRING:    result = create_number_value(right.as.string->length); break;
-                        case VAL_ARRAY:     result = create_number_value(right.as.array->count); break;
-                        case VAL_HASHTABLE: result = create_number_value(right.as.hashtable->count); break;
-                        case VAL_NUMBER:    result = create_number_value(trunc(right.as.number)); break;
-                        case VAL_BOOL:      result = create_number_value(right.as.boolean ? 1 : 0); break;
-                        case VAL_NULL:      result = create_number_value(0); break;
-                        default:
-                            runtime_error(gy, node->line, "This type does not have a length");
-                            break;
-                    }
+                vm.frame_count--;
+                frame = &vm.frames[vm.frame_count - 1];
+                chunk = frame->chunk;
+                ip = frame->ip;
+                vm_push(&vm, result);
+                DISPATCH();
+            }
+
+            VM_CASE(OP_PRINT): {
+                uint32_t is_last = READ_OPERAND();
+                uint32_t target = READ_OPERAND();
+                GraveyardValue value = vm_pop(&vm);
+                if (gy->had_runtime_error) {
+                    dec_ref(gy, value);
+                    ip = chunk->code + target;
                     break;
                 }
+                print_value(gy, value);
+                dec_ref(gy, value);
+                if (!is_last) {
+                    printf(" ");
+                }
+                DISPATCH();
+            }
 
-                case CARET: {
-                    if (right.type != VAL_HASHTABLE) {
-                        runtime_error(gy, node->line, "The keys-of operator (^) can only be used on a hashtable");
-                    } else {
-                        GraveyardValue keys_array = create_array_value();
-                        GraveyardHashtable* ht = right.as.hashtable;
-                        for (int i = 0; i < ht->capacity; i++) {
-                            if (ht->entries[i].is_in_use) {
-                                array_append(keys_array.as.array, ht->entries[i].key);
-                            }
-                        }
-                        result = keys_array;
-                    }
-                    break;
+            VM_CASE(OP_PRINT_END):
+                if (!gy->had_runtime_error) {
+                    printf("\n");
                 }
+                DISPATCH();
 
-                case BACKTICK: {
-                    if (right.type != VAL_HASHTABLE) {
-                        runtime_error(gy, node->line, "The values-of operator (`) can only be used on a hashtable");
-                    } else {
-                        GraveyardValue values_array = create_array_value();
-                        GraveyardHashtable* ht = right.as.hashtable;
-                        for (int i = 0; i < ht->capacity; i++) {
-                            if (ht->entries[i].is_in_use) {
-                                array_append(values_array.as.array, ht->entries[i].value);
-                            }
-                        }
-                        result = values_array;
+            VM_CASE(OP_FOR_EACH_PREPARE): {
+                GraveyardValue collection = vm.stack[vm.stack_count - 1];
+                if (VALUE_TYPE(collection) != VAL_ARRAY && VALUE_TYPE(collection) != VAL_HASHTABLE && VALUE_TYPE(collection) != VAL_NUMBER) {
+                    runtime_error(gy, CURRENT_LINE(), "Invalid type for single-argument for loop");
+                }
+                vm_push(&vm, create_number_value(0));
+                DISPATCH();
+            }
+
+            VM_CASE(OP_FOR_EACH_NEXT): {
+                AstNode* node = chunk->nodes[READ_OPERAND()];
+                uint32_t target = READ_OPERAND();
+                GraveyardValue collection = vm.stack[vm.stack_count - 2];
+                GraveyardValue* position = &vm.stack[vm.stack_count - 1];
+                GraveyardValue element;
+                bool has_element = false;
+
+                if (VALUE_TYPE(collection) == VAL_ARRAY) {
+                    size_t i = (size_t)AS_NUMBER(*position);
+                    if (i < AS_ARRAY(collection)->count) {
+                        element = AS_ARRAY(collection)->values[i];
+                        *position = NUMBER_VALUE(i + 1);
+                        has_element = true;
+                    }
+                } else if (VALUE_TYPE(collection) == VAL_HASHTABLE) {
+                    GraveyardHashtable* ht = AS_HASHTABLE(collection);
+                    int i = (int)AS_NUMBER(*position);
+                    while (i < ht->capacity && !ht->entries[i].is_in_use) i++;
+                    if (i < ht->capacity) {
+                        element = ht->entries[i].key;
+                        *position = NUMBER_VALUE(i + 1);
+                        has_element = true;
+                    }
+                } else if (VALUE_TYPE(collection) == VAL_NUMBER) {
+                    double i = AS_NUMBER(*position);
+                    if (i < AS_NUMBER(collection)) {
+                        element = create_number_value(i);
+                        *position = NUMBER_VALUE(i + 1);
+                        has_element = true;
                     }
-                    break;
                 }
 
-                default:
-                    runtime_error(gy, node->line, "Unknown unary operator");
+                if (!has_element) {
+                    ip = chunk->code + target;
                     break;
+                }
+                gy->environment = environment_acquire(gy, gy->environment, node->as.for_statement.body->as.block.layout);
+                environment_define(gy, gy->environment, node->as.for_statement.iterator.symbol, element);
+                DISPATCH();
+            }
+
+            VM_CASE(OP_FOR_RANGE_CHECK): {
+                uint32_t position = READ_OPERAND();
+                uint32_t target = READ_OPERAND();
+                if (VALUE_TYPE(vm.stack[vm.stack_count - 1]) == VAL_NUMBER) break;
+                runtime_error(gy, CURRENT_LINE(), position == 3 ? "For loop step argument must be a number" : "For loop range arguments must be numbers");
+                for (uint32_t i = 0; i < position; i++) {
+                    dec_ref(gy, vm_pop(&vm));
+                }
+                ip = chunk->code + target;
+                DISPATCH();
             }
 
-            dec_ref(right);
-            
-            return result;
-        }
+            VM_CASE(OP_FOR_RANGE_PREPARE): {
+                uint32_t target = READ_OPERAND();
+                if (AS_NUMBER(vm.stack[vm.stack_count - 1]) == 0) {
+                    runtime_error(gy, CURRENT_LINE(), "For loop step cannot be zero");
+                    vm.stack_count -= 3;
+                    ip = chunk->code + target;
+                }
+                DISPATCH();
+            }
 
-        case AST_BINARY_OP: {
-            GraveyardTokenType op_type = node->as.binary_op.operator.type;
+            VM_CASE(OP_FOR_RANGE_NEXT): {
+                AstNode* node = chunk->nodes[READ_OPERAND()];
+                uint32_t target = READ_OPERAND();
+                GraveyardValue* current = &vm.stack[vm.stack_count - 3];
+                double i = AS_NUMBER(*current);
+                double stop_val = AS_NUMBER(vm.stack[vm.stack_count - 2]);
+                double step_val = AS_NUMBER(vm.stack[vm.stack_count - 1]);
 
-            if (op_type == DOUBLEQUESTION) {
-                GraveyardValue left = execute_node(gy, node->as.binary_op.left);
-                if (left.type != VAL_NULL) {
-                    return left;
+                if (!((step_val > 0) ? (i < stop_val) : (i > stop_val))) {
+                    ip = chunk->code + target;
+                    break;
                 }
-                return execute_node(gy, node->as.binary_op.right);
+                gy->environment = environment_acquire(gy, gy->environment, node->as.for_statement.body->as.block.layout);
+                environment_define(gy, gy->environment, node->as.for_statement.iterator.symbol, create_number_value(i));
+                *current = NUMBER_VALUE(i + step_val);
+                DISPATCH();
             }
 
-            GraveyardValue left = execute_node(gy, node->as.binary_op.left);
-            GraveyardValue right = execute_node(gy, node->as.binary_op.right);
-            GraveyardValue result = create_null_value();
+            VM_CASE(OP_EVAL_NODE): {
+                AstNode* node = chunk->nodes[READ_OPERAND()];
+                vm_push(&vm, execute_node(gy, node));
+                DISPATCH();
+            }
 
-            if (op_type == REFERENCE) {
-                if (left.type != VAL_HASHTABLE) {
-                    runtime_error(gy, node->line, "The '#' operator can only be used on a hashtable");
-                } else {
-                    GraveyardHashtable* ht = left.as.hashtable;
-                    HashtableEntry* entry = hashtable_find_entry(ht->entries, ht->capacity, right);
-                    if (entry->is_in_use) {
-                        inc_ref(entry->value);
-                        result = entry->value;
-                    }
+            VM_CASE(OP_EVAL_STATEMENT): {
+                AstNode* node = chunk->nodes[READ_OPERAND()];
+                result = execute_node(gy, node);
+                if (!gy->is_returning) {
+                    dec_ref(gy, result);
                 }
-            } else if (op_type == FILEOUT) {
-                if (left.type != VAL_STRING) {
-                    runtime_error(gy, node->line, "Content for file write operation must be a string");
-                } else if (right.type != VAL_STRING) {
-                    runtime_error(gy, node->line, "File path for write operation must be a string");
-                } else {
-                    FILE* file = fopen(right.as.string->chars, "w");
-                    if (!file) {
-                        runtime_error(gy, node->line, "Cannot open or create file '%s' for writing", right.as.string->chars);
-                    } else {
-                        fprintf(file, "%s", left.as.string->chars);
-                        fclose(file);
-                    }
+                DISPATCH();
+            }
+
+            VM_CASE(OP_CHECK_BREAK):
+            VM_CASE(OP_CHECK_CONTINUE): {
+                bool* flag = ip[-1] == OP_CHECK_BREAK ? &gy->encountered_break : &gy->encountered_continue;
+                uint32_t scope_pops = READ_OPERAND();
+                uint32_t target = READ_OPERAND();
+                if (!*flag) break;
+                *flag = false;
+                for (uint32_t i = 0; i < scope_pops; i++) {
+                    vm_pop_scope(gy);
                 }
-            } else if (op_type == EQUALITY) {
-                result = create_bool_value(are_values_equal(left, right));
-            } else if (op_type == INEQUALITY) {
-                result = create_bool_value(!are_values_equal(left, right));
-            } else if (op_type == XOR) {
-                bool left_is_truthy = !is_value_falsy(left);
-                bool right_is_truthy = !is_value_falsy(right);
-                result = create_bool_value(left_is_truthy != right_is_truthy);
-            } else if (op_type == PLUS) {
-                if (left.type == VAL_ARRAY) {
-                    GraveyardValue new_array_val = create_array_value();
-                    for (size_t i = 0; i < left.as.array->count; i++) {
-                        array_append(new_array_val.as.array, left.as.array->values[i]);
-                    }
-                    array_append(new_array_val.as.array, right);
-                    result = new_array_val;
-                } else if (left.type == VAL_NUMBER && right.type == VAL_NUMBER) {
-                    result = create_number_value(left.as.number + right.as.number);
-                } else if (left.type == VAL_STRING || right.type == VAL_STRING) {
-                    char left_str_temp[1024];
-                    char right_str_temp[1024];
-
-                    if (left.type == VAL_STRING) {
-                        strncpy(left_str_temp, left.as.string->chars, sizeof(left_str_temp) - 1);
-                        left_str_temp[sizeof(left_str_temp) - 1] = '\0';
-                    } else {
-                        value_to_string(left, left_str_temp, sizeof(left_str_temp));
-                    }
+                ip = chunk->code + target;
+                DISPATCH();
+            }
 
-                    if (right.type == VAL_STRING) {
-                        strncpy(right_str_temp, right.as.string->chars, sizeof(right_str_temp) - 1);
-                        right_str_temp[sizeof(right_str_temp) - 1] = '\0';
-                    } else {
-                        value_to_string(right, right_str_temp, sizeof(right_str_temp));
-                    }
-                    
-                    size_t total_len = strlen(left_str_temp) + strlen(right_str_temp);
-                    char* result_buffer = malloc(total_len + 1);
+            VM_CASE(OP_CHECK_ERROR):
+                if (gy->had_runtime_error) goto done;
+                DISPATCH();
 
-                    if (!result_buffer) {
-                        runtime_error(gy, node->line, "Memory allocation failed for string concatenation");
-                    } else {
-                        strcpy(result_buffer, left_str_temp);
-                        strcat(result_buffer, right_str_temp);
-                        
-                        result = create_string_value(result_buffer);
-                        free(result_buffer);
-                    }
-                } else {
-                    runtime_error(gy, node->line, "Operands have incompatible types for '+' operation");
-                }
-            } else if (op_type == FORWARDSLASH && (left.type == VAL_STRING || right.type == VAL_STRING)) {
-                char left_str_temp[1024];
-                char right_str_temp[1024];
+            VM_CASE(OP_HALT):
+                goto done;
+        }
+    }
 
-                if (left.type == VAL_STRING) {
-                    strncpy(left_str_temp, left.as.string->chars, sizeof(left_str_temp) - 1);
-                    left_str_temp[sizeof(left_str_temp) - 1] = '\0';
-                } else {
-                    value_to_string(left, left_str_temp, sizeof(left_str_temp));
-                }
+done:
+#undef READ_OPERAND
+#undef CURRENT_LINE
+#undef VM_CASE
+#undef DISPATCH
+    while (vm.stack_count > 0) {
+        dec_ref(gy, vm_pop(&vm));
+    }
+    free(vm.stack);
+    free(vm.frames);
+}
 
-                if (right.type == VAL_STRING) {
-                    strncpy(right_str_temp, right.as.string->chars, sizeof(right_str_temp) - 1);
-                    right_str_temp[sizeof(right_str_temp) - 1] = '\0';
-                } else {
-                    value_to_string(right, right_str_temp, sizeof(right_str_temp));
-                }
+bool vm_execute(Graveyard* gy) {
+    if (!gy || !gy->ast_root) {
+        fprintf(stderr, "Execution error: Nothing to execute (no AST).\n");
+        return false;
+    }
 
-                size_t left_len = strlen(left_str_temp);
-                while (left_len > 0 && (left_str_temp[left_len - 1] == '/' || left_str_temp[left_len - 1] == '\\')) {
-                    left_str_temp[--left_len] = '\0';
-                }
-                
-                size_t right_offset = 0;
-                while (right_str_temp[right_offset] == '/' || right_str_temp[right_offset] == '\\') {
-                    right_offset++;
-                }
-                
-                size_t total_len = strlen(left_str_temp) + strlen(right_str_temp + right_offset) + 1;
-                char* result_buffer = malloc(total_len + 1);
+    Chunk* chunk = compile_program(gy->ast_root);
+    if (!chunk->is_compiled) {
+        chunk_free(gy, chunk);
+        return execute(gy);
+    }
 
-                if (!result_buffer) {
-                    runtime_error(gy, node->line, "Memory allocation failed for path joining");
-                } else {
-                    snprintf(result_buffer, total_len + 1, "%s/%s", left_str_temp, right_str_temp + right_offset);
-                    
-                    result = create_string_value(result_buffer);
-                    free(result_buffer);
-                }
-            } else {
-                if (left.type != VAL_NUMBER || right.type != VAL_NUMBER) {
-                    runtime_error(gy, node->line, "Operands must be numbers for this operation");
-                } else {
-                    switch (op_type) {
-                        case MINUS:          result = create_number_value(left.as.number - right.as.number); break;
-                        case ASTERISK:       result = create_number_value(left.as.number * right.as.number); break;
-                        case EXPONENTIATION: result = create_number_value(pow(left.as.number, right.as.number)); break;
-                        case FORWARDSLASH:
-                            if (right.as.number == 0) { runtime_error(gy, node->line, "Division by zero"); }
-                            else { result = create_number_value(left.as.number / right.as.number); }
-                            break;
-                        case MODULO:
-                            if (right.as.number == 0) { runtime_error(gy, node->line, "Division by zero in modulo operation"); }
-                            else { result = create_number_value(fmod(left.as.number, right.as.number)); }
-                            break;
-                        case RIGHTANGLEBRACKET:      result = create_bool_value(left.as.number > right.as.number); break;
-                        case LEFTANGLEBRACKET: result = create_bool_value(left.as.number < right.as.number); break;
-                        case GREATERTHANEQUAL: result = create_bool_value(left.as.number >= right.as.number); break;
-                        case LESSTHANEQUAL:    result = create_bool_value(left.as.number <= right.as.number); break;
-                        default: break;
-                    }
-                }
-            }
+    bool owns_stack_base = gy->stack_base == 0;
+    if (owns_stack_base) native_stack_init(gy);
 
-            dec_ref(left);
-            dec_ref(right);
+    gy->had_runtime_error = false;
+    vm_run(gy, chunk);
+    chunk_free(gy, chunk);
 
-            return result;
-        }
+    if (owns_stack_base) {
+        stack_segments_release(gy, 0);
+        gy->stack_base = 0;
+    }
 
-        case AST_FORMATTED_STRING: {
-            size_t capacity = 128;
-            size_t length = 0;
-            char* result_string = malloc(capacity);
-            if (!result_string) {
-                perror("Formatted string buffer malloc failed");
-                return create_null_value();
-            }
-            result_string[0] = '\0';
+    return !gy->had_runtime_error;
+}
 
-            for (size_t i = 0; i < node->as.formatted_string.count; i++) {
-                FmtStringPart part = node->as.formatted_string.parts[i];
-                char part_buffer[256]; 
+//JIT------------------------------------------------------------------------
 
-                if (part.type == FMT_PART_LITERAL) {
-                    strncpy(part_buffer, part.as.literal.lexeme, sizeof(part_buffer) - 1);
-                    part_buffer[sizeof(part_buffer) - 1] = '\0';
-                } else {
-                    GraveyardValue value = execute_node(gy, part.as.expression);
-                    value_to_string(value, part_buffer, sizeof(part_buffer));
-                }
-                
-                size_t part_len = strlen(part_buffer);
-                if (length + part_len + 1 > capacity) {
-                    capacity = (length + part_len) * 2;
-                    char* new_result = realloc(result_string, capacity);
-                    if (!new_result) {
-                        perror("Formatted string buffer realloc failed");
-                        free(result_string);
-                        return create_null_value();
-                    }
-                    result_string = new_result;
-                }
-                strcat(result_string, part_buffer);
-                length += part_len;
-            }
+#define JIT_THRESHOLD 16
+#define JIT_MAX_SLOTS 64
+#define JIT_MAX_STACK 64
+#define JIT_MAX_PATCHES 32
 
-            GraveyardValue final_value = create_string_value(result_string);
-            free(result_string);
-            return final_value;
-        }
+typedef enum {
+    JIT_RETURNED,
+    JIT_BAILED,
+    JIT_RETURNED_NULL
+} JitStatus;
+
+typedef int (*JitEntry)(double* slots, double* stack);
+
+struct JitFunction {
+    JitEntry entry;
+    void* code;
+    size_t code_size;
+    Symbol** locals;
+    int local_count;
+};
 
-        case AST_FUNCTION_DECLARATION: {
-            GraveyardValue function = create_function_value(gy, node);
-            environment_define(gy->environment, node->as.function_declaration.name.lexeme, function);
-            return create_null_value();
-        }
+#ifdef GRAVEYARD_JIT
 
-        case AST_BLOCK: {
-            Environment* block_env = environment_new(gy->environment);
-            GraveyardValue result = execute_block(gy, node, block_env);
+typedef enum {
+    HOLE_OPERAND_A,
+    HOLE_OPERAND_B,
+    HOLE_SLOT,
+    HOLE_IMM64,
+    HOLE_TARGET
+} HoleKind;
 
-            monolith_free(&block_env->values);
-            free(block_env);
+typedef struct {
+    uint8_t offset;
+    uint8_t kind;
+} StencilHole;
 
-            return result;
-        }
+typedef struct {
+    const uint8_t* code;
+    uint8_t size;
+    uint8_t hole_count;
+    StencilHole holes[4];
+} Stencil;
+
+static const uint8_t prologue_code[] = {
+    0x53, 0x55, 0x48, 0x83, 0xEC, 0x08, 0x48, 0x89, 0xFB, 0x48, 0x89, 0xF5
+};
+static const uint8_t constant_code[] = {
+    0x48, 0xB8, 0, 0, 0, 0, 0, 0, 0, 0, 0x48, 0x89, 0x85, 0, 0, 0, 0
+};
+static const uint8_t load_slot_code[] = {
+    0x48, 0x8B, 0x83, 0, 0, 0, 0, 0x48, 0x89, 0x85, 0, 0, 0, 0
+};
+static const uint8_t store_slot_code[] = {
+    0x48, 0x8B, 0x85, 0, 0, 0, 0, 0x48, 0x89, 0x83, 0, 0, 0, 0
+};
+static const uint8_t add_code[] = {
+    0xF2, 0x0F, 0x10, 0x85, 0, 0, 0, 0, 0xF2, 0x0F, 0x58, 0x85, 0, 0, 0, 0, 0xF2, 0x0F, 0x11, 0x85, 0, 0, 0, 0
+};
+static const uint8_t subtract_code[] = {
+    0xF2, 0x0F, 0x10, 0x85, 0, 0, 0, 0, 0xF2, 0x0F, 0x5C, 0x85, 0, 0, 0, 0, 0xF2, 0x0F, 0x11, 0x85, 0, 0, 0, 0
+};
+static const uint8_t multiply_code[] = {
+    0xF2, 0x0F, 0x10, 0x85, 0, 0, 0, 0, 0xF2, 0x0F, 0x59, 0x85, 0, 0, 0, 0, 0xF2, 0x0F, 0x11, 0x85, 0, 0, 0, 0
+};
+static const uint8_t divide_code[] = {
+    0xF2, 0x0F, 0x10, 0x85, 0, 0, 0, 0, 0xF2, 0x0F, 0x5E, 0x85, 0, 0, 0, 0, 0xF2, 0x0F, 0x11, 0x85, 0, 0, 0, 0
+};
+static const uint8_t negate_code[] = {
+    0x48, 0x8B, 0x85, 0, 0, 0, 0, 0x48, 0x0F, 0xBA, 0xF8, 0x3F, 0x48, 0x89, 0x85, 0, 0, 0, 0
+};
+static const uint8_t call_helper_code[] = {
+    0xF2, 0x0F, 0x10, 0x85, 0, 0, 0, 0, 0xF2, 0x0F, 0x10, 0x8D, 0, 0, 0, 0,
+    0x48, 0xB8, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xD0, 0xF2, 0x0F, 0x11, 0x85, 0, 0, 0, 0
+};
+static const uint8_t bail_if_zero_code[] = {
+    0x66, 0x0F, 0x57, 0xC9, 0x66, 0x0F, 0x2E, 0x8D, 0, 0, 0, 0, 0x0F, 0x84, 0, 0, 0, 0
+};
+static const uint8_t jump_if_not_above_code[] = {
+    0xF2, 0x0F, 0x10, 0x85, 0, 0, 0, 0, 0x66, 0x0F, 0x2E, 0x85, 0, 0, 0, 0, 0x0F, 0x86, 0, 0, 0, 0
+};
+static const uint8_t jump_if_below_code[] = {
+    0xF2, 0x0F, 0x10, 0x85, 0, 0, 0, 0, 0x66, 0x0F, 0x2E, 0x85, 0, 0, 0, 0, 0x0F, 0x82, 0, 0, 0, 0
+};
+static const uint8_t jump_if_not_equal_code[] = {
+    0xF2, 0x0F, 0x10, 0x85, 0, 0, 0, 0, 0x66, 0x0F, 0x2E, 0x85, 0, 0, 0, 0,
+    0x0F, 0x85, 0, 0, 0, 0, 0x0F, 0x8A, 0, 0, 0, 0
+};
+static const uint8_t jump_if_equal_code[] = {
+    0xF2, 0x0F, 0x10, 0x85, 0, 0, 0, 0, 0x66, 0x0F, 0x2E, 0x85, 0, 0, 0, 0,
+    0x0F, 0x8A, 0x06, 0, 0, 0, 0x0F, 0x84, 0, 0, 0, 0
+};
+static const uint8_t jump_if_zero_code[] = {
+    0xF2, 0x0F, 0x10, 0x85, 0, 0, 0, 0, 0x66, 0x0F, 0x57, 0xC9, 0x66, 0x0F, 0x2E, 0xC1,
+    0x0F, 0x8A, 0x06, 0, 0, 0, 0x0F, 0x84, 0, 0, 0, 0
+};
+static const uint8_t jump_code[] = {
+    0xE9, 0, 0, 0, 0
+};
+static const uint8_t return_number_code[] = {
+    0x48, 0x8B, 0x85, 0, 0, 0, 0, 0x48, 0x89, 0x45, 0x00, 0x31, 0xC0, 0x48, 0x83, 0xC4, 0x08, 0x5D, 0x5B, 0xC3
+};
+static const uint8_t return_null_code[] = {
+    0xB8, JIT_RETURNED_NULL, 0, 0, 0, 0x48, 0x83, 0xC4, 0x08, 0x5D, 0x5B, 0xC3
+};
+static const uint8_t bail_code[] = {
+    0xB8, JIT_BAILED, 0, 0, 0, 0x48, 0x83, 0xC4, 0x08, 0x5D, 0x5B, 0xC3
+};
 
-        case AST_RETURN_STATEMENT: {
-            GraveyardValue value = create_null_value();
-            if (node->as.return_statement.value) {
-                value = execute_node(gy, node->as.return_statement.value);
-            }
-            gy->is_returning = true;
-            
-            dec_ref(gy->return_value);
-            gy->return_value = value;
-            
-            return value;
-        }
+#define STENCIL(code, count, ...) { code, sizeof(code), count, { __VA_ARGS__ } }
+
+static const Stencil stencil_prologue          = STENCIL(prologue_code, 0);
+static const Stencil stencil_constant          = STENCIL(constant_code, 2, { 2, HOLE_IMM64 }, { 13, HOLE_OPERAND_A });
+static const Stencil stencil_load_slot         = STENCIL(load_slot_code, 2, { 3, HOLE_SLOT }, { 10, HOLE_OPERAND_A });
+static const Stencil stencil_store_slot        = STENCIL(store_slot_code, 2, { 3, HOLE_OPERAND_A }, { 10, HOLE_SLOT });
+static const Stencil stencil_add               = STENCIL(add_code, 3, { 4, HOLE_OPERAND_A }, { 12, HOLE_OPERAND_B }, { 20, HOLE_OPERAND_A });
+static const Stencil stencil_subtract          = STENCIL(subtract_code, 3, { 4, HOLE_OPERAND_A }, { 12, HOLE_OPERAND_B }, { 20, HOLE_OPERAND_A });
+static const Stencil stencil_multiply          = STENCIL(multiply_code, 3, { 4, HOLE_OPERAND_A }, { 12, HOLE_OPERAND_B }, { 20, HOLE_OPERAND_A });
+static const Stencil stencil_divide            = STENCIL(divide_code, 3, { 4, HOLE_OPERAND_A }, { 12, HOLE_OPERAND_B }, { 20, HOLE_OPERAND_A });
+static const Stencil stencil_negate            = STENCIL(negate_code, 2, { 3, HOLE_OPERAND_A }, { 15, HOLE_OPERAND_A });
+static const Stencil stencil_call_helper       = STENCIL(call_helper_code, 4, { 4, HOLE_OPERAND_A }, { 12, HOLE_OPERAND_B }, { 18, HOLE_IMM64 }, { 32, HOLE_OPERAND_A });
+static const Stencil stencil_bail_if_zero      = STENCIL(bail_if_zero_code, 2, { 8, HOLE_OPERAND_B }, { 14, HOLE_TARGET });
+static const Stencil stencil_jump_if_not_above = STENCIL(jump_if_not_above_code, 3, { 4, HOLE_OPERAND_A }, { 12, HOLE_OPERAND_B }, { 18, HOLE_TARGET });
+static const Stencil stencil_jump_if_below     = STENCIL(jump_if_below_code, 3, { 4, HOLE_OPERAND_A }, { 12, HOLE_OPERAND_B }, { 18, HOLE_TARGET });
+static const Stencil stencil_jump_if_not_equal = STENCIL(jump_if_not_equal_code, 4, { 4, HOLE_OPERAND_A }, { 12, HOLE_OPERAND_B }, { 18, HOLE_TARGET }, { 24, HOLE_TARGET });
+static const Stencil stencil_jump_if_equal     = STENCIL(jump_if_equal_code, 3, { 4, HOLE_OPERAND_A }, { 12, HOLE_OPERAND_B }, { 24, HOLE_TARGET });
+static const Stencil stencil_jump_if_zero      = STENCIL(jump_if_zero_code, 2, { 4, HOLE_OPERAND_A }, { 24, HOLE_TARGET });
+static const Stencil stencil_jump              = STENCIL(jump_code, 1, { 1, HOLE_TARGET });
+static const Stencil stencil_return_number     = STENCIL(return_number_code, 1, { 3, HOLE_OPERAND_A });
+static const Stencil stencil_return_null       = STENCIL(return_null_code, 0);
+static const Stencil stencil_bail              = STENCIL(bail_code, 0);
+
+#undef STENCIL
 
-        case AST_CALL_EXPRESSION: {
-            GraveyardValue callee = execute_node(gy, node->as.call_expression.callee);
+typedef struct {
+    int position;
+    int patches[JIT_MAX_PATCHES];
+    int patch_count;
+} JitLabel;
+
+typedef struct {
+    int a;
+    int b;
+    int slot;
+    uint64_t imm;
+    JitLabel* target;
+} JitOperands;
 
-            GraveyardFunction* function;
-            Environment* call_environment;
+typedef struct {
+    Symbol* name;
+    int slot;
+    bool is_iterator;
+} JitVariable;
+
+typedef struct {
+    uint8_t* code;
+    size_t count;
+    size_t capacity;
+    JitVariable variables[JIT_MAX_SLOTS];
+    int variable_count;
+    int slot_count;
+    Symbol* locals[JIT_MAX_SLOTS];
+    int local_count;
+    JitLabel bail;
+    JitLabel* break_label;
+    JitLabel* continue_label;
+    bool failed;
+} JitCompiler;
+
+static void jit_label_init(JitLabel* label) {
+    label->position = -1;
+    label->patch_count = 0;
+}
 
-            if (callee.type == VAL_FUNCTION) {
-                function = callee.as.function;
-                call_environment = environment_new(function->closure);
-            } else if (callee.type == VAL_BOUND_METHOD) {
-                GraveyardBoundMethod* bound = callee.as.bound_method;
-                function = bound->function.as.function;
-                
-                call_environment = environment_new(function->closure);
-                environment_define(call_environment, "this", bound->receiver);
-            } else {
-                runtime_error(gy, node->line, "Can only call functions and methods");
-                dec_ref(callee);
-                return create_null_value();
-            }
+static void jit_patch_rel32(JitCompiler* compiler, int hole, int target) {
+    int32_t rel = (int32_t)(target - (hole + 4));
+    memcpy(compiler->code + hole, &rel, sizeof(rel));
+}
 
-            int arg_count = node->as.call_expression.arg_count;
+static void jit_bind(JitCompiler* compiler, JitLabel* label) {
+    label->position = (int)compiler->count;
+    for (int i = 0; i < label->patch_count; i++) {
+        jit_patch_rel32(compiler, label->patches[i], label->position);
+    }
+    label->patch_count = 0;
+}
 
-            if (arg_count != function->arity) {
-                runtime_error(gy, node->line, "Expected %d arguments but got %d", function->arity, arg_count);
-                monolith_free(&call_environment->values);
-                free(call_environment);
-                dec_ref(callee);
-                return create_null_value();
-            }
-            
-            for (int i = 0; i < function->arity; i++) {
-                GraveyardValue arg_value = execute_node(gy, node->as.call_expression.arguments[i]);
-                environment_define(call_environment, function->params[i].lexeme, arg_value);
-                dec_ref(arg_value);
-            }
-            
-            execute_block(gy, function->body, call_environment);
+static void jit_emit(JitCompiler* compiler, const Stencil* stencil, JitOperands operands) {
+    if (compiler->count + stencil->size > compiler->capacity) {
+        size_t new_capacity = compiler->capacity < 256 ? 256 : compiler->capacity * 2;
+        uint8_t* temp = realloc(compiler->code, new_capacity);
+        if (!temp) {
+            perror("jit_emit: realloc failed");
+            exit(1);
+        }
+        compiler->code = temp;
+        compiler->capacity = new_capacity;
+    }
 
-            monolith_free(&call_environment->values);
-            free(call_environment);
+    int start = (int)compiler->count;
+    memcpy(compiler->code + start, stencil->code, stencil->size);
+    compiler->count += stencil->size;
 
-            GraveyardValue result = create_null_value();
-            if (gy->is_returning) {
-                result = gy->return_value;
-                gy->is_returning = false;
-                gy->return_value = create_null_value(); 
-            }
-            
-            dec_ref(callee);
-            return result;
+    for (int i = 0; i < stencil->hole_count; i++) {
+        int hole = start + stencil->holes[i].offset;
+        int32_t disp;
+        switch (stencil->holes[i].kind) {
+            case HOLE_OPERAND_A:
+                disp = operands.a * (int32_t)sizeof(double);
+                memcpy(compiler->code + hole, &disp, sizeof(disp));
+                break;
+            case HOLE_OPERAND_B:
+                disp = operands.b * (int32_t)sizeof(double);
+                memcpy(compiler->code + hole, &disp, sizeof(disp));
+                break;
+            case HOLE_SLOT:
+                disp = operands.slot * (int32_t)sizeof(double);
+                memcpy(compiler->code + hole, &disp, sizeof(disp));
+                break;
+            case HOLE_IMM64:
+                memcpy(compiler->code + hole, &operands.imm, sizeof(operands.imm));
+                break;
+            case HOLE_TARGET:
+                if (operands.target->position >= 0) {
+                    jit_patch_rel32(compiler, hole, operands.target->position);
+                } else if (operands.target->patch_count < JIT_MAX_PATCHES) {
+                    operands.target->patches[operands.target->patch_count++] = hole;
+                } else {
+                    compiler->failed = true;
+                }
+                break;
         }
+    }
+}
 
-        case AST_IF_STATEMENT: {
-            GraveyardValue condition_val = execute_node(gy, node->as.if_statement.condition);
-            bool is_truthy = !is_value_falsy(condition_val);
-            
-            dec_ref(condition_val);
+static JitVariable* jit_lookup(JitCompiler* compiler, Symbol* name) {
+    for (int i = compiler->variable_count - 1; i >= 0; i--) {
+        if (compiler->variables[i].name == name) {
+            return &compiler->variables[i];
+        }
+    }
+    return NULL;
+}
 
-            if (is_truthy) {
-                Environment* block_env = environment_new(gy->environment);
-                execute_block(gy, node->as.if_statement.then_branch, block_env);
-                monolith_free(&block_env->values);
-                free(block_env);
-                
-                return create_null_value();
-            }
+static JitVariable* jit_declare(JitCompiler* compiler, Symbol* name, bool is_iterator) {
+    if (compiler->variable_count >= JIT_MAX_SLOTS || compiler->slot_count >= JIT_MAX_SLOTS) {
+        compiler->failed = true;
+        return NULL;
+    }
+    JitVariable* variable = &compiler->variables[compiler->variable_count++];
+    variable->name = name;
+    variable->slot = compiler->slot_count++;
+    variable->is_iterator = is_iterator;
+    return variable;
+}
 
-            for (size_t i = 0; i < node->as.if_statement.else_if_count; i++) {
-                AstNodeElseIfClause* clause = &node->as.if_statement.else_if_clauses[i];
-                
-                GraveyardValue else_if_condition = execute_node(gy, clause->condition);
-                bool else_if_is_truthy = !is_value_falsy(else_if_condition);
-                
-                dec_ref(else_if_condition);
+static bool jit_constant_number(AstNode* node, double* out) {
+    if (node->type == AST_LITERAL && node->as.literal.value.type == NUMBER) {
+        *out = node->as.literal.number;
+        return true;
+    }
+    if (node->type == AST_UNARY_OP && node->as.unary_op.operator.type == MINUS && jit_constant_number(node->as.unary_op.right, out)) {
+        *out = -*out;
+        return true;
+    }
+    return false;
+}
 
-                if (else_if_is_truthy) {
-                    Environment* block_env = environment_new(gy->environment);
-                    execute_block(gy, clause->body, block_env);
-                    monolith_free(&block_env->values);
-                    free(block_env);
+static uint64_t jit_number_bits(double number) {
+    uint64_t bits;
+    memcpy(&bits, &number, sizeof(bits));
+    return bits;
+}
 
-                    return create_null_value();
-                }
-            }
+static bool jit_expression(JitCompiler* compiler, AstNode* node, int depth);
 
-            if (node->as.if_statement.else_branch != NULL) {
-                Environment* block_env = environment_new(gy->environment);
-                execute_block(gy, node->as.if_statement.else_branch, block_env);
-                monolith_free(&block_env->values);
-                free(block_env);
-            }
+static bool jit_condition(JitCompiler* compiler, AstNode* node, int depth, JitLabel* false_label) {
+    if (node->type == AST_LITERAL && node->as.literal.value.type == TRUEVALUE) {
+        return true;
+    }
+    if (node->type == AST_LITERAL && node->as.literal.value.type == FALSEVALUE) {
+        jit_emit(compiler, &stencil_jump, (JitOperands){ .target = false_label });
+        return true;
+    }
 
-            return create_null_value();
+    if (node->type == AST_BINARY_OP) {
+        const Stencil* stencil = NULL;
+        bool swap = false;
+        switch (node->as.binary_op.operator.type) {
+            case LEFTANGLEBRACKET:  stencil = &stencil_jump_if_not_above; swap = true; break;
+            case RIGHTANGLEBRACKET: stencil = &stencil_jump_if_not_above; break;
+            case LESSTHANEQUAL:     stencil = &stencil_jump_if_below; swap = true; break;
+            case GREATERTHANEQUAL:  stencil = &stencil_jump_if_below; break;
+            case EQUALITY:          stencil = &stencil_jump_if_not_equal; break;
+            case INEQUALITY:        stencil = &stencil_jump_if_equal; break;
+            default:                break;
+        }
+        if (stencil != NULL) {
+            if (!jit_expression(compiler, node->as.binary_op.left, depth)) return false;
+            if (!jit_expression(compiler, node->as.binary_op.right, depth + 1)) return false;
+            JitOperands operands = { .a = swap ? depth + 1 : depth, .b = swap ? depth : depth + 1, .target = false_label };
+            jit_emit(compiler, stencil, operands);
+            return true;
         }
+    }
 
-        case AST_TERNARY_EXPRESSION: {
-            GraveyardValue condition = execute_node(gy, node->as.ternary_expression.condition);
-            bool is_falsy = is_value_falsy(condition);
+    if (!jit_expression(compiler, node, depth)) return false;
+    jit_emit(compiler, &stencil_jump_if_zero, (JitOperands){ .a = depth, .target = false_label });
+    return true;
+}
 
-            dec_ref(condition);
+static bool jit_expression(JitCompiler* compiler, AstNode* node, int depth) {
+    if (depth + 2 > JIT_MAX_STACK) return false;
 
-            if (!is_falsy) {
-                return execute_node(gy, node->as.ternary_expression.then_expr);
-            } else {
-                return execute_node(gy, node->as.ternary_expression.else_expr);
-            }
-        }
+    switch (node->type) {
+        case AST_LITERAL:
+            if (node->as.literal.value.type != NUMBER) return false;
+            jit_emit(compiler, &stencil_constant, (JitOperands){ .a = depth, .imm = jit_number_bits(node->as.literal.number) });
+            return true;
 
-        case AST_ASSERT_STATEMENT: {
-            GraveyardValue condition = execute_node(gy, node->as.assert_statement.condition);
-            if (is_value_falsy(condition)) {
-                runtime_error(gy, node->line, "Assertion failed");
-            }
-            return create_null_value();
+        case AST_IDENTIFIER: {
+            JitVariable* variable = jit_lookup(compiler, node->as.identifier.name.symbol);
+            if (variable == NULL) return false;
+            jit_emit(compiler, &stencil_load_slot, (JitOperands){ .a = depth, .slot = variable->slot });
+            return true;
         }
 
-        case AST_WHILE_STATEMENT: {
-            while (true) {
-                GraveyardValue condition = execute_node(gy, node->as.while_statement.condition);
-                bool is_falsy = is_value_falsy(condition);
-                
-                dec_ref(condition);
+        case AST_UNARY_OP:
+            if (node->as.unary_op.operator.type != MINUS) return false;
+            if (!jit_expression(compiler, node->as.unary_op.right, depth)) return false;
+            jit_emit(compiler, &stencil_negate, (JitOperands){ .a = depth });
+            return true;
 
-                if (is_falsy) {
+        case AST_BINARY_OP: {
+            GraveyardTokenType op_type = node->as.binary_op.operator.type;
+            if (op_type != PLUS && op_type != MINUS && op_type != ASTERISK && op_type != FORWARDSLASH &&
+                op_type != MODULO && op_type != EXPONENTIATION) {
+                return false;
+            }
+            if (!jit_expression(compiler, node->as.binary_op.left, depth)) return false;
+            if (!jit_expression(compiler, node->as.binary_op.right, depth + 1)) return false;
+
+            JitOperands operands = { .a = depth, .b = depth + 1, .target = &compiler->bail };
+            switch (op_type) {
+                case PLUS:     jit_emit(compiler, &stencil_add, operands); break;
+                case MINUS:    jit_emit(compiler, &stencil_subtract, operands); break;
+                case ASTERISK: jit_emit(compiler, &stencil_multiply, operands); break;
+                case FORWARDSLASH:
+                    jit_emit(compiler, &stencil_bail_if_zero, operands);
+                    jit_emit(compiler, &stencil_divide, operands);
                     break;
-                }
-
-                Environment* block_env = environment_new(gy->environment);
-                execute_block(gy, node->as.while_statement.body, block_env);
-                monolith_free(&block_env->values);
-                free(block_env);
-
-                if (gy->is_returning || gy->encountered_break) {
+                case MODULO:
+                    jit_emit(compiler, &stencil_bail_if_zero, operands);
+                    operands.imm = (uint64_t)(uintptr_t)&number_modulo;
+                    jit_emit(compiler, &stencil_call_helper, operands);
+                    break;
+                default:
+                    operands.imm = (uint64_t)(uintptr_t)&pow;
+                    jit_emit(compiler, &stencil_call_helper, operands);
                     break;
-                }
             }
-            gy->encountered_break = false;
-            gy->encountered_continue = false;
-            return create_null_value();
-        }
-
-        case AST_BREAK_STATEMENT: {
-            gy->encountered_break = true;
-            return create_null_value();
+            return true;
         }
 
-        case AST_CONTINUE_STATEMENT: {
-            gy->encountered_continue = true;
-            return create_null_value();
+        case AST_TERNARY_EXPRESSION: {
+            JitLabel else_label, end_label;
+            jit_label_init(&else_label);
+            jit_label_init(&end_label);
+            if (!jit_condition(compiler, node->as.ternary_expression.condition, depth, &else_label)) return false;
+            if (!jit_expression(compiler, node->as.ternary_expression.then_expr, depth)) return false;
+            jit_emit(compiler, &stencil_jump, (JitOperands){ .target = &end_label });
+            jit_bind(compiler, &else_label);
+            if (!jit_expression(compiler, node->as.ternary_expression.else_expr, depth)) return false;
+            jit_bind(compiler, &end_label);
+            return true;
         }
 
-        case AST_FOR_STATEMENT: {
-            const char* iterator_name = node->as.for_statement.iterator.lexeme;
-            size_t range_count = node->as.for_statement.range_count;
-            AstNode** range_exprs = node->as.for_statement.range_expressions;
+        default:
+            return false;
+    }
+}
 
-            if (range_count == 1) {
-                GraveyardValue collection = execute_node(gy, range_exprs[0]);
-                
-                if (collection.type == VAL_ARRAY) {
-                    GraveyardArray* array = collection.as.array;
-                    for (size_t i = 0; i < array->count; i++) {
-                        Environment* loop_env = environment_new(gy->environment);
-                        environment_define(loop_env, iterator_name, array->values[i]);
-                        execute_block(gy, node->as.for_statement.body, loop_env);
-                        
-                        monolith_free(&loop_env->values);
-                        free(loop_env);
+static bool jit_statement(JitCompiler* compiler, AstNode* node, bool top_level);
 
-                        if (gy->is_returning || gy->encountered_break) break;
-                    }
-                } else if (collection.type == VAL_HASHTABLE) {
-                    GraveyardHashtable* ht = collection.as.hashtable;
-                    for (int i = 0; i < ht->capacity; i++) {
-                        if (!ht->entries[i].is_in_use) continue;
-                        Environment* loop_env = environment_new(gy->environment);
-                        environment_define(loop_env, iterator_name, ht->entries[i].key);
-                        execute_block(gy, node->as.for_statement.body, loop_env);
+static bool jit_block(JitCompiler* compiler, AstNode* block) {
+    for (size_t i = 0; i < block->as.block.count; i++) {
+        if (!jit_statement(compiler, block->as.block.statements[i], false)) return false;
+    }
+    return true;
+}
 
-                        monolith_free(&loop_env->values);
-                        free(loop_env);
+static bool jit_loop_body(JitCompiler* compiler, AstNode* body, JitLabel* break_label, JitLabel* continue_label) {
+    JitLabel* enclosing_break = compiler->break_label;
+    JitLabel* enclosing_continue = compiler->continue_label;
+    compiler->break_label = break_label;
+    compiler->continue_label = continue_label;
+    bool ok = jit_block(compiler, body);
+    compiler->break_label = enclosing_break;
+    compiler->continue_label = enclosing_continue;
+    return ok;
+}
 
-                        if (gy->is_returning || gy->encountered_break) break;
-                    }
-                } else if (collection.type == VAL_NUMBER) {
-                    double stop_val = collection.as.number;
-                    for (double i = 0; i < stop_val; i += 1) {
-                        Environment* loop_env = environment_new(gy->environment);
-                        environment_define(loop_env, iterator_name, create_number_value(i));
-                        execute_block(gy, node->as.for_statement.body, loop_env);
+static bool jit_for_statement(JitCompiler* compiler, AstNode* node) {
+    AstNode** range = node->as.for_statement.range_expressions;
+    size_t range_count = node->as.for_statement.range_count;
+    Symbol* iterator_name = node->as.for_statement.iterator.symbol;
+    double step = 1;
 
-                        monolith_free(&loop_env->values);
-                        free(loop_env);
+    if (range_count == 3 && (!jit_constant_number(range[2], &step) || step == 0)) return false;
+    if (jit_lookup(compiler, iterator_name) != NULL) return false;
 
-                        if (gy->is_returning || gy->encountered_break) break;
-                    }
-                } else {
-                    runtime_error(gy, node->line, "Invalid type for single-argument for loop");
-                }
-                
-                dec_ref(collection);
+    if (range_count == 1) {
+        jit_emit(compiler, &stencil_constant, (JitOperands){ .a = 0, .imm = jit_number_bits(0) });
+        if (!jit_expression(compiler, range[0], 1)) return false;
+    } else {
+        if (!jit_expression(compiler, range[0], 0)) return false;
+        if (!jit_expression(compiler, range[1], 1)) return false;
+    }
+
+    int saved_variable_count = compiler->variable_count;
+    JitVariable* iterator = jit_declare(compiler, iterator_name, true);
+    if (iterator == NULL) return false;
+    int iterator_slot = iterator->slot;
+    int stop_slot = compiler->slot_count++;
+    if (stop_slot >= JIT_MAX_SLOTS) return false;
+    jit_emit(compiler, &stencil_store_slot, (JitOperands){ .a = 0, .slot = iterator_slot });
+    jit_emit(compiler, &stencil_store_slot, (JitOperands){ .a = 1, .slot = stop_slot });
+
+    JitLabel top_label, continue_label, end_label;
+    jit_label_init(&top_label);
+    jit_label_init(&continue_label);
+    jit_label_init(&end_label);
+
+    jit_bind(compiler, &top_label);
+    jit_emit(compiler, &stencil_load_slot, (JitOperands){ .a = 0, .slot = iterator_slot });
+    jit_emit(compiler, &stencil_load_slot, (JitOperands){ .a = 1, .slot = stop_slot });
+    if (step > 0) {
+        jit_emit(compiler, &stencil_jump_if_not_above, (JitOperands){ .a = 1, .b = 0, .target = &end_label });
+    } else {
+        jit_emit(compiler, &stencil_jump_if_not_above, (JitOperands){ .a = 0, .b = 1, .target = &end_label });
+    }
 
-            } else {
-                GraveyardValue start_gv = execute_node(gy, range_exprs[0]);
-                if (start_gv.type != VAL_NUMBER) {
-                    runtime_error(gy, range_exprs[0]->line, "For loop range arguments must be numbers");
-                    dec_ref(start_gv);
-                    return create_null_value();
-                }
+    if (!jit_loop_body(compiler, node->as.for_statement.body, &end_label, &continue_label)) return false;
 
-                GraveyardValue stop_gv = execute_node(gy, range_exprs[1]);
-                if (stop_gv.type != VAL_NUMBER) {
-                    runtime_error(gy, range_exprs[1]->line, "For loop range arguments must be numbers");
-                    dec_ref(start_gv);
-                    dec_ref(stop_gv);
-                    return create_null_value();
-                }
+    jit_bind(compiler, &continue_label);
+    jit_emit(compiler, &stencil_load_slot, (JitOperands){ .a = 0, .slot = iterator_slot });
+    jit_emit(compiler, &stencil_constant, (JitOperands){ .a = 1, .imm = jit_number_bits(step) });
+    jit_emit(compiler, &stencil_add, (JitOperands){ .a = 0, .b = 1 });
+    jit_emit(compiler, &stencil_store_slot, (JitOperands){ .a = 0, .slot = iterator_slot });
+    jit_emit(compiler, &stencil_jump, (JitOperands){ .target = &top_label });
+    jit_bind(compiler, &end_label);
 
-                GraveyardValue step_gv = create_number_value(1.0);
-                if (range_count == 3) {
-                    dec_ref(step_gv);
-                    step_gv = execute_node(gy, range_exprs[2]);
-                    if (step_gv.type != VAL_NUMBER) {
-                        runtime_error(gy, range_exprs[2]->line, "For loop step argument must be a number");
-                        dec_ref(start_gv);
-                        dec_ref(stop_gv);
-                        dec_ref(step_gv);
-                        return create_null_value();
-                    }
-                }
+    compiler->variable_count = saved_variable_count;
+    return true;
+}
 
-                double start_val = start_gv.as.number;
-                double stop_val = stop_gv.as.number;
-                double step_val = step_gv.as.number;
-                
-                if (step_val == 0) {
-                    runtime_error(gy, node->line, "For loop step cannot be zero");
-                } else {
-                    for (double i = start_val; (step_val > 0) ? (i < stop_val) : (i > stop_val); i += step_val) {
-                        Environment* loop_env = environment_new(gy->environment);
-                        environment_define(loop_env, iterator_name, create_number_value(i));
-                        execute_block(gy, node->as.for_statement.body, loop_env);
-                        
-                        monolith_free(&loop_env->values);
-                        free(loop_env);
+static bool jit_statement(JitCompiler* compiler, AstNode* node, bool top_level) {
+    switch (node->type) {
+        case AST_EXPRESSION_STATEMENT: {
+            AstNode* assignment = node->as.expression_statement.expression;
+            if (assignment->type != AST_ASSIGNMENT || assignment->as.assignment.left->type != AST_IDENTIFIER) return false;
 
-                        if (gy->is_returning || gy->encountered_break) break;
-                    }
-                }
+            Symbol* name = assignment->as.assignment.left->as.identifier.name.symbol;
+            JitVariable* variable = jit_lookup(compiler, name);
+            if (variable != NULL && variable->is_iterator) return false;
+            if (variable == NULL && !top_level) return false;
 
-                dec_ref(start_gv);
-                dec_ref(stop_gv);
-                dec_ref(step_gv);
+            if (!jit_expression(compiler, assignment->as.assignment.value, 0)) return false;
+            if (variable == NULL) {
+                variable = jit_declare(compiler, name, false);
+                if (variable == NULL) return false;
+                compiler->locals[compiler->local_count++] = name;
             }
-            
-            gy->encountered_break = false;
-            gy->encountered_continue = false;
-            return create_null_value();
-        }
-
-
-        case AST_RAISE_STATEMENT: {
-            GraveyardValue error_val = execute_node(gy, node->as.raise_statement.error_expr);
-            char error_buffer[1024];
-            value_to_string(error_val, error_buffer, sizeof(error_buffer));
-            
-            runtime_error(gy, node->line, "%s", error_buffer);
-            
-            dec_ref(error_val);
-            return create_null_value();
-        }
-
-        case AST_TIME_EXPRESSION: {
-            struct timespec ts;
-            timespec_get(&ts, TIME_UTC);
-            double epoch_time_precise = (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
-            return create_number_value(epoch_time_precise);
+            jit_emit(compiler, &stencil_store_slot, (JitOperands){ .a = 0, .slot = variable->slot });
+            return true;
         }
 
-        case AST_NAMESPACE_DECLARATION: {
-            const char* name = node->as.namespace_declaration.name.lexeme;
-            GraveyardValue ns_val;
-            Environment* ns_env;
-
-            if (monolith_get(&gy->namespaces, name, &ns_val)) {
-                ns_env = ns_val.as.environment;
-            } else {
-                Environment* global_env = get_global_environment(gy);
-                ns_env = environment_new(global_env);
-                
-                GraveyardValue new_ns_val;
-                new_ns_val.type = VAL_ENVIRONMENT;
-                new_ns_val.as.environment = ns_env;
-                monolith_set(&gy->namespaces, name, new_ns_val);
+        case AST_RETURN_STATEMENT:
+            if (node->as.return_statement.value == NULL) {
+                jit_emit(compiler, &stencil_return_null, (JitOperands){ 0 });
+                return true;
             }
+            if (!jit_expression(compiler, node->as.return_statement.value, 0)) return false;
+            jit_emit(compiler, &stencil_return_number, (JitOperands){ .a = 0 });
+            return true;
 
-            execute_block(gy, node->as.namespace_declaration.body, ns_env);
-            return create_null_value();
-        }
+        case AST_IF_STATEMENT: {
+            JitLabel end_label, next_label;
+            jit_label_init(&end_label);
+            jit_label_init(&next_label);
 
-        case AST_NAMESPACE_ACCESS: {
-            const char* ns_name = node->as.namespace_access.namespace_name.lexeme;
-            const char* member_name = node->as.namespace_access.member_name.lexeme;
-            GraveyardValue ns_val;
+            if (!jit_condition(compiler, node->as.if_statement.condition, 0, &next_label)) return false;
+            if (!jit_block(compiler, node->as.if_statement.then_branch)) return false;
+            jit_emit(compiler, &stencil_jump, (JitOperands){ .target = &end_label });
 
-            if (!monolith_get(&gy->namespaces, ns_name, &ns_val)) {
-                runtime_error(gy, node->line, "Namespace '%s' is not defined", ns_name);
-                return create_null_value();
+            for (size_t i = 0; i < node->as.if_statement.else_if_count; i++) {
+                AstNodeElseIfClause* clause = &node->as.if_statement.else_if_clauses[i];
+                jit_bind(compiler, &next_label);
+                jit_label_init(&next_label);
+                if (!jit_condition(compiler, clause->condition, 0, &next_label)) return false;
+                if (!jit_block(compiler, clause->body)) return false;
+                jit_emit(compiler, &stencil_jump, (JitOperands){ .target = &end_label });
             }
 
-            Environment* ns_env = ns_val.as.environment;
-            GraveyardValue member_val;
-
-            if (!environment_get(ns_env, member_name, &member_val)) {
-                runtime_error(gy, node->line, "Member '%s' not found in namespace '%s'", member_name, ns_name);
-                return create_null_value();
-            }
-            
-            inc_ref(member_val);
-            
-            return member_val;
+            jit_bind(compiler, &next_label);
+            if (node->as.if_statement.else_branch != NULL && !jit_block(compiler, node->as.if_statement.else_branch)) return false;
+            jit_bind(compiler, &end_label);
+            return true;
         }
 
-        case AST_FILEREAD_STATEMENT: {
-            GraveyardValue path_val = execute_node(gy, node->as.fileread_statement.path_expr);
-            if (path_val.type != VAL_STRING) {
-                runtime_error(gy, node->line, "File path for read operation must be a string");
-                return create_null_value();
-            }
-            
-            FILE* file = fopen(path_val.as.string->chars, "rb");
-            if (!file) {
-                runtime_error(gy, node->line, "Cannot open file '%s'", path_val.as.string->chars);
-                return create_null_value();
-            }
-
-            char* buffer = load(file, NULL);
-            fclose(file);
-            if (!buffer) {
-                runtime_error(gy, node->line, "Failed to read file '%s'", path_val.as.string->chars);
-                return create_null_value();
-            }
-
-            GraveyardValue file_contents = create_string_value(buffer);
-            free(buffer);
-            
-            const char* var_name = node->as.fileread_statement.variable.lexeme;
-            environment_define(gy->environment, var_name, file_contents);
-            
-            return file_contents;
+        case AST_WHILE_STATEMENT: {
+            JitLabel top_label, end_label;
+            jit_label_init(&top_label);
+            jit_label_init(&end_label);
+
+            jit_bind(compiler, &top_label);
+            if (!jit_condition(compiler, node->as.while_statement.condition, 0, &end_label)) return false;
+            if (!jit_loop_body(compiler, node->as.while_statement.body, &end_label, &top_label)) return false;
+            jit_emit(compiler, &stencil_jump, (JitOperands){ .target = &top_label });
+            jit_bind(compiler, &end_label);
+            return true;
         }
 
-        case AST_TYPE_DECLARATION: {
-            Environment* type_definition_env = gy->environment;
-            char type_name_buffer[MAX_LEXEME_LEN];
-            const char* lexeme = node->as.type_declaration.name.lexeme;
-            size_t len = strlen(lexeme);
-
-            if (len > 2) {
-                size_t type_name_len = len - 2;
-                strncpy(type_name_buffer, lexeme + 1, type_name_len);
-                type_name_buffer[type_name_len] = '\0';
-            } else {    
-                type_name_buffer[0] = '\0'; 
-            }
-            
-            GraveyardValue name_val = create_string_value(type_name_buffer);
-            GraveyardValue type_val = create_type_value(name_val);
+        case AST_FOR_STATEMENT:
+            return jit_for_statement(compiler, node);
 
-            environment_define(gy->environment, type_name_buffer, type_val);
+        case AST_BREAK_STATEMENT:
+        case AST_CONTINUE_STATEMENT: {
+            JitLabel* target = node->type == AST_BREAK_STATEMENT ? compiler->break_label : compiler->continue_label;
+            if (target == NULL) return false;
+            jit_emit(compiler, &stencil_jump, (JitOperands){ .target = target });
+            return true;
+        }
 
-            GraveyardType* type = type_val.as.type;
-            AstNode* body_node = node->as.type_declaration.body;
+        default:
+            return false;
+    }
+}
 
-            for (size_t i = 0; i < body_node->as.block.count; i++) {
-                AstNode* stmt = body_node->as.block.statements[i];
-                
-                if (stmt->type == AST_EXPRESSION_STATEMENT && stmt->as.expression_statement.expression->type == AST_ASSIGNMENT) {
-                    AstNode* assignment = stmt->as.expression_statement.expression;
-                    AstNode* target = assignment->as.assignment.left;
+static void jit_write_perf_map(void* code, size_t size, GraveyardFunction* function) {
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/perf-%d.map", (int)getpid());
+    FILE* map = fopen(path, "a");
+    if (!map) return;
+    const char* name = VALUE_TYPE(function->name) == VAL_STRING ? AS_STRING(function->name)->chars : "anonymous";
+    fprintf(map, "%lx %zx graveyard::%s\n", (unsigned long)(uintptr_t)code, size, name);
+    fclose(map);
+}
 
-                    if (target->type == AST_IDENTIFIER) {
-                        const char* field_name = target->as.identifier.name.lexeme;
-                        
-                        Environment* initializer_env = environment_new(gy->environment);
-                        
-                        inc_ref(type_val);  
-                        monolith_set(&initializer_env->values, "this", type_val);
+static JitFunction* jit_compile(Graveyard* gy, GraveyardFunction* function) {
+    JitFunction* jit = malloc(sizeof(JitFunction));
+    if (!jit) {
+        perror("jit_compile: malloc failed");
+        exit(1);
+    }
+    jit->entry = NULL;
+    jit->code = NULL;
+    jit->code_size = 0;
+    jit->locals = NULL;
+    jit->local_count = 0;
+
+    JitCompiler compiler;
+    compiler.code = NULL;
+    compiler.count = 0;
+    compiler.capacity = 0;
+    compiler.variable_count = 0;
+    compiler.slot_count = 0;
+    compiler.local_count = 0;
+    compiler.break_label = NULL;
+    compiler.continue_label = NULL;
+    compiler.failed = function->arity > JIT_MAX_SLOTS;
+    jit_label_init(&compiler.bail);
+
+    for (int i = 0; i < function->arity && !compiler.failed; i++) {
+        jit_declare(&compiler, function->params[i].symbol, false);
+    }
+
+    jit_emit(&compiler, &stencil_prologue, (JitOperands){ 0 });
+    AstNode* body = function->body;
+    for (size_t i = 0; i < body->as.block.count && !compiler.failed; i++) {
+        if (!jit_statement(&compiler, body->as.block.statements[i], true)) {
+            compiler.failed = true;
+        }
+    }
+    jit_emit(&compiler, &stencil_return_null, (JitOperands){ 0 });
+    jit_bind(&compiler, &compiler.bail);
+    jit_emit(&compiler, &stencil_bail, (JitOperands){ 0 });
+
+    if (compiler.failed) {
+        free(compiler.code);
+        return jit;
+    }
+
+    long page_size = sysconf(_SC_PAGESIZE);
+    size_t code_size = (compiler.count + page_size - 1) / page_size * page_size;
+    void* code = mmap(NULL, code_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (code == MAP_FAILED) {
+        free(compiler.code);
+        return jit;
+    }
+    memcpy(code, compiler.code, compiler.count);
+    free(compiler.code);
+    if (mprotect(code, code_size, PROT_READ | PROT_EXEC) != 0) {
+        munmap(code, code_size);
+        return jit;
+    }
+
+    if (compiler.local_count > 0) {
+        jit->locals = malloc(compiler.local_count * sizeof(Symbol*));
+        if (!jit->locals) {
+            perror("jit_compile: malloc failed");
+            exit(1);
+        }
+        memcpy(jit->locals, compiler.locals, compiler.local_count * sizeof(Symbol*));
+    }
+    jit->local_count = compiler.local_count;
+    jit->code = code;
+    jit->code_size = code_size;
+    jit->entry = (JitEntry)code;
 
-                        Environment* old_env = gy->environment;
-                        gy->environment = initializer_env;
-                        GraveyardValue value = execute_node(gy, assignment->as.assignment.value);
-                        gy->environment = old_env;
+    jit_write_perf_map(code, compiler.count, function);
+    gy->jit_compiled_count++;
+    return jit;
+}
 
-                        monolith_free(&initializer_env->values);
-                        free(initializer_env);
+static bool jit_invoke(Graveyard* gy, GraveyardFunction* function, Environment* environment) {
+    AstNodeBlock* body = &function->body->as.block;
+    if (body->jit == NULL) {
+        if (++body->call_count < JIT_THRESHOLD) return false;
+        body->jit = jit_compile(gy, function);
+    }
 
-                        monolith_set(&type->fields, field_name, value);
-                        dec_ref(value);
-                    }
-                }   
-                else if (stmt->type == AST_FUNCTION_DECLARATION) {
-                    GraveyardValue function = create_function_value(gy, stmt);
-                    function.as.function->closure = type_definition_env;
-                    monolith_set(&type->methods, stmt->as.function_declaration.name.lexeme, function);
-                    dec_ref(function);
-                }
-            }
-            
-            return type_val;
-        }
+    JitFunction* jit = body->jit;
+    if (jit->entry == NULL || environment->layout == NULL) return false;
 
-        case AST_THIS_EXPRESSION: {
-            GraveyardValue this_val;
-            if (!environment_get(gy->environment, "this", &this_val)) {
-                runtime_error(gy, node->line, "Cannot use '.' outside of a type's method");
-                return create_null_value();
-            }
-            inc_ref(this_val);
-            return this_val;
-        }
+    double slots[JIT_MAX_SLOTS];
+    double stack[JIT_MAX_STACK];
+    for (int i = 0; i < function->arity; i++) {
+        GraveyardValue arg = environment->slots[environment->layout->param_slots[i]];
+        if (VALUE_TYPE(arg) != VAL_NUMBER) return false;
+        slots[i] = AS_NUMBER(arg);
+    }
+    for (int i = 0; i < jit->local_count; i++) {
+        GraveyardValue shadowed;
+        if (environment_get(function->closure, jit->locals[i], &shadowed)) return false;
+    }
 
-        case AST_MEMBER_ACCESS: {
-            GraveyardValue object = execute_node(gy, node->as.member_access.object);
-            const char* member_name = node->as.member_access.member.lexeme;
-            GraveyardValue result = create_null_value();
-
-            if (object.type == VAL_INSTANCE) {
-                GraveyardInstance* instance = object.as.instance;
-                GraveyardValue member_val;
-
-                if (monolith_get(&instance->fields, member_name, &member_val)) {
-                    inc_ref(member_val);
-                    result = member_val;
-                } 
-                else if (monolith_get(&instance->type->methods, member_name, &member_val)) {
-                    GraveyardValue bound_method_val;
-                    bound_method_val.type = VAL_BOUND_METHOD;
-                    GraveyardBoundMethod* bound = malloc(sizeof(GraveyardBoundMethod));
-                    
-                    bound->ref_count = 1;
-                    bound->receiver = object;
-                    bound->function = member_val;
-                    
-                    inc_ref(bound->receiver);
-                    inc_ref(bound->function);
-                    
-                    bound_method_val.as.bound_method = bound;
-                    result = bound_method_val;
-                } else {
-                    runtime_error(gy, node->line, "Member '%s' not found on instance", member_name);
-                }
-            } 
-            else if (object.type == VAL_TYPE) {
-                GraveyardType* type = object.as.type;
-                GraveyardValue field_value;
-                if (monolith_get(&type->fields, member_name, &field_value)) {
-                    inc_ref(field_value);
-                    result = field_value;
-                } else {
-                    runtime_error(gy, node->line, "Field '%s' not found or not yet defined in this type", member_name);
-                }
-            } 
-            else {
-                runtime_error(gy, node->line, "Can only access members on an instance or type");
-            }
+    switch (jit->entry(slots, stack)) {
+        case JIT_RETURNED:
+            dec_ref(gy, gy->return_value);
+            gy->return_value = create_number_value(stack[0]);
+            gy->is_returning = true;
+            return true;
+        case JIT_RETURNED_NULL:
+            return true;
+        default:
+            return false;
+    }
+}
 
-            dec_ref(object);
-            
-            return result;
-        }
+static void jit_free(JitFunction* jit) {
+    if (!jit) return;
+    if (jit->code) {
+        munmap(jit->code, jit->code_size);
+    }
+    free(jit->locals);
+    free(jit);
+}
 
-        case AST_EXECUTE_EXPRESSION: {
-            GraveyardValue command_val = execute_node(gy, node->as.execute_expression.command_expr);
-            if (command_val.type != VAL_STRING) {
-                runtime_error(gy, node->line, "Command for execute operation must be a string");
-                return create_null_value();
-            }
+#else
 
-            char full_command[2048];
-            snprintf(full_command, sizeof(full_command), "%s 2>&1", command_val.as.string->chars);
+static bool jit_invoke(Graveyard* gy, GraveyardFunction* function, Environment* environment) {
+    return false;
+}
 
-            #ifdef _WIN32
-                FILE* pipe = _popen(full_command, "r");
-            #else
-                FILE* pipe = popen(full_command, "r");
-            #endif
+static void jit_free(JitFunction* jit) {
+}
 
-            if (!pipe) {
-                runtime_error(gy, node->line, "Failed to execute command");
-                return create_null_value();
-            }
+#endif
 
-            char buffer[128];
-            size_t output_capacity = 256;
-            size_t output_len = 0;
-            char* output_str = malloc(output_capacity);
-            output_str[0] = '\0';
+//EMIT C------------------------------------------------------------------------
 
-            while (fgets(buffer, sizeof(buffer), pipe) != NULL) {
-                size_t buffer_len = strlen(buffer);
-                if (output_len + buffer_len + 1 > output_capacity) {
-                    output_capacity *= 2;
-                    output_str = realloc(output_str, output_capacity);
-                }
-                strcat(output_str, buffer);
-                output_len += buffer_len;
-            }
+typedef struct {
+    AstNode* node;
+    size_t id;
+} EmitEntry;
 
-            int exit_code;
-            #ifdef _WIN32
-                exit_code = _pclose(pipe);
-            #else
-                int status = pclose(pipe);
-                exit_code = WEXITSTATUS(status);
-            #endif
+typedef struct {
+    FILE* out;
+    AstNode** nodes;
+    size_t count;
+    size_t capacity;
+    EmitEntry* index;
+} CEmitter;
 
-            GraveyardValue result_ht = create_hashtable_value();
-            hashtable_set(result_ht.as.hashtable, create_string_value("stdout"), create_string_value(output_str));
-            hashtable_set(result_ht.as.hashtable, create_string_value("stderr"), create_string_value(""));
-            hashtable_set(result_ht.as.hashtable, create_string_value("exit_code"), create_number_value(exit_code));
+typedef struct {
+    const NodeHandler* handlers;
+    size_t count;
+    size_t bound;
+} CompiledBinding;
 
-            free(output_str);
+static void collect_emit_nodes(AstNode** slot, void* context) {
+    AstNode* node = *slot;
+    if (node == NULL) return;
 
-            return result_ht;
+    CEmitter* emitter = context;
+    if (emitter->count >= emitter->capacity) {
+        size_t new_capacity = emitter->capacity < 64 ? 64 : emitter->capacity * 2;
+        AstNode** temp = realloc(emitter->nodes, new_capacity * sizeof(AstNode*));
+        if (!temp) {
+            perror("collect_emit_nodes: realloc failed");
+            exit(1);
         }
+        emitter->nodes = temp;
+        emitter->capacity = new_capacity;
+    }
+    emitter->nodes[emitter->count++] = node;
 
-        case AST_CAT_CONSTANT_EXPRESSION: {
-            return create_number_value(65458655);
-        }
+    ast_visit_children(node, collect_emit_nodes, context);
+}
 
-        case AST_WAIT_STATEMENT: {
-            GraveyardValue duration_val = execute_node(gy, node->as.wait_statement.duration_expr);
-            if (duration_val.type != VAL_NUMBER) {
-                runtime_error(gy, node->line, "Duration for wait operation must be a number");
-                return create_null_value();
-            }
+static int compare_emit_entries(const void* a, const void* b) {
+    uintptr_t left = (uintptr_t)((const EmitEntry*)a)->node;
+    uintptr_t right = (uintptr_t)((const EmitEntry*)b)->node;
+    return (left > right) - (left < right);
+}
 
-            long milliseconds = (long)duration_val.as.number;
-            if (milliseconds < 0) {
-                milliseconds = 0;
-            }
+static size_t emit_id(CEmitter* emitter, AstNode* node) {
+    EmitEntry key = { node, 0 };
+    EmitEntry* entry = bsearch(&key, emitter->index, emitter->count, sizeof(EmitEntry), compare_emit_entries);
+    return entry->id;
+}
 
-            #ifdef _WIN32
-                Sleep(milliseconds);
-            #else
-                usleep(milliseconds * 1000);
-            #endif
+static void emit_c_call(CEmitter* emitter, AstNode* child, const char* access) {
+    fprintf(emitter->out, "compiled_node_%zu(gy, %s)", emit_id(emitter, child), access);
+}
 
-            return create_null_value();
-        }
+static void emit_c_operand(CEmitter* emitter, AstNode* child, const char* access, const char* name, int indent) {
+    if (child->type == AST_IDENTIFIER || child->type == AST_THIS_EXPRESSION) {
+        fprintf(emitter->out, "%*s%s = evaluate_borrowed(gy, %s, &%s_owned);\n", indent, "", name, access, name);
+        return;
+    }
+    fprintf(emitter->out, "%*s%s_owned = true;\n", indent, "", name);
+    fprintf(emitter->out, "%*s%s = ", indent, "", name);
+    emit_c_call(emitter, child, access);
+    fprintf(emitter->out, ";\n");
+}
 
-        case AST_RANDOM_EXPRESSION: {
-            double random_val = (double)rand() / (double)RAND_MAX;
-            return create_number_value(random_val);
-        }
+static void emit_c_branch(CEmitter* emitter, AstNode* block, const char* access) {
+    fprintf(emitter->out, "        Environment* block_env = environment_acquire(gy, gy->environment, %s->as.block.layout);\n", access);
+    fprintf(emitter->out, "        dec_ref(gy, compiled_block_%zu(gy, %s, block_env));\n", emit_id(emitter, block), access);
+    fprintf(emitter->out, "        environment_release(gy, block_env);\n");
+}
 
-        case AST_GLOBAL_ACCESS: {
-            const char* member_name = node->as.global_access.member_name.lexeme;
-            Environment* global_env = get_global_environment(gy);
-            GraveyardValue member_val;
+static void emit_c_block(CEmitter* emitter, AstNode* node, size_t id) {
+    FILE* out = emitter->out;
+    char access[64];
+
+    fprintf(out, "static GraveyardValue compiled_block_%zu(Graveyard* gy, AstNode* block_node, Environment* environment) {\n", id);
+    fprintf(out, "    Environment* previous = gy->environment;\n");
+    fprintf(out, "    gy->environment = environment;\n");
+    fprintf(out, "    GraveyardValue last_val = create_null_value();\n");
+    for (size_t i = 0; i < node->as.block.count; i++) {
+        snprintf(access, sizeof(access), "block_node->as.block.statements[%zu]", i);
+        fprintf(out, "    dec_ref(gy, last_val);\n");
+        fprintf(out, "    last_val = ");
+        emit_c_call(emitter, node->as.block.statements[i], access);
+        fprintf(out, ";\n");
+        fprintf(out, "    gc_safepoint(gy);\n");
+        fprintf(out, "    if (gy->is_returning || gy->encountered_break || gy->encountered_continue) goto done;\n");
+    }
+    if (node->as.block.count > 0) {
+        fprintf(out, "done:\n");
+    }
+    fprintf(out, "    gy->environment = previous;\n");
+    fprintf(out, "    return last_val;\n");
+    fprintf(out, "}\n\n");
+}
 
-            if (!environment_get(global_env, member_name, &member_val)) {
-                runtime_error(gy, node->line, "Global variable '%s' not found", member_name);
-                return create_null_value();
-            }
-            
-            inc_ref(member_val);
-            return member_val;
-        }
+static void emit_c_node(CEmitter* emitter, AstNode* node, size_t id) {
+    FILE* out = emitter->out;
+    char access[96];
 
-        case AST_STATIC_ACCESS: {
-            char type_name_buffer[MAX_LEXEME_LEN];
-            const char* lexeme = node->as.static_access.type_name.lexeme;
-            size_t len = strlen(lexeme);
-
-            if (len > 2) {
-                size_t type_name_len = len - 2;
-                strncpy(type_name_buffer, lexeme + 1, type_name_len);
-                type_name_buffer[type_name_len] = '\0';
-            } else {
-                type_name_buffer[0] = '\0';
-            }
-            
-            const char* member_name = node->as.static_access.member_name.lexeme;
+    fprintf(out, "static GraveyardValue %s_%zu(Graveyard* gy, AstNode* node) {\n", node->releases_scratch ? "compiled_statement" : "compiled_node", id);
 
-            GraveyardValue type_val;
-            if (!environment_get(gy->environment, type_name_buffer, &type_val) || type_val.type != VAL_TYPE) {
-                runtime_error(gy, node->line, "Type <%s> is not defined", type_name_buffer);
-                return create_null_value();
+    switch (node->type) {
+        case AST_PROGRAM:
+            fprintf(out, "    GraveyardValue last_value = create_null_value();\n");
+            for (size_t i = 0; i < node->as.program.count; i++) {
+                snprintf(access, sizeof(access), "node->as.program.statements[%zu]", i);
+                fprintf(out, "    dec_ref(gy, last_value);\n");
+                fprintf(out, "    last_value = ");
+                emit_c_call(emitter, node->as.program.statements[i], access);
+                fprintf(out, ";\n");
+                fprintf(out, "    if (gy->had_runtime_error) return last_value;\n");
             }
-            GraveyardType* type = type_val.as.type;
-            GraveyardValue member_val;
+            fprintf(out, "    return last_value;\n");
+            break;
 
-            if (monolith_get(&type->methods, member_name, &member_val)) {
-                inc_ref(member_val);
-                return member_val;
+        case AST_PRINT_STATEMENT:
+            fprintf(out, "    GraveyardValue value;\n");
+            fprintf(out, "    bool value_owned;\n");
+            for (size_t i = 0; i < node->as.print_stmt.count; i++) {
+                snprintf(access, sizeof(access), "node->as.print_stmt.expressions[%zu]", i);
+                emit_c_operand(emitter, node->as.print_stmt.expressions[i], access, "value", 4);
+                fprintf(out, "    if (gy->had_runtime_error) {\n");
+                fprintf(out, "        release_operand(gy, value, value_owned);\n");
+                fprintf(out, "        return create_null_value();\n");
+                fprintf(out, "    }\n");
+                fprintf(out, "    print_value(gy, value);\n");
+                fprintf(out, "    release_operand(gy, value, value_owned);\n");
+                if (i < node->as.print_stmt.count - 1) {
+                    fprintf(out, "    printf(\" \");\n");
+                }
             }
+            fprintf(out, "    if (!gy->had_runtime_error) {\n");
+            fprintf(out, "        printf(\"\\n\");\n");
+            fprintf(out, "    }\n");
+            fprintf(out, "    return create_null_value();\n");
+            break;
 
-            if (monolith_get(&type->fields, member_name, &member_val)) {
-                inc_ref(member_val);
-                return member_val;
+        case AST_LITERAL:
+            switch (node->as.literal.value.type) {
+                case NUMBER:
+                    if (isfinite(node->as.literal.number)) {
+                        fprintf(out, "    return create_number_value(%a);\n", node->as.literal.number);
+                    } else {
+                        fprintf(out, "    return create_number_value(node->as.literal.number);\n");
+                    }
+                    break;
+                case TRUEVALUE:
+                    fprintf(out, "    return create_bool_value(true);\n");
+                    break;
+                case FALSEVALUE:
+                    fprintf(out, "    return create_bool_value(false);\n");
+                    break;
+                case NULLVALUE:
+                    fprintf(out, "    return create_null_value();\n");
+                    break;
+                default:
+                    fprintf(out, "    return execute_literal(gy, node);\n");
+                    break;
             }
-            
-            runtime_error(gy, node->line, "Static member '%s' not found on type <%s>", member_name, type_name_buffer);
-            return create_null_value();
-        }
+            break;
 
-        case AST_UID_EXPRESSION: {
-            GraveyardValue length_val = execute_node(gy, node->as.uid_expression.length_expr);
-            GraveyardValue result = create_null_value();
+        case AST_EXPRESSION_STATEMENT:
+            fprintf(out, "    return ");
+            emit_c_call(emitter, node->as.expression_statement.expression, "node->as.expression_statement.expression");
+            fprintf(out, ";\n");
+            break;
 
-            if (length_val.type != VAL_NUMBER) {
-                runtime_error(gy, node->line, "Length for UID operation must be a number");
-            } else {
-                int length = (int)length_val.as.number;
-                if (length <= 0) {
-                    runtime_error(gy, node->line, "UID length must be a positive number");
-                } else {
-                    char* uid_str = generate_random_hex_string(length);
-                    if (!uid_str) {
-                        runtime_error(gy, node->line, "Failed to generate random UID");
-                    } else {
-                        result = create_string_value(uid_str);
-                        free(uid_str);
-                    }
-                }
+        case AST_ASSIGNMENT:
+            if (node->as.assignment.left->type != AST_IDENTIFIER) {
+                fprintf(out, "    return execute_assignment(gy, node);\n");
+                break;
             }
+            fprintf(out, "    GraveyardValue value = ");
+            emit_c_call(emitter, node->as.assignment.value, "node->as.assignment.value");
+            fprintf(out, ";\n");
+            fprintf(out, "    AstNode* target = node->as.assignment.left;\n");
+            fprintf(out, "    resolved_assign(gy, &target->as.identifier.resolution, target->as.identifier.name.symbol, value);\n");
+            fprintf(out, "    return value;\n");
+            break;
 
-            dec_ref(length_val);
-            
-            return result;
-        }
+        case AST_LOGICAL_OP:
+            fprintf(out, "    GraveyardValue left;\n");
+            fprintf(out, "    bool left_owned;\n");
+            emit_c_operand(emitter, node->as.logical_op.left, "node->as.logical_op.left", "left", 4);
+            if (node->as.logical_op.operator.type == AND) {
+                fprintf(out, "    if (is_value_falsy(left)) return own_operand(left, left_owned);\n");
+            } else if (node->as.logical_op.operator.type == OR) {
+                fprintf(out, "    if (!is_value_falsy(left)) return own_operand(left, left_owned);\n");
+            }
+            fprintf(out, "    release_operand(gy, left, left_owned);\n");
+            fprintf(out, "    return ");
+            emit_c_call(emitter, node->as.logical_op.right, "node->as.logical_op.right");
+            fprintf(out, ";\n");
+            break;
 
-        case AST_SLICE_EXPRESSION: {
-            GraveyardValue collection = execute_node(gy, node->as.slice_expression.collection);
-            GraveyardValue result = create_null_value();
+        case AST_UNARY_OP:
+            fprintf(out, "    GraveyardValue right;\n");
+            fprintf(out, "    bool right_owned;\n");
+            emit_c_operand(emitter, node->as.unary_op.right, "node->as.unary_op.right", "right", 4);
+            fprintf(out, "    GraveyardValue result = evaluate_unary_op(gy, (GraveyardTokenType)%d, right, node->line);\n", (int)node->as.unary_op.operator.type);
+            fprintf(out, "    release_operand(gy, right, right_owned);\n");
+            fprintf(out, "    return result;\n");
+            break;
 
-            if (collection.type == VAL_ARRAY) {
-                GraveyardArray* arr = collection.as.array;
-                long start, stop, step;
-                
-                if (!calculate_slice_bounds(arr->count, node->as.slice_expression.start_expr,
-                                            node->as.slice_expression.stop_expr, node->as.slice_expression.step_expr,
-                                            &start, &stop, &step, gy)) {
-                    runtime_error(gy, node->line, "Slice step cannot be zero");
-                } else {
-                    GraveyardValue result_array = create_array_value();
-                    if (step > 0 && start < stop) {
-                        for (long i = start; i < stop; i += step) {
-                            if (i < 0 || i >= arr->count) continue;
-                            array_append(result_array.as.array, arr->values[i]);
-                        }
-                    } else if (step < 0 && start > stop) {
-                        for (long i = start; i > stop; i += step) {
-                            if (i < 0 || i >= arr->count) continue;
-                            array_append(result_array.as.array, arr->values[i]);
-                        }
-                    }
-                    result = result_array;
-                }
-            } else if (collection.type == VAL_STRING) {
-                GraveyardString* str = collection.as.string;
-                long start, stop, step;
-
-                if (!calculate_slice_bounds(str->length, node->as.slice_expression.start_expr,
-                                            node->as.slice_expression.stop_expr, node->as.slice_expression.step_expr,
-                                            &start, &stop, &step, gy)) {
-                    runtime_error(gy, node->line, "Slice step cannot be zero");
-                } else {
-                    char* new_chars = malloc(str->length + 1);
-                    if (!new_chars) {
-                        runtime_error(gy, node->line, "Memory allocation failed for string slice");
-                    } else {
-                        size_t new_len = 0;
-                        if (step > 0 && start < stop) {
-                            for (long i = start; i < stop; i += step) {
-                                if (i < 0 || i >= str->length) continue;
-                                new_chars[new_len++] = str->chars[i];
-                            }
-                        } else if (step < 0 && start > stop) {
-                            for (long i = start; i > stop; i += step) {
-                                if (i < 0 || i >= str->length) continue;
-                                new_chars[new_len++] = str->chars[i];
-                            }
-                        }
-                        new_chars[new_len] = '\0';
-                        
-                        result = create_string_value(new_chars);
-                        free(new_chars);
-                    }
-                }
+        case AST_BINARY_OP:
+            if (node->allocates_scratch) {
+                fprintf(out, "    return execute_binary_op(gy, node);\n");
+                break;
+            }
+            if (node->as.binary_op.operator.type == DOUBLEQUESTION) {
+                fprintf(out, "    GraveyardValue left = ");
+                emit_c_call(emitter, node->as.binary_op.left, "node->as.binary_op.left");
+                fprintf(out, ";\n");
+                fprintf(out, "    if (VALUE_TYPE(left) != VAL_NULL) return left;\n");
+                fprintf(out, "    return ");
+                emit_c_call(emitter, node->as.binary_op.right, "node->as.binary_op.right");
+                fprintf(out, ";\n");
+                break;
+            }
+            fprintf(out, "    GraveyardValue left;\n");
+            fprintf(out, "    bool left_owned = true;\n");
+            if (evaluation_is_pure(node->as.binary_op.right)) {
+                emit_c_operand(emitter, node->as.binary_op.left, "node->as.binary_op.left", "left", 4);
             } else {
-                runtime_error(gy, node->line, "Slicing can only be applied to arrays and strings");
+                fprintf(out, "    left = ");
+                emit_c_call(emitter, node->as.binary_op.left, "node->as.binary_op.left");
+                fprintf(out, ";\n");
             }
+            fprintf(out, "    GraveyardValue right;\n");
+            fprintf(out, "    bool right_owned;\n");
+            emit_c_operand(emitter, node->as.binary_op.right, "node->as.binary_op.right", "right", 4);
+            fprintf(out, "    GraveyardValue result = execute_binary_node(gy, node, left, right);\n");
+            fprintf(out, "    release_operand(gy, left, left_owned);\n");
+            fprintf(out, "    release_operand(gy, right, right_owned);\n");
+            fprintf(out, "    return result;\n");
+            break;
 
-            dec_ref(collection);
-            
-            return result;
-        }
-
-        case AST_ARGV_EXPRESSION: {
-            inc_ref(gy->arguments);
-            return gy->arguments;
-        }
+        case AST_BLOCK:
+            fprintf(out, "    Environment* block_env = environment_acquire(gy, gy->environment, node->as.block.layout);\n");
+            fprintf(out, "    GraveyardValue result = compiled_block_%zu(gy, node, block_env);\n", id);
+            fprintf(out, "    environment_release(gy, block_env);\n");
+            fprintf(out, "    return result;\n");
+            break;
 
-        case AST_EVAL_EXPRESSION: {
-            GraveyardValue code_val = execute_node(gy, node->as.eval_expression.code_expr);
-            if (code_val.type != VAL_STRING) {
-                runtime_error(gy, node->line, "Argument for eval operation must be a string");
-                return create_null_value();
+        case AST_IF_STATEMENT:
+            fprintf(out, "    GraveyardValue condition;\n");
+            fprintf(out, "    bool condition_owned;\n");
+            emit_c_operand(emitter, node->as.if_statement.condition, "node->as.if_statement.condition", "condition", 4);
+            fprintf(out, "    bool is_truthy = !is_value_falsy(condition);\n");
+            fprintf(out, "    release_operand(gy, condition, condition_owned);\n");
+            fprintf(out, "    if (is_truthy) {\n");
+            emit_c_branch(emitter, node->as.if_statement.then_branch, "node->as.if_statement.then_branch");
+            fprintf(out, "        return create_null_value();\n");
+            fprintf(out, "    }\n");
+            for (size_t i = 0; i < node->as.if_statement.else_if_count; i++) {
+                AstNodeElseIfClause* clause = &node->as.if_statement.else_if_clauses[i];
+                snprintf(access, sizeof(access), "node->as.if_statement.else_if_clauses[%zu].condition", i);
+                emit_c_operand(emitter, clause->condition, access, "condition", 4);
+                fprintf(out, "    is_truthy = !is_value_falsy(condition);\n");
+                fprintf(out, "    release_operand(gy, condition, condition_owned);\n");
+                fprintf(out, "    if (is_truthy) {\n");
+                snprintf(access, sizeof(access), "node->as.if_statement.else_if_clauses[%zu].body", i);
+                emit_c_branch(emitter, clause->body, access);
+                fprintf(out, "        return create_null_value();\n");
+                fprintf(out, "    }\n");
             }
+            if (node->as.if_statement.else_branch != NULL) {
+                fprintf(out, "    {\n");
+                emit_c_branch(emitter, node->as.if_statement.else_branch, "node->as.if_statement.else_branch");
+                fprintf(out, "    }\n");
+            }
+            fprintf(out, "    return create_null_value();\n");
+            break;
 
-            char* saved_source = gy->source_code;
-            Token* saved_tokens = gy->tokens;
-            size_t       saved_token_count = gy->token_count;
-            AstNode* saved_ast_root = gy->ast_root;
-            Environment* saved_env = gy->environment;
+        case AST_TERNARY_EXPRESSION:
+            fprintf(out, "    GraveyardValue condition;\n");
+            fprintf(out, "    bool condition_owned;\n");
+            emit_c_operand(emitter, node->as.ternary_expression.condition, "node->as.ternary_expression.condition", "condition", 4);
+            fprintf(out, "    bool is_falsy = is_value_falsy(condition);\n");
+            fprintf(out, "    release_operand(gy, condition, condition_owned);\n");
+            fprintf(out, "    if (!is_falsy) return ");
+            emit_c_call(emitter, node->as.ternary_expression.then_expr, "node->as.ternary_expression.then_expr");
+            fprintf(out, ";\n");
+            fprintf(out, "    return ");
+            emit_c_call(emitter, node->as.ternary_expression.else_expr, "node->as.ternary_expression.else_expr");
+            fprintf(out, ";\n");
+            break;
 
-            gy->source_code = strdup(code_val.as.string->chars);
-            gy->tokens = NULL;
-            gy->token_count = 0;
-            gy->ast_root = NULL;
-            
-            gy->environment = environment_new(saved_env);
+        case AST_WHILE_STATEMENT:
+            fprintf(out, "    while (true) {\n");
+            fprintf(out, "        GraveyardValue condition;\n");
+            fprintf(out, "        bool condition_owned;\n");
+            emit_c_operand(emitter, node->as.while_statement.condition, "node->as.while_statement.condition", "condition", 8);
+            fprintf(out, "        bool is_falsy = is_value_falsy(condition);\n");
+            fprintf(out, "        release_operand(gy, condition, condition_owned);\n");
+            fprintf(out, "        if (is_falsy) break;\n");
+            emit_c_branch(emitter, node->as.while_statement.body, "node->as.while_statement.body");
+            fprintf(out, "        gy->encountered_continue = false;\n");
+            fprintf(out, "        if (gy->is_returning || gy->encountered_break) break;\n");
+            fprintf(out, "    }\n");
+            fprintf(out, "    gy->encountered_break = false;\n");
+            fprintf(out, "    gy->encountered_continue = false;\n");
+            fprintf(out, "    return create_null_value();\n");
+            break;
 
-            GraveyardValue result = create_null_value();
-            if (tokenize(gy) && parse(gy) && execute(gy)) {
-                result = gy->last_executed_value;
-            } else {
-                runtime_error(gy, node->line, "Failed to evaluate string");
-            }
+        case AST_BREAK_STATEMENT:
+            fprintf(out, "    gy->encountered_break = true;\n");
+            fprintf(out, "    return create_null_value();\n");
+            break;
 
-            free(gy->source_code);
-            free(gy->tokens);
-            free_ast(gy->ast_root);
-            monolith_free(&gy->environment->values);
-            free(gy->environment);
+        case AST_CONTINUE_STATEMENT:
+            fprintf(out, "    gy->encountered_continue = true;\n");
+            fprintf(out, "    return create_null_value();\n");
+            break;
 
-            gy->source_code = saved_source;
-            gy->tokens = saved_tokens;
-            gy->token_count = saved_token_count;
-            gy->ast_root = saved_ast_root;
-            gy->environment = saved_env;
+        default:
+            fprintf(out, "    return node_handlers[%d](gy, node);\n", (int)node->type);
+            break;
+    }
 
-            return result;
-        }
+    fprintf(out, "}\n\n");
 
-        case AST_EXISTS_EXPRESSION: {
-            GraveyardValue path_val = execute_node(gy, node->as.exists_expression.path_expr);
-            if (path_val.type != VAL_STRING) {
-                runtime_error(gy, node->line, "Path for exists check must be a string");
-                return create_null_value();
-            }
+    if (node->releases_scratch) {
+        fprintf(out, "static GraveyardValue compiled_node_%zu(Graveyard* gy, AstNode* node) {\n", id);
+        fprintf(out, "    ScratchMark mark = scratch_mark(&gy->scratch);\n");
+        fprintf(out, "    GraveyardValue result = compiled_statement_%zu(gy, node);\n", id);
+        fprintf(out, "    scratch_release(&gy->scratch, mark);\n");
+        fprintf(out, "    return result;\n");
+        fprintf(out, "}\n\n");
+    }
+}
 
-            struct stat buffer;
-            bool exists = (stat(path_val.as.string->chars, &buffer) == 0);
-            
-            return create_bool_value(exists);
+static void emit_c_string(FILE* out, const char* text) {
+    fprintf(out, "    \"");
+    for (const char* c = text; *c != '\0'; c++) {
+        switch (*c) {
+            case '"':  fprintf(out, "\\\""); break;
+            case '\\': fprintf(out, "\\\\"); break;
+            case '\n': fprintf(out, "\\n\"\n    \""); break;
+            default:
+                if (isprint((unsigned char)*c)) {
+                    fputc(*c, out);
+                } else {
+                    fprintf(out, "\\%03o", (unsigned char)*c);
+                }
+                break;
         }
+    }
+    fprintf(out, "\"");
+}
 
-        case AST_LISTDIR_EXPRESSION: {
-            GraveyardValue path_val = execute_node(gy, node->as.listdir_expression.path_expr);
-            if (path_val.type != VAL_STRING) {
-                runtime_error(gy, node->line, "Path for list directory must be a string");
-                return create_null_value();
-            }
-            const char* path = path_val.as.string->chars;
+static bool emit_c_source(Graveyard* gy) {
+    if (!parse(gy)) {
+        fprintf(stderr, gy->had_token_error ? "Compilation failed during tokenization.\n" : "Compilation failed during parsing.\n");
+        return false;
+    }
+    optimize(gy);
 
-            GraveyardValue result_array = create_array_value();
+    FILE* file = tmpfile();
+    if (!file) {
+        perror("emit_c_source: tmpfile failed");
+        return false;
+    }
+    write_ast_node(file, gy->ast_root, 0);
+    char* ast_text = load(file, NULL);
+    fclose(file);
+    if (!ast_text) return false;
 
-        #ifdef _WIN32
-            char search_path[1024];
-            snprintf(search_path, sizeof(search_path), "%s\\*", path);
-            WIN32_FIND_DATA find_data;
-            HANDLE find_handle = FindFirstFile(search_path, &find_data);
+    ast_arena_free(gy, &gy->ast_arena);
+    gy->ast_root = NULL;
+    char* buffer = malloc(strlen(ast_text) + 1);
+    if (!buffer) {
+        perror("emit_c_source: malloc failed");
+        exit(1);
+    }
+    strcpy(buffer, ast_text);
+    if (!load_ast_from_buffer(gy, buffer)) {
+        fprintf(stderr, "Compilation failed while reloading the AST.\n");
+        free(ast_text);
+        return false;
+    }
 
-            if (find_handle == INVALID_HANDLE_VALUE) {
-                runtime_error(gy, node->line, "Cannot open directory '%s'", path);
-                return create_null_value();
-            }
+    EscapeAnalysis escapes = { NULL };
+    analyze_escapes(&gy->ast_root, &escapes);
 
-            do {
-                if (strcmp(find_data.cFileName, ".") != 0 && strcmp(find_data.cFileName, "..") != 0) {
-                    array_append(result_array.as.array, create_string_value(find_data.cFileName));
-                }
-            } while (FindNextFile(find_handle, &find_data) != 0);
+    CEmitter emitter = { stdout, NULL, 0, 0, NULL };
+    collect_emit_nodes(&gy->ast_root, &emitter);
+    emitter.index = malloc(emitter.count * sizeof(EmitEntry));
+    if (!emitter.index) {
+        perror("emit_c_source: malloc failed");
+        exit(1);
+    }
+    for (size_t i = 0; i < emitter.count; i++) {
+        emitter.index[i].node = emitter.nodes[i];
+        emitter.index[i].id = i;
+    }
+    qsort(emitter.index, emitter.count, sizeof(EmitEntry), compare_emit_entries);
 
-            FindClose(find_handle);
-        #else
-            DIR* dir = opendir(path);
-            if (!dir) {
-                runtime_error(gy, node->line, "Cannot open directory '%s'", path);
-                return create_null_value();
-            }
+    FILE* out = emitter.out;
+    fprintf(out, "/* Generated by graveyard --emit-c from %s */\n", gy->filename);
+    fprintf(out, "#define GRAVEYARD_NO_MAIN\n");
+    fprintf(out, "#include \"graveyard.c\"\n\n");
 
-            struct dirent* entry;
-            while ((entry = readdir(dir)) != NULL) {
-                if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0) {
-                    array_append(result_array.as.array, create_string_value(entry->d_name));
-                }
-            }
-            closedir(dir);
-        #endif
+    for (size_t i = 0; i < emitter.count; i++) {
+        fprintf(out, "static GraveyardValue compiled_node_%zu(Graveyard* gy, AstNode* node);\n", i);
+        if (emitter.nodes[i]->type == AST_BLOCK) {
+            fprintf(out, "static GraveyardValue compiled_block_%zu(Graveyard* gy, AstNode* block_node, Environment* environment);\n", i);
+        }
+    }
+    fprintf(out, "\n");
 
-            return result_array;
+    for (size_t i = 0; i < emitter.count; i++) {
+        if (emitter.nodes[i]->type == AST_BLOCK) {
+            emit_c_block(&emitter, emitter.nodes[i], i);
         }
+        emit_c_node(&emitter, emitter.nodes[i], i);
+    }
 
-        case AST_TRY_EXCEPT_STATEMENT: {
-            execute_node(gy, node->as.try_except_statement.try_block);
-            
-            bool error_occurred = gy->had_runtime_error;
-            if (error_occurred) {
-                gy->had_runtime_error = false;
+    fprintf(out, "static const NodeHandler compiled_handlers[] = {\n");
+    for (size_t i = 0; i < emitter.count; i++) {
+        fprintf(out, "    compiled_node_%zu,\n", i);
+    }
+    fprintf(out, "};\n\n");
 
-                if (node->as.try_except_statement.except_clause) {
-                    AstNodeExceptClause* clause = node->as.try_except_statement.except_clause;
-                    
-                    GraveyardValue error_obj = create_hashtable_value();
-                    
-                    GraveyardValue key_msg = create_string_value("message");
-                    GraveyardValue val_msg = create_string_value(gy->error_message);
-                    hashtable_set(error_obj.as.hashtable, key_msg, val_msg);
-                    dec_ref(key_msg);
-                    dec_ref(val_msg);
-
-                    GraveyardValue key_line = create_string_value("line");
-                    GraveyardValue val_line = create_number_value(gy->error_line);
-                    hashtable_set(error_obj.as.hashtable, key_line, val_line);
-                    dec_ref(key_line);
-                    dec_ref(val_line);
-
-                    Environment* except_env = environment_new(gy->environment);
-                    environment_define(except_env, clause->error_variable.lexeme, error_obj);
-                    
-                    dec_ref(error_obj);
+    fprintf(out, "static const char compiled_ast[] =\n");
+    emit_c_string(out, ast_text);
+    fprintf(out, ";\n\n");
 
-                    execute_block(gy, clause->body, except_env);
-                    
-                    monolith_free(&except_env->values);
-                    free(except_env);
-                }
-            }
+    fprintf(out, "int main(int argc, char* argv[]) {\n");
+    fprintf(out, "    return graveyard_run_compiled(argc, argv, ");
+    emit_c_string(out, gy->filename);
+    fprintf(out, ", compiled_ast, compiled_handlers, %zu);\n", emitter.count);
+    fprintf(out, "}\n");
 
-            if (node->as.try_except_statement.finally_block) {
-                execute_node(gy, node->as.try_except_statement.finally_block);
-            }
+    free(emitter.nodes);
+    free(emitter.index);
+    free(ast_text);
+    return true;
+}
 
-            return create_null_value();
-        }
+static void bind_compiled_handlers(AstNode** slot, void* context) {
+    AstNode* node = *slot;
+    if (node == NULL) return;
 
-        case AST_VAR_DECLARATION: {
-            const char* name = node->as.var_declaration.name.lexeme;
-            GraveyardValue value = create_null_value();
+    CompiledBinding* binding = context;
+    if (binding->bound < binding->count) {
+        node->handler = binding->handlers[binding->bound];
+    }
+    binding->bound++;
 
-            if (node->as.var_declaration.initializer != NULL) {
-                dec_ref(value);
-                value = execute_node(gy, node->as.var_declaration.initializer);
-            }
-            
-            environment_define(gy->environment, name, value);
-            dec_ref(value);
+    ast_visit_children(node, bind_compiled_handlers, context);
+}
 
-            return create_null_value();
-        }
+int graveyard_run_compiled(int argc, char* argv[], const char* filename, const char* ast_text, const NodeHandler* handlers, size_t handler_count) {
+    Graveyard* gy = graveyard_init("--execute", filename);
+    if (!gy) { return 1; }
+
+    graveyard_set_arguments(gy, argc - 1, argv + 1);
+
+    char* buffer = malloc(strlen(ast_text) + 1);
+    if (!buffer) {
+        perror("graveyard_run_compiled: malloc failed");
+        exit(1);
     }
+    strcpy(buffer, ast_text);
 
-    return create_null_value();
-}
+    bool success = load_ast_from_buffer(gy, buffer);
+    if (!success) {
+        fprintf(stderr, "Failed to load embedded AST.\n");
+    } else {
+        resolve(gy);
+        CompiledBinding binding = { handlers, handler_count, 0 };
+        bind_compiled_handlers(&gy->ast_root, &binding);
+        if (binding.bound != handler_count) {
+            fprintf(stderr, "Embedded AST does not match the compiled handlers.\n");
+            success = false;
+        }
+    }
 
-bool execute(Graveyard *gy) {
-    if (!gy || !gy->ast_root) {
-        fprintf(stderr, "Execution error: Nothing to execute (no AST).\n");
-        return false;
+    if (success && !execute(gy)) {
+        if (gy->had_runtime_error) {
+            fprintf(stderr, "Runtime Error [line %d]: %s\n", gy->error_line, gy->error_message);
+        }
+        success = false;
     }
-    
-    gy->had_runtime_error = false;
-    gy->last_executed_value = execute_node(gy, gy->ast_root);
-    
-    return !gy->had_runtime_error; 
+
+    graveyard_free(gy);
+
+    return success ? 0 : 1;
 }
 
 //MAIN----------------------------------------------------------------------------
 
 static bool compile_source(Graveyard* gy) {
-    if (!tokenize(gy)) {
-        fprintf(stderr, "Compilation failed during tokenization.\n");
-        return false;
-    }
     if (!parse(gy)) {
-        fprintf(stderr, "Compilation failed during parsing.\n");
+        fprintf(stderr, gy->had_token_error ? "Compilation failed during tokenization.\n" : "Compilation failed during parsing.\n");
         return false;
     }
+    optimize(gy);
+    resolve(gy);
 
     printf("Parsing successful. AST created.\n");
     
@@ -6998,58 +12169,62 @@ void print_tokens(Graveyard *gy) {
     printf("---------------------------------------------------------\n");
     for (size_t i = 0; i < gy->token_count; i++) {
         Token token = gy->tokens[i];
-        printf("%-4d | %-4d | %-25s | '%s'\n",
+        printf("%-4d | %-4d | %-25s | '%.*s'\n",
             token.line,
             token.column,
             token_type_to_string(token.type),
-            token.lexeme
+            (int)token.length,
+            gy->source_code + token.start
         );
     }
     printf("---------------------------------------------------------\n");
 }
 
+#ifndef GRAVEYARD_NO_MAIN
 int main(int argc, char *argv[]) {
+    int optimize_level = 1;
+    bool jit_enabled = false;
+    size_t stack_limit = 0;
+    while (argc > 1) {
+        if (strncmp(argv[1], "-O", 2) == 0 && argv[1][2] >= '0' && argv[1][2] <= '2' && argv[1][3] == '\0') {
+            optimize_level = argv[1][2] - '0';
+        } else if (strcmp(argv[1], "--jit") == 0) {
+            jit_enabled = true;
+        } else if (strncmp(argv[1], "--stack=", 8) == 0 && atoi(argv[1] + 8) > 0) {
+            stack_limit = (size_t)atoi(argv[1] + 8) * 1024 * 1024;
+        } else {
+            break;
+        }
+        argv++;
+        argc--;
+    }
+
     if (argc < 3) {
-        fprintf(stderr, "Usage: graveyard <mode> <source file> [args...]\n");
+        fprintf(stderr, "Usage: graveyard [-O0|-O1|-O2] [--jit] [--stack=MB] <mode> <source file> [args...]\n");
         fprintf(stderr, "Modes:\n");
         fprintf(stderr, "  --tokenize, -t          Tokenize source and print tokens\n");
         fprintf(stderr, "  --parse, -p             Parse source and save the AST to a .gyc file\n");
         fprintf(stderr, "  --execute, -e           Parse, save AST, and execute the source code\n");
+        fprintf(stderr, "  --vm, -v                Parse, save AST, and execute the source code on the bytecode VM\n");
         fprintf(stderr, "  --debug, -d             Parse, save AST, execute, and print monolith contents\n");
         fprintf(stderr, "  --executecompiled, -ec  Execute a pre-parsed .gyc file\n");
+        fprintf(stderr, "  --emit-c, -c            Translate source to a C program that links the runtime\n");
+        fprintf(stderr, "Options:\n");
+        fprintf(stderr, "  -O0                     Disable AST optimization\n");
+        fprintf(stderr, "  -O1                     Fold constant operators and casts (default)\n");
+        fprintf(stderr, "  -O2                     Also prune constant branches and short-circuits\n");
+        fprintf(stderr, "  --jit                   Compile hot numeric functions to native code (x86-64 Linux)\n");
+        fprintf(stderr, "  --stack=MB              Limit recursion stack (default: %d x the stack rlimit)\n", CALL_STACK_LIMIT_FACTOR);
         return 1;
     }
 
     Graveyard *gy = graveyard_init(argv[1], argv[2]);
     if (!gy) { return 1; }
+    gy->optimize_level = optimize_level;
+    gy->jit_enabled = jit_enabled;
+    gy->stack_limit = stack_limit;
 
-    gy->arguments = create_hashtable_value();
-    GraveyardValue args_list = create_array_value();
-    GraveyardValue kwargs_ht = create_hashtable_value();
-
-    for (int i = 3; i < argc; i++) {
-        char* arg = argv[i];
-        if (strncmp(arg, "--", 2) == 0) {
-            char* key = arg + 2;
-            char* value_ptr = strchr(key, '=');
-            
-            if (value_ptr != NULL) {
-                *value_ptr = '\0';
-                char* value = value_ptr + 1;
-                hashtable_set(kwargs_ht.as.hashtable, create_string_value(key), create_string_value(value));
-            } else {
-                hashtable_set(kwargs_ht.as.hashtable, create_string_value(key), create_bool_value(true));
-            }
-        } else if (strncmp(arg, "-", 1) == 0) {
-            char* key = arg + 1;
-            hashtable_set(kwargs_ht.as.hashtable, create_string_value(key), create_bool_value(true));
-        } else {
-            array_append(args_list.as.array, create_string_value(arg));
-        }
-    }
-    
-    hashtable_set(gy->arguments.as.hashtable, create_string_value("args"), args_list);
-    hashtable_set(gy->arguments.as.hashtable, create_string_value("kwargs"), kwargs_ht);
+    graveyard_set_arguments(gy, argc - 3, argv + 3);
 
     bool success = true;
 
@@ -7061,6 +12236,7 @@ int main(int argc, char *argv[]) {
         } else {
             printf("--- Loading and Executing Compiled AST from %s ---\n", gy->filename);
             if (load_ast_from_file(gy, gy->filename)) {
+                resolve(gy);
                 print_ast(gy->ast_root);
                 if (!execute(gy)) {
                     if (gy->had_runtime_error) {
@@ -7117,6 +12293,15 @@ int main(int argc, char *argv[]) {
                             }
                             success = false;
                         }
+                    } else if (strcmp(gy->mode, "--vm") == 0 || strcmp(gy->mode, "-v") == 0) {
+                        if (!compile_source(gy) || !vm_execute(gy)) {
+                            if (gy->had_runtime_error) {
+                                fprintf(stderr, "Runtime Error [line %d]: %s\n", gy->error_line, gy->error_message);
+                            }
+                            success = false;
+                        }
+                    } else if (strcmp(gy->mode, "--emit-c") == 0 || strcmp(gy->mode, "-c") == 0) {
+                        if (!emit_c_source(gy)) { success = false; }
                     } else if (strcmp(gy->mode, "--debug") == 0 || strcmp(gy->mode, "-d") == 0) {
                         if (compile_source(gy) && execute(gy)) {
                             graveyard_debug_print(gy);
@@ -7139,3 +12324,4 @@ int main(int argc, char *argv[]) {
     
     return success ? 0 : 1;
 }
+#endif
@@ -0,0 +1,50 @@
+#!/bin/sh
+# Runs every test/*.gy under -O0, -O1, -O2, --jit, --vm and the --emit-c
+# compile-and-run path, and diffs each output against plain -e.
+# Usage: test/run_modes.sh [graveyard binary]   (default: build graveyard.c with $CC)
+
+cd "$(dirname "$0")" || exit 1
+root=$(cd .. && pwd)
+work=$(mktemp -d) || exit 1
+trap 'rm -rf "$work"; rm -f ./*.gyc' EXIT
+
+CC=${CC:-cc}
+if [ -n "$1" ]; then
+    graveyard=$(cd "$(dirname "$1")" && pwd)/$(basename "$1")
+else
+    graveyard=$work/graveyard
+    $CC -O2 -o "$graveyard" "$root/graveyard.c" -lm || exit 1
+fi
+
+strip_banner() {
+    grep -v -e '^Parsing successful' -e '^Writing AST' -e '^Successfully wrote'
+}
+
+failed=0
+for test in *.gy; do
+    name=${test%.gy}
+    "$graveyard" -e "$test" 2>&1 | strip_banner > "$work/$name.expected"
+
+    for mode in "-O0 -e" "-O1 -e" "-O2 -e" "--jit -e" "-v" "--jit -v" "--emit-c"; do
+        if [ "$mode" = "--emit-c" ]; then
+            if "$graveyard" --emit-c "$test" > "$work/$name.c" 2> "$work/$name.err"; then
+                $CC -O2 -w -I"$root" -o "$work/$name" "$work/$name.c" -lm || { echo "FAIL --emit-c $test (C compile)"; failed=1; continue; }
+                "$work/$name" 2>&1 | strip_banner > "$work/$name.actual"
+            else
+                strip_banner < "$work/$name.err" > "$work/$name.actual"
+            fi
+        else
+            "$graveyard" $mode "$test" 2>&1 | strip_banner > "$work/$name.actual"
+        fi
+
+        if diff "$work/$name.expected" "$work/$name.actual" > "$work/$name.diff"; then
+            echo "ok   $mode $test"
+        else
+            echo "FAIL $mode $test"
+            head -20 "$work/$name.diff"
+            failed=1
+        fi
+    done
+done
+
+exit $failed